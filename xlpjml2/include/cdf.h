@@ -75,6 +75,17 @@ typedef struct
   const char *units;/**< variable units or NULL */
   Bool oneyear;     /**< one file for each year (TRUE/FALSE) */
   size_t var_len;
+  int nbuffer;      /**< number of years read at once */
+  int buffer_index; /**< index of first year in read-ahead buffer */
+  int buffer_nyear; /**< number of years in read-ahead buffer */
+  char *buffer;     /**< read-ahead buffer with raw data of file */
+  struct chunkheader *chunk; /**< chunk header for chunked files or NULL */
+  Real *vec;        /**< buffer for conversion to Storereal or NULL */
+#ifdef USE_MPI
+  int *counts;      /**< bytes of each task in one year */
+  int *offsets;     /**< offsets of tasks in one year */
+  char *range;      /**< data of all tasks for one year, root task only */
+#endif
 #if defined(USE_NETCDF) || defined(USE_NETCDF4)
   int ncid;
   int varid;
@@ -131,10 +142,12 @@ extern Bool readintclimate_netcdf(Climatefile *,int *,const Cell *,int,
 extern void closeclimate_netcdf(Climatefile *,Bool);
 
 extern Bool write_float_netcdf(const Netcdf *,const float[],int,int);
+extern Bool write_float_block_netcdf(const Netcdf *,const float[],int,int,int);
 extern Bool write_int_netcdf(const Netcdf *,const int[],int,int);
 extern Bool write_short_netcdf(const Netcdf *,const short[],int,int);
 extern Bool write_pft_float_netcdf(const Netcdf *,const float[],int,int,int);
 extern Bool write_pft_short_netcdf(const Netcdf *,const short[],int,int,int);
+extern Bool write_pft_block_netcdf(const Netcdf *,const void *,Type,int,int,int);
 extern void freecoordarray(Coord_array *);
 extern Bool openfile_netcdf(Climatefile *,const char *,
                      const char *,const char *,const Config *);
@@ -172,10 +185,9 @@ extern int open_netcdf(const char *,int *,Bool *);
 extern void free_netcdf(int);
 
 #ifdef USE_MPI
-extern Bool mpi_write_netcdf(const Netcdf *,void *,MPI_Datatype,int,int,
-                             int [],int [],int,MPI_Comm);
-extern Bool mpi_write_pft_netcdf(const Netcdf *,void *,MPI_Datatype,int,
-                                 int,int,int [],int [],int,MPI_Comm);
+extern Bool mpi_write_netcdf(const Netcdf *,void *,MPI_Datatype,int,Gatherplan *);
+extern Bool mpi_write_pft_netcdf(const Netcdf *,void *,MPI_Datatype,int,int,
+                                 Gatherplan *);
 #endif
 
 /* Definition of macros */
@@ -63,14 +63,23 @@ typedef struct
   Real soil_storage;        /**< total water in soil storages (dm3) */
   Real total_reservoir_out; /**< total water extracted from reservoirs (dm3) */
   Real total_irrig_from_reservoir; /**< total water added to fields from reservoirs (dm3)*/
+  Real infil_diff;          /**< difference in runoff of infiltration solvers (mm) */
 } Balance;
 
 typedef struct celldata *Celldata;
 
+/* Phases of one simulation year timed by iterateyear() */
+
+typedef enum {LANDUSE_PHASE,DAILY_PHASE,ROUTING_PHASE,MONTHLY_PHASE,
+              ANNUAL_PHASE,OUTPUT_PHASE,NPHASE} Phase;
+
+typedef void (*Cellfcn)(Cell *,int,void *); /* function called by runcells() */
+
 struct cell
 {
   Coord coord;              /**< Cell coordinate and area */
   Standlist standlist;      /**< Stand list */
+  Standindex standindex;    /**< index of stands by land-use type */
   Climbuf climbuf;
   Ignition ignition;
   Real afire_frac;          /**< fraction of grid cell burnt this year */
@@ -111,13 +120,23 @@ extern int fwritecell(FILE *,long long [],const Cell [],int,int,int,int,Bool);
 extern void fprintcell(FILE *,const Cell [],int,int,int,const Config *);
 extern Bool freadcell(FILE *,Cell *,int,int,const Soilpar *,
                       const Standtype [],int,Bool,const Config *);
+extern int ordercells(int [],const Cell [],const Config *);
+extern Bool freadcells(FILE *,const long long [],Cell [],const unsigned int [],
+                       int,int,const Standtype [],int,Bool,const char *,
+                       const Config *);
 extern int writecoords(Outputfile *,int,const Cell [],const Config *);
 extern int writecountrycode(Outputfile *,int,const Cell [],const Config *);
 extern int writeregioncode(Outputfile *,int,const Cell [],const Config *);
 extern int iterate(Outputfile *,Cell [],Input,
                    int,int,const Config *);
 extern void iterateyear(Outputfile *,Cell [],Input,
-                        Real,int,int,int,const Config *);
+                        Real,int,int,int,double [],const Config *);
+extern void printphases(const double [],const Config *);
+extern void runcells(Cellfcn,Cell [],const int [],int,void *,const Config *);
+extern int iterate_ensemble(Outputfile *[],Cell *[],Input,const Param [],
+                            int,int,const Config [],int);
+extern void copylanduse(Cell [],const Cell [],int,const Config *);
+extern void copywateruse(Cell [],const Cell [],const Config *);
 extern void fwriteoutput_annual(Outputfile *,const Cell [],int,const Config *);
 extern void fwriteoutput_monthly(Outputfile *,const Cell [],int,int,const Config *);
 extern void fwriteoutput_daily(Outputfile *,const Cell [],int,int,const Config *);
@@ -139,11 +158,15 @@ extern Bool initsoiltemp(Climate *, Cell*,const Config *);
 extern Celldata opencelldata(Config *);
 extern Bool seekcelldata(Celldata,int);
 extern Bool readcelldata(Celldata,Coord *,unsigned int *,Intcoord *,int,Config *);
+extern Bool readallcelldata(Celldata,Cell [],unsigned int [],Config *);
 extern void closecelldata(Celldata);
 extern Real albedo(Cell *, Real , Real );
 
 /* Definition of macros */
 
+/* loop over all cells with valid soilcode in file order, n counts the cells */
+#define foreachactivecell(n,cell,config) for(n=0;n<(config)->count && ((cell=(config)->activecell[n]),TRUE);n++)
+
 #define printcell(cell,n,npft,ncft,config) fprintcell(stdout,cell,n,npft,ncft,config)
 
 #endif
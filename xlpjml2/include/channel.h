@@ -20,8 +20,18 @@
 #endif
 #ifdef _WIN32
 #include <winsock.h> /* required for definition of SOCKET */
+#else
+#include <pthread.h>
 #endif
 
+/* Definition of constants for framed protocol version 2 */
+
+#define SOCKET_MAGIC2 "LP2"     /* header of protocol version 2 */
+#define FRAME_MAGIC 0x464a504c  /* magic number of each frame */
+#define FRAME_RLE 1             /* payload is run-length compressed */
+#define FRAME_END 2             /* last frame, connection is closed */
+#define DEFAULT_NFRAME 4        /* default number of frames in send queue */
+
 /* Definition of datatype */
 
 typedef struct
@@ -34,6 +44,52 @@ typedef struct
   Bool swap;      /* Byte order has to be changed */
 } Socket; 
 
+typedef struct
+{
+  int magic; /**< FRAME_MAGIC */
+  int year;  /**< year of frame */
+  int step;  /**< day, month or negative value for other frames */
+  int nrec;  /**< number of records in frame */
+  int flags; /**< FRAME_RLE and FRAME_END flags */
+  int size;  /**< uncompressed size of payload (bytes) */
+  int len;   /**< size of payload sent (bytes) */
+} Frameheader;
+
+typedef struct
+{
+  int index; /**< variable index */
+  int layer; /**< layer of variable */
+  int type;  /**< datatype of variable (LPJ_SHORT, LPJ_FLOAT, ...) */
+  int n;     /**< number of items, data is padded to multiple of 4 bytes */
+} Recordheader;
+
+typedef struct
+{
+  char *data; /**< frame header and payload */
+  int len;    /**< length of frame (bytes) */
+} Frame;
+
+typedef struct
+{
+  Socket *socket;  /**< socket connection */
+  Bool compress;   /**< run-length compression of payload (TRUE/FALSE) */
+  Bool err;        /**< error occurred in sending data (TRUE/FALSE) */
+  char *payload;   /**< payload of frame under construction */
+  int size;        /**< size of payload (bytes) */
+  int capacity;    /**< allocated size of payload (bytes) */
+  int nrec;        /**< number of records in frame */
+  Frame *queue;    /**< ring buffer of frames to be sent */
+  int nframe;      /**< size of ring buffer */
+  int first;       /**< index of first frame in ring buffer */
+  int n;           /**< number of frames in ring buffer */
+#ifndef _WIN32
+  Bool done;       /**< no more frames will be added (TRUE/FALSE) */
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t notempty,notfull;
+#endif
+} Sendbuffer;
+
 /* Declarations of functions */
 
 extern Socket *open_socket(int,int);
@@ -50,12 +106,20 @@ extern Bool readshort_socket(Socket *,short *,int);
 extern Bool writestring_socket(Socket *,const char *);
 extern char *readstring_socket(Socket *);
 extern void close_socket(Socket *);
+extern void shutdown_socket(Socket *);
 extern char *getclientname(const Socket *);
+extern Sendbuffer *open_sendbuffer(Socket *,int,Bool);
+extern void *reserve_sendbuffer(Sendbuffer *,int,int,Type,int);
+extern void add_sendbuffer(Sendbuffer *,int,int,Type,const void *,int);
+extern Bool flush_sendbuffer(Sendbuffer *,int,int);
+extern Bool close_sendbuffer(Sendbuffer *);
 #ifdef USE_MPI
 extern Bool mpi_write_socket(Socket *,void *,MPI_Datatype,int,int [],
                             int [],int,MPI_Comm);
 extern Bool mpi_read_socket(Socket *,void *,MPI_Datatype,int,int [],
                            int [],int,MPI_Comm);
+extern void mpi_add_sendbuffer(Sendbuffer *,int,int,Type,void *,MPI_Datatype,
+                               int,int [],int [],int,MPI_Comm);
 #endif
 
 /* Definition of macros */
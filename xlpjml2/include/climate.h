@@ -24,17 +24,17 @@
 
 typedef struct
 {
-  Real *temp; /**< temperature data (deg C) */
-  Real *prec; /**< precipitation data (mm) */
-  Real *sun;  /**< sunshine data (%) */
-  Real *wet;  /**< number of wet days in a month */
-  Real *wind; /**< wind speed (m/min) */
-  Real *tamp; /**< temperature amplitude */
-  Real *tmax; /**< maximum temperature (deg C) */
-  Real *lightning;
-  Real *lwnet;   /**< long wave net downward flux (W m-2) */
-  Real *swdown;  /**< short wave downward flux component (W m-2) */
-  Real *burntarea;	/**< burnt area (ha) */
+  Storereal *temp; /**< temperature data (deg C) */
+  Storereal *prec; /**< precipitation data (mm) */
+  Storereal *sun;  /**< sunshine data (%) */
+  Storereal *wet;  /**< number of wet days in a month */
+  Storereal *wind; /**< wind speed (m/min) */
+  Storereal *tamp; /**< temperature amplitude */
+  Storereal *tmax; /**< maximum temperature (deg C) */
+  Storereal *lightning;
+  Storereal *lwnet;   /**< long wave net downward flux (W m-2) */
+  Storereal *swdown;  /**< short wave downward flux component (W m-2) */
+  Storereal *burntarea;	/**< burnt area (ha) */
 } Climatedata;
 
 typedef struct Dailyclimate
@@ -100,19 +100,22 @@ extern Bool storeclimate(Climatedata *,Climate *,const Cell *,int,int,
 extern void freeclimatedata(Climatedata *);
 extern void restoreclimate(Climate *,const Climatedata *,int);
 extern void moveclimate(Climate *,const Climatedata *,int);
-extern void prdaily(Real [],int,Real,Real);
+extern long long storeclimatesize(const Climate *,int);
+extern void prdaily(Real [],int,Real,Real,Randstream *);
 extern void dailyclimate(Dailyclimate *,const Climate *,Climbuf *,
                          int,int,int,int);
 extern Real getmtemp(const Climate *,const Climbuf *,int,int);
 extern Real getmprec(const Climate *,const Climbuf *,int,int);
-extern void initclimate_monthly(const Climate *,Climbuf *,int,int);
+extern void initclimate_monthly(const Climate *,Climbuf *,int,int,Randstream *);
 extern Bool openclimate(Climatefile *,const Filename *,const char *,Type,
                         const Config *);
 extern Real avgtemp(const Climate *,int cell);
 extern Real avgprec(const Climate *,int cell);
 extern void closeclimatefile(Climatefile *,Bool);
-extern Bool readclimate(Climatefile *,Real *,Real,Real,const Cell *,int,
+extern Bool readclimate(Climatefile *,Storereal *,Real,Real,const Cell *,int,
                         const Config *);
+extern Bool readclimatebuffer(Climatefile *,Storereal *,Real,Real,int,
+                              const Config *);
 extern Bool checkvalidclimate(Climate *,Cell *,Config *);
 extern Bool readco2(Co2data *,const Filename *,Bool);
 extern void radiation(Real *, Real *,Real *,Real,int,Dailyclimate *,Real,int);
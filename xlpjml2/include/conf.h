@@ -82,6 +82,24 @@
 #define POPULATION 1
 #define NO_FIREWOOD 0
 #define FIREWOOD 1
+#define INFIL_SLUG 0     /* infiltration in slugs of 4 mm */
+#define INFIL_ADAPTIVE 1 /* infiltration with slug size control by step doubling */
+#define INFIL_VERIFY 2   /* run both infiltration solvers and compare */
+
+#define DAILY_NOBUFFER 0 /* daily output written each day */
+#define DAILY_MONTH 1    /* daily output buffered and written each month */
+#define DAILY_YEAR 2     /* daily output buffered and written each year */
+
+#define NO_CELLSEL 0      /* all cells in startgrid..endgrid simulated */
+#define CELLSEL_LIST 1    /* cells selected by list of global cell indices */
+#define CELLSEL_COUNTRY 2 /* cells selected by list of country codes */
+#define CELLSEL_BOX 3     /* cells selected by longitude/latitude box */
+
+#define NO_AGGREGATE 0      /* gridded output */
+#define AGGREGATE_COUNTRY 1 /* output aggregated by country code */
+#define AGGREGATE_REGION 2  /* output aggregated by region code */
+#define AGGREGATE_BASIN 3   /* output aggregated by basin id */
+#define NAGGREGATE 4        /* number of aggregation types */
 #define RANDOM_PREC 1
 #define INTERPOLATE_PREC 0
 #define NOUT 215            /* number of output files */
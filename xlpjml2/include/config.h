@@ -23,6 +23,7 @@ typedef struct
   Filename filename; /**< Filename of output file */
   int id;
   Bool oneyear;
+  int aggregate;     /**< aggregation (NO_AGGREGATE, AGGREGATE_COUNTRY, AGGREGATE_REGION, AGGREGATE_BASIN) */
 } Outputvar;
 
 typedef struct
@@ -73,6 +74,7 @@ typedef struct
   Filename landcover_filename;
   Filename runoff2ocean_filename; /**< map with indices of the ocean cells where the coast cells send their runoff into */
   Filename grassfix_filename;
+  Filename basin_filename; /**< basin ids for aggregated output, name is NULL if not set */
 #ifdef IMAGE
   Filename temp_var_filename; /**< file with CRU-derived temperature variation (K) */
   Filename prec_var_filename; /**< file with CRU-derived precipitation variation (%) */
@@ -108,6 +110,21 @@ typedef struct
   Bool residues_fire;   /**< use parameters for agricultural fires */
   Bool param_out;               /**< print LPJmL parameter */
   Bool check_climate; /**< check climate input data for NetCDF files */
+  int climate_buffer; /**< number of years of climate data read at once */
+  int infil_solver;   /**< infiltration solver (INFIL_SLUG, INFIL_ADAPTIVE, INFIL_VERIFY) */
+  Bool async_restart; /**< write restart file in the background (TRUE/FALSE) */
+  int socket_version; /**< version of socket output protocol (1 or 2) */
+  Bool socket_rle;    /**< compress frames of socket protocol version 2 (TRUE/FALSE) */
+  int daily_buffer;   /**< buffering of daily output (DAILY_NOBUFFER, DAILY_MONTH, DAILY_YEAR) */
+  int cellsel;        /**< cell selection (NO_CELLSEL, CELLSEL_LIST, CELLSEL_COUNTRY, CELLSEL_BOX) */
+  int *cellsel_list;  /**< sorted cell indices or country codes of selection */
+  int cellsel_n;      /**< number of items in cellsel_list */
+  Real cellsel_box[4]; /**< selected box (lonmin,latmin,lonmax,latmax) */
+  int *cellsel_cells; /**< sorted indices of cells selected by country or box */
+  int cellsel_ncell;  /**< number of items in cellsel_cells */
+  int nthreads;       /**< number of threads for grid initialization and annual phases */
+  Bool dryrun;        /**< initialize grid and input, report memory and exit (TRUE/FALSE) */
+  char *memdump_filename; /**< filename of memory report dump or NULL */
   Verbosity scan_verbose;       /**< option -vv 2: verbosely print the read values during fscanconfig. default 1; 0 would supress even error messages */
   int compress;           /**< compress NetCDF output (0: no compression) */
   float missing_value;    /**< Missing value in NetCDF files */
@@ -141,6 +158,8 @@ typedef struct
   int rank;      /**< my rank */
   int ntask;     /**< number of parallel tasks */
   int count;     /**< number of grid cells with valid soilcode */
+  int *activecell; /**< indices of grid cells with valid soilcode in file order */
+  int *cellorder;  /**< indices of grid cells with valid soilcode ordered by costs */
   int fire;      /**< fire disturbance enabled */
   int firewood;  /**< fire wood usage */
   int seed;      /**< initial seed for random number generator */
@@ -187,6 +206,10 @@ extern void freeconfig(Config *);
 extern void fprintconfig(FILE *,const Config *,int,int);
 extern Bool filesexist(Config,Bool);
 extern long long outputfilesize(const Config *);
+extern long long outputbuffersize(const Config *);
+extern Bool readcellsel(Config *,const char *,int);
+extern Bool iscellselected(const Config *,int,const Coord *,int);
+extern Bool getcellselrange(int *,int *,Config *);
 extern Variable *fscanoutputvar(LPJfile *,int,Verbosity);
 extern void freeoutputvar(Variable *,int);
 extern Bool fscanoutput(LPJfile *,Config *,int);
@@ -198,6 +221,8 @@ extern void fprintfiles(FILE *,Bool,const Config *);
 extern Bool getextension(Extension *,const Config *);
 extern void fprintincludes(FILE *,const char *,int,char **);
 extern size_t getsize(int,const Config *);
+extern Bool checkensemble(const Config [],int);
+extern Bool setensemblemember(Config *,int);
 
 /* Definition of macros */
 
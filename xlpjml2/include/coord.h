@@ -40,6 +40,7 @@ extern Coordfile opencoord(const Filename *,Bool);
 extern Bool readintcoord(FILE *,Intcoord *,Bool);
 extern int seekcoord(Coordfile,int);
 extern Bool readcoord(Coordfile,Coord *,const Coord *);
+extern Bool readcoords(Coordfile,Coord [],int,const Coord *);
 extern void closecoord(Coordfile);
 extern Bool writecoord(FILE *,const Coord *);
 extern Bool writefloatcoord(FILE *,const Coord *);
@@ -31,6 +31,9 @@ extern Real dayseconds1; /* 1/(number of seconds per day) */
 /* Declaration of functions */
 
 extern Real interpolate(const MReal,int,int);
+#ifdef USE_MIXED_PRECISION
+extern Real interpolatestore(const Storereal [],int,int);
+#endif
 extern void cvrtdaymonth(int *,int *,int);
 extern Bool isleapyear(int);
 extern char *int2date(long);
@@ -38,6 +41,10 @@ extern int nleapyears(int,int);
 
 /* Definition of macros */
 
+#ifndef USE_MIXED_PRECISION
+#define interpolatestore(mval,month,dm) interpolate(mval,month,dm)
+#endif
+
 #define foreachmonth(month) for(month=0;month<NMONTH;month++)
 #define foreachdayofmonth(day,month) for(day=0;day<ndaymonth[month];day++)
 
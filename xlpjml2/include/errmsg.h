@@ -52,6 +52,8 @@
 #define NO_FMS_ERR 32
 #define INITSOILTEMP_ERR 33
 #define INVALID_RADIATION_ERR 34
+#define INVALID_FIRE_ERR 35
+#define WRITE_RESTART_ERR 36
 
 /* Definition of macros */
 
@@ -60,6 +60,11 @@
 #define CELLINDEX 3
 #define CELLSEQ 4
 #define READ_VERSION -1
+#define LPJ_CHUNK_VERSION 4 /* version of chunked, compressed CLM files */
+#define CHUNK_NOCOMPRESS 0  /* chunks are not compressed */
+#define CHUNK_DEFLATE 1     /* chunks are compressed by zlib */
+#define CHUNK_NOFILTER 0    /* no filter applied before compression */
+#define CHUNK_SHUFFLE 1     /* byte shuffle, integers are delta encoded along bands */
 
 /* Definition of datatypes */
 
@@ -99,6 +104,19 @@ typedef struct
   int nbands;      /**< number of data elements per cell */
 } Header_old;
 
+typedef struct chunkheader
+{
+  Header header;    /**< file header */
+  int nyear;        /**< number of years in chunk */
+  int ncell;        /**< number of cells in chunk */
+  int compress;     /**< compression (CHUNK_NOCOMPRESS, CHUNK_DEFLATE) */
+  int filter;       /**< filter (CHUNK_NOFILTER, CHUNK_SHUFFLE) */
+  int nchunk_year;  /**< number of year blocks */
+  int nchunk_cell;  /**< number of cell blocks */
+  long long *index; /**< file offsets of chunks, last element is end of data */
+  const char *filename; /**< name of file used in error messages */
+} Chunkheader;
+
 typedef struct
 {
   Bool landuse;       /**< land use enabled (TRUE/FALSE) */
@@ -115,6 +133,14 @@ extern Bool freadanyheader(FILE *,Header *,Bool *,String,int *);
 extern size_t headersize(const char *,int);
 extern FILE *openinputfile(Header *, Bool *,const Filename *,
                            String, int *,size_t *,const Config *);
+extern FILE *openinputfile2(Header *, Bool *,const Filename *,
+                            String, int *,size_t *,Chunkheader **,
+                            const Config *);
+extern Chunkheader *freadchunkheader(FILE *,const char *,const Header *,Bool);
+extern Bool fwritechunkheader(FILE *,const Chunkheader *);
+extern void freechunkheader(Chunkheader *);
+extern Bool readchunks(FILE *,const Chunkheader *,Bool,void *,int,int,int);
+extern long long fwritechunk(FILE *,const Chunkheader *,const void *,int,int);
 extern FILE *openmetafile(Header *, Bool *,size_t *,const char *,Bool);
 extern void fprintheader(FILE *,const Header *);
 
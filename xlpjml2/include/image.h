@@ -27,6 +27,8 @@
 #define DEFAULT_IMAGE_INPORT 2225  /* Default port for ingoing connection */
 #define DEFAULT_IMAGE_OUTPORT 2224 /* Default port for outgoing connection */
 #define WAIT_IMAGE 12000             /* wait for IMAGE connection (sec) */
+#define NBPOOLS (sizeof(Biomass)/sizeof(float)) /* number of biomass pools sent */
+#define NIMAGECROPS (sizeof(Image_landuse)/sizeof(float)) /* number of IMAGE land-use types */
 
 /* Definition of datatypes */
 
@@ -105,22 +107,106 @@ typedef struct
   Real biomass_yield_annual; /* biomass yield scaled to annual fractions */
 } Image_data;
 
+/* Segments of message received from IMAGE, data of each segment is
+   stored cell by cell */
+
+typedef enum
+{
+  IMAGE_TEMP,           /* temperature (deg C) */
+  IMAGE_PREC,           /* precipitation (mm/day) */
+  IMAGE_CLOUD,          /* cloudiness (fraction) */
+  IMAGE_WET,            /* wet days (fraction) */
+  IMAGE_TIMBER_FRAC,    /* timber harvest shares, only with land use */
+  IMAGE_FBURNT,         /* timber burnt shares (int), only with land use */
+  IMAGE_LANDUSE,        /* land-use shares (Image_landuse), only with land use */
+  IMAGE_PRODUCTPOOL,    /* timber product pool distribution (Timber), only with land use */
+  NIMAGEIN
+} Image_in;
+
+/* Segments of message sent to IMAGE */
+
+typedef enum
+{
+  IMAGE_BIOMASS,               /* biomass pools (Biomass) */
+  IMAGE_BIOME,                 /* biome (int) */
+  IMAGE_NEP,                   /* net ecosystem production (gC/m2) */
+  IMAGE_NPP,                   /* net primary production (gC/m2) */
+  IMAGE_RH,                    /* heterotrophic respiration, only SENDSEP */
+  IMAGE_HARVEST_AGRIC,         /* agricultural harvest, only SENDSEP */
+  IMAGE_HARVEST_BIOFUEL,       /* biofuel harvest, only SENDSEP */
+  IMAGE_HARVEST_TIMBER,        /* timber harvest, only SENDSEP */
+  IMAGE_FIRE,                  /* fire carbon emissions (gC/m2) */
+  IMAGE_FIREEMISSION_DEFOREST, /* emissions from deforestation (gC/m2) */
+  IMAGE_PRODUCT_TURNOVER_FAST, /* turnover of fast product pool, only SENDSEP */
+  IMAGE_PRODUCT_TURNOVER_SLOW, /* turnover of slow product pool, only SENDSEP */
+  IMAGE_TRAD_BIOFUEL,          /* traditional biofuel, only SENDSEP */
+  NIMAGEOUT
+} Image_out;
+
+typedef struct
+{
+  int nseg;                /* number of segments */
+  int nitem;               /* number of items per cell */
+  int size;                /* number of items in message */
+  int offset[NIMAGEOUT+1]; /* offset of segments (items per cell) */
+  float *data;             /* data of local cells, segment by segment */
+  float *buffer;           /* message of all cells on root task */
+#ifdef USE_MPI
+  float *stage;            /* message ordered by tasks on root task */
+  int *counts,*offsets;    /* number of items and offsets for each task */
+#endif
+} Image_message;
+
+typedef struct
+{
+  Socket *socket;          /* socket for ingoing data */
+  Image_message in;        /* data received from IMAGE */
+  Image_message out;       /* data sent to IMAGE */
+  Real co2;                /* atmospheric CO2 of current year (ppm) */
+  double co2_recv;         /* atmospheric CO2 received in background (ppm) */
+  Bool posted;             /* receive of next year is pending */
+  Bool rc;                 /* error occurred in receiving data */
+#ifdef USE_MPI
+  int *ncell,*celloffset;  /* number of cells and offsets for each task */
+#endif
+#ifndef _WIN32
+  pthread_t thread;        /* thread receiving data from IMAGE */
+#endif
+} Image_coupler;
+
 /* Declaration of functions */
 
 extern Image_data *new_image(const Product *);
 extern Bool open_image(Config *);
 extern void close_image(const Config *);
 extern Real product_turnover(Image_data *);
-extern Bool send_image_data(const Cell *,const  Climate *,int,const Config *);
-extern Bool receive_image_climate(Climate *,const Cell *,int,const Config *);
-extern Bool receive_image_productpools(Cell *,const Config *);
-extern Bool receive_image_luc(Cell *,int,int,const Config *);
-extern Bool receive_image_data(Cell *,int,int,const Config *);
-extern Real receive_image_co2(const Config *);
+extern Image_coupler *new_imagecoupler(const Climate *,const Config *);
+extern void free_imagecoupler(Image_coupler *);
+extern void post_image_receive(Image_coupler *,const Config *);
+#ifdef USE_MPI
+extern void reorder_image(Image_message *,const Image_coupler *,int,int,Bool);
+#endif
+extern Bool wait_image_receive(Image_coupler *,const Config *);
+extern Bool send_image_data(const Cell *,const  Climate *,int,
+                            Image_coupler *,const Config *);
+extern Bool receive_image_climate(Climate *,const Cell *,int,
+                                  const Image_coupler *,const Config *);
+extern void receive_image_productpools(Cell *,const Image_coupler *,
+                                       const Config *);
+extern void receive_image_luc(Cell *,int,int,const Image_coupler *,
+                              const Config *);
+extern void receive_image_data(Cell *,int,int,const Image_coupler *,
+                               const Config *);
+extern Real receive_image_co2(const Image_coupler *);
 extern Productinit *initproductinit(const Config *);
 extern Bool getproductpools(Productinit *,Product [],int);
 extern void freeproductinit(Productinit *);
 extern void setoutput_image(Cell *,int);
 extern void monthlyoutput_image(Output *,const Climate *,int,int);
 
+/* Definition of macros */
+
+#define getsegment_image(msg,seg,ncell) ((msg)->data+(msg)->offset[seg]*(ncell))
+#define nitems_image(msg,seg) ((msg)->offset[(seg)+1]-(msg)->offset[seg])
+
 #endif /* IMAGE_H */
@@ -20,6 +20,8 @@
 typedef enum {NATURAL,SETASIDE_RF,SETASIDE_IR,AGRICULTURE,MANAGEDFOREST,
               GRASSLAND,BIOMASS_TREE,BIOMASS_GRASS,KILL} Landusetype;
 
+#define NLANDUSETYPE (KILL+1) /* number of land-use types */
+
 typedef struct landuse *Landuse;
 
 typedef struct
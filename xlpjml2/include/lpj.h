@@ -63,6 +63,7 @@ typedef struct stand Stand; /* forward declaration of stand */
 #include "pftpar.h"
 #include "output.h"
 #include "date.h"
+#include "numeric.h"
 #include "manage.h"
 #include "pft.h"
 #include "config.h"
@@ -80,7 +81,6 @@ typedef struct stand Stand; /* forward declaration of stand */
 #include "errmsg.h"
 #include "pftlist.h"
 #include "spitfire.h"
-#include "numeric.h"
 #include "units.h"
 #include "conf.h"
 #include "stand.h"
@@ -114,11 +114,15 @@ extern char *lpj_usage;
 
 extern Cell *newgrid(Config *,const Standtype [],int,int,int);
 extern Bool fwriterestart(const Cell[],int,int,int,const char *,const Config *);
+extern Bool fwriterestart_async(const Cell[],int,int,int,const char *,const Config *);
+extern Bool waitrestart(void);
 extern FILE *openrestart(const char *,Config *,int,Bool *);
+extern FILE *openrestart2(const char *,Config *,int,Bool *,long long **);
 extern void copyright(const char *);
 extern void printlicense(void);
 extern void help(const char *,const char *);
 extern void fprintflux(FILE *file,Flux,Real,int,const Config *);
+extern void printmemstat(const char *,long long,const Config *);
 #ifdef USE_MPI
 extern void failonerror(const Config *,int,int,const char *);
 extern Bool iserror(int,const Config *);
@@ -19,6 +19,14 @@
 
 typedef Real (*Bisectfcn)(Real,void *);
 
+typedef struct
+{
+  unsigned int key[2]; /**< seed and index of random stream */
+  unsigned int ctr[4]; /**< global cell index, time step, day and draw */
+} Randstream;
+
+#define STREAM_PREC 1 /* random stream of precipitation generator */
+
 /* Declaration of functions */
 
 extern Real bisect(Real (*)(Real,void *),Real,Real,void *,Real,Real,int); /* find zero */
@@ -27,6 +35,9 @@ extern void linreg(Real *,Real *,const Real[],int); /* linear regression */
 extern void setseed(int); /* set seed of random number generator */
 extern int getseed(void); /* get seed of random number generator */
 extern Real randfrac(void); /* random number generator */
+extern void philox4x32(unsigned int [4],const unsigned int [4],const unsigned int [2]);
+extern void initrandstream(Randstream *,int,int,int,int);
+extern void randstream(Real [4],const Randstream *); /* counter-based random numbers */
 extern void petpar(Real *,Real *,Real *,Real *,Real,int,Real,Real,Real);
 extern void petpar2(Real *,Real *,Real *,Real,int,Real,Real,Real,Bool,Real);
 extern void petpar3(Real *,Real *,Real *,Real,int,Real,Real,Real);
@@ -25,6 +25,7 @@ typedef struct
   int fmt;           /**< file format (TXT/RAW/CDF) */
   Bool oneyear;      /**< separate output files for each year (TRUE/FALSE) */
   Bool compress;     /**< compress file after write (TRUE/FALSE) */
+  int aggregate;     /**< aggregation of output (NO_AGGREGATE, AGGREGATE_COUNTRY, ...) */
   const char *filename;
   union
   { 
@@ -36,19 +37,43 @@ typedef struct
   } fp;
 } File;
 
+typedef struct
+{
+  void *data;  /**< staging buffer */
+  size_t size; /**< size of buffer (bytes) */
+} Outputbuffer;
+
+typedef struct
+{
+  int nbin;   /**< number of bins, zero if aggregation is not used */
+  int *bin;   /**< bin of each active cell or -1 */
+  Real *sum;  /**< sum over bins of this task */
+  Real *sum_all; /**< sum over bins of all tasks on root task */
+} Aggregate;
+
 typedef struct
 {
 #ifdef USE_MPI
-  int *counts;         /**< sizes for MPI_Gatherv */
-  int *offsets;        /**< offsets for MPI_Gatherv */
+  Gatherplan *plan;     /**< gather plan for output of active cells */
+  Gatherplan *plan_all; /**< gather plan for output of all cells */
+  Gatherplan **plan_block; /**< gather plans for blocks of layers or days indexed by block length */
+  int nplan_block;      /**< size of plan_block array */
 #endif
   Outputmethod method;
   Socket *socket;
+  Sendbuffer *sendbuf; /**< send buffer of socket protocol version 2 or NULL */
   File *files;
   int n;          /**< size of File array */
   Coord_array *index;
   Coord_array *index_all;
   Bool withdaily; /**< with daily output (TRUE/FALSE) */
+  float **daily;  /**< buffer for daily output or NULL */
+  int daily_first; /**< first day of year in daily output buffer */
+  int daily_n;    /**< number of days in daily output buffer */
+  Outputbuffer stage;  /**< buffer for output with several layers */
+  Outputbuffer gather; /**< buffer for gathered output on root task */
+  Aggregate *aggregate; /**< bins for aggregated output indexed by aggregation or NULL */
+  Real *area;     /**< area of active cells (m2) for aggregated output or NULL */
 } Outputfile;
 
 extern int findfile(const Outputvar *,int,int);
@@ -60,4 +85,18 @@ extern Coord_array *createcoord(Outputfile *,const Cell *,const Config *);
 extern Coord_array *createcoord_all(const Cell *,const Config *);
 extern Coord_array *createindex(const Coord *,int,Coord,Bool);
 extern void outputnames(Outputfile *,const Config *);
+extern void output_flux(Outputfile *,const Flux *,int);
+extern Bool flush_output(Outputfile *,int,int);
+extern void *getoutputbuffer(Outputbuffer *,size_t);
+extern void writelayers(Outputfile *,int,void *,Type,int,int,int,const Config *);
+extern Bool initaggregate(Outputfile *,const Cell *,const Config *);
+extern void writeaggregate(Outputfile *,int,const float [],const Config *);
+extern void freeaggregate(Outputfile *);
+#ifdef USE_MPI
+extern Gatherplan *getgatherplan(Outputfile *,int,const Config *);
+extern void mpi_writeoutput_socket(Outputfile *,int,int,Type,void *,MPI_Datatype,
+                                   Gatherplan *,const Config *);
+#else
+extern void writeoutput_socket(Outputfile *,int,int,Type,const void *,int);
+#endif
 #endif
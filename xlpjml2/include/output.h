@@ -21,55 +21,81 @@
 
 #define DEFAULT_PORT 2222 /* default port for socket connection */
 
+/* Steps of frames in socket protocol version 2, days and months are >=0 */
+
+#define SOCKET_ANNUAL -1  /* annual and PFT-specific output */
+#define SOCKET_INIT -2    /* grid, country and region codes */
+#define SOCKET_FLUX -3    /* global fluxes */
+
+#ifdef USE_MPI
+
+#define NGATHERTYPE 3 /* number of datatypes with persistent gather (float, short, int) */
+
+typedef struct
+{
+  int size;        /**< total number of items */
+  int *counts;     /**< number of items of each task */
+  int *offsets;    /**< offsets of items of each task */
+  void *vec;       /**< receive buffer for items of at most 4 bytes, only on root task */
+  int rank;        /**< MPI rank */
+  MPI_Comm comm;   /**< MPI communicator */
+#if MPI_VERSION>=4
+  void *send;      /**< send buffer bound to persistent requests */
+  MPI_Request request[NGATHERTYPE]; /**< persistent gather of float, short and int */
+#endif
+} Gatherplan;
+
+#endif
+
 typedef struct
 {
-  Real lai;
-  Real phen;
-  Real cleaf;
-  Real croot;
-  Real cso;
-  Real cpool;
-  Real wdf;
-  Real growingday;
-  Real pvd;
-  Real phu;
-  Real fphu;
-  Real laimaxad;
-  Real lainppdeficit;
-  Real husum;
-  Real vdsum;
-  Real wscal;
-  Real npp;
-  Real gpp;
-  Real rd;
-  Real rroot;
-  Real rso;
-  Real rpool;
-  Real gresp;
-  Real trans;
-  Real evap;
-  Real prec;
-  Real perc;
-  Real irrig;
-  Real w0;
-  Real w1;
-  Real wevap;
-  Real hi;
-  Real fhiopt;
-  Real himind;
-  Real froot;
-  Real temp;
-  Real sun;
-  Real par;
-  Real daylength;
-  Real swe; /**< snow water equivalent*/
-  Real discharge; 
-  Real runoff;
-  Real rh;
-  Real interc;
-  Real assim;
-  Real rot_mode;
-  Real pet;
+  Storereal lai;
+  Storereal phen;
+  Storereal cleaf;
+  Storereal croot;
+  Storereal cso;
+  Storereal cpool;
+  Storereal wdf;
+  Storereal growingday;
+  Storereal pvd;
+  Storereal phu;
+  Storereal fphu;
+  Storereal laimaxad;
+  Storereal lainppdeficit;
+  Storereal husum;
+  Storereal vdsum;
+  Storereal wscal;
+  Storereal npp;
+  Storereal gpp;
+  Storereal rd;
+  Storereal rroot;
+  Storereal rso;
+  Storereal rpool;
+  Storereal gresp;
+  Storereal trans;
+  Storereal evap;
+  Storereal prec;
+  Storereal perc;
+  Storereal irrig;
+  Storereal w0;
+  Storereal w1;
+  Storereal wevap;
+  Storereal hi;
+  Storereal fhiopt;
+  Storereal himind;
+  Storereal froot;
+  Storereal temp;
+  Storereal sun;
+  Storereal par;
+  Storereal daylength;
+  Storereal swe; /**< snow water equivalent*/
+  Storereal discharge; 
+  Storereal runoff;
+  Storereal rh;
+  Storereal interc;
+  Storereal assim;
+  Storereal rot_mode;
+  Storereal pet;
   int cft;
   Bool irrigation;
 } Daily_outputs;
@@ -86,46 +112,46 @@ typedef struct
 
 typedef struct
 {
-  Real mnpp;             /**< Monthly NPP (gC/m2) */
-  Real mgpp;             /**< Monthly GPP (gC/m2) */
-  Real mrh;              /**< monthly heterotrophic respiration (gC/m2) */
-  Real mtransp;          /**< Monthly transpiration (mm) */
-  Real mtransp_b;        /**< Monthly transpired irrigation water (mm) */
-  Real atransp;          /**< Yearly transpiration (mm) */
-  Real mrunoff;          /**< Monthly runoff (mm) */
-  Real mdischarge;       /**< Monthly discharge (1.000.000 m3/day) */
-  Real mwateramount;     /**< Mean wateramount in month (1.000.000 m3) */
-  Real mevap;            /**< Monthly evaporation (mm) */
-  Real mevap_b;          /**< Monthly evaporation of irrigation water (mm) */
-  Real aevap;            /**< Yearly evaporation (mm) */
-  Real minterc;          /**< Monthly interception (mm) */
-  Real minterc_b;        /**< Monthly blue interception (mm) */
-  Real ainterc;          /**< Yearly interception (mm) */
-  Real mpet;             /**< Monthly PET (mm) */
-  Real mswc[NSOILLAYER]; /**< monthly soil water content*/
-  Real mrootmoist;        /**< monthly plant available water for evapotranspiration fractional*/
-  Real firec;            /**< annual fire carbon emissions (gC/m2)*/
-  Real mfirec;           /**< monthly fire carbon emissions (gC/m2)*/
-  Real mnfire;           /**< monthly number of fires */
-  Real mfiredi;          /**< monthly fire danger index */
+  Storereal mnpp;             /**< Monthly NPP (gC/m2) */
+  Storereal mgpp;             /**< Monthly GPP (gC/m2) */
+  Storereal mrh;              /**< monthly heterotrophic respiration (gC/m2) */
+  Storereal mtransp;          /**< Monthly transpiration (mm) */
+  Storereal mtransp_b;        /**< Monthly transpired irrigation water (mm) */
+  Storereal atransp;          /**< Yearly transpiration (mm) */
+  Storereal mrunoff;          /**< Monthly runoff (mm) */
+  Storereal mdischarge;       /**< Monthly discharge (1.000.000 m3/day) */
+  Storereal mwateramount;     /**< Mean wateramount in month (1.000.000 m3) */
+  Storereal mevap;            /**< Monthly evaporation (mm) */
+  Storereal mevap_b;          /**< Monthly evaporation of irrigation water (mm) */
+  Storereal aevap;            /**< Yearly evaporation (mm) */
+  Storereal minterc;          /**< Monthly interception (mm) */
+  Storereal minterc_b;        /**< Monthly blue interception (mm) */
+  Storereal ainterc;          /**< Yearly interception (mm) */
+  Storereal mpet;             /**< Monthly PET (mm) */
+  Storereal mswc[NSOILLAYER]; /**< monthly soil water content*/
+  Storereal mrootmoist;        /**< monthly plant available water for evapotranspiration fractional*/
+  Storereal firec;            /**< annual fire carbon emissions (gC/m2)*/
+  Storereal mfirec;           /**< monthly fire carbon emissions (gC/m2)*/
+  Storereal mnfire;           /**< monthly number of fires */
+  Storereal mfiredi;          /**< monthly fire danger index */
   Tracegas mfireemission;    /**< monthly fire emissions */
-  Real mburntarea;       /**< monthly burnt area */
-  Real aburntarea;       /**< yearly burnt area */
-  Real mprec_image;      /**< monthly precipitation received from IMAGE [mm/month]*/
-  Real mtemp_image;      /**< monthly temperature received from IMAGE [K] */
-  Real msun_image;       /**< monthly cloudiness received from IMAGE [% sunshine = 100-%cloud]*/
-  Real mwet_image;       /**< monthly wet days received from IMAGE [days/month]*/
-  Real firef;            /**< fire frequency */
-  Real flux_estab;       /**< establishment flux (gC/m2) */
-  Real flux_harvest;     /**< harvest flux (gC/m2) */
-  Real flux_rharvest_burnt; /**< crop residuals burnt outside of field (gC/m2)*/
-  Real flux_rharvest_burnt_in_field; /*crop residuals burnt in field (gC/m2)*/
-  Real mirrig;           /**< Monthly irrigation (mm) */
-  Real airrig;           /**< Yearly irrigation (mm) */
-  Real mwd_unsustainable; /**< Monthly withdrawal from unsustainable source (mm) */
-  Real awd_unsustainable; /**< Yearly withdrawal from unsustainable source (mm) */
-  Real munmet_demand;     /**< monthly unavailable requested irrigation water (mm) */
-  Real *cft_airrig;      /**< Yearly irrigation per cft (mm) */
+  Storereal mburntarea;       /**< monthly burnt area */
+  Storereal aburntarea;       /**< yearly burnt area */
+  Storereal mprec_image;      /**< monthly precipitation received from IMAGE [mm/month]*/
+  Storereal mtemp_image;      /**< monthly temperature received from IMAGE [K] */
+  Storereal msun_image;       /**< monthly cloudiness received from IMAGE [% sunshine = 100-%cloud]*/
+  Storereal mwet_image;       /**< monthly wet days received from IMAGE [days/month]*/
+  Storereal firef;            /**< fire frequency */
+  Storereal flux_estab;       /**< establishment flux (gC/m2) */
+  Storereal flux_harvest;     /**< harvest flux (gC/m2) */
+  Storereal flux_rharvest_burnt; /**< crop residuals burnt outside of field (gC/m2)*/
+  Storereal flux_rharvest_burnt_in_field; /*crop residuals burnt in field (gC/m2)*/
+  Storereal mirrig;           /**< Monthly irrigation (mm) */
+  Storereal airrig;           /**< Yearly irrigation (mm) */
+  Storereal mwd_unsustainable; /**< Monthly withdrawal from unsustainable source (mm) */
+  Storereal awd_unsustainable; /**< Yearly withdrawal from unsustainable source (mm) */
+  Storereal munmet_demand;     /**< monthly unavailable requested irrigation water (mm) */
+  Storereal *cft_airrig;      /**< Yearly irrigation per cft (mm) */
   int *sdate;            /**< sowing date */
   int *hdate;            /**< Harvest date */
 #ifdef DOUBLE_HARVEST
@@ -133,107 +159,107 @@ typedef struct
   int *hdate2;           /**< Harvest date */
   int *syear;
   int *syear2;
-  Real *cft_airrig2;     /**< Yearly irrigation per cft (mm) */
+  Storereal *cft_airrig2;     /**< Yearly irrigation per cft (mm) */
   Harvest *pft_harvest2;
-  Real *growing_period2;      /**< lenght of growing period in days */
-  Real *cft_pet2; /**< cft PET */
-  Real *cft_transp2;        /**< cft specific transpiration (mm) */
-  Real *cft_evap2;          /**< cft specific soil evaporation (mm) */
-  Real *cft_interc2;        /**< cft specific interception (mm) */
-  Real *cft_nir2;           /**< cft specific net irrigation requirement (mm) */
-  Real *cft_temp2;          /**< cft specific temperature sum (day degC) */
-  Real *cft_prec2;          /**< cft specific precipitation (mm) */  
-  Real *cft_srad2;          /**< cft specific short-wave radiation (W/m2) */
-  Real *cft_aboveground_biomass2; /**< above ground biomass for crops before harvest (for grass before last harvest of year)*/
-  Real *cftfrac2;           /**< cft fraction */
+  Storereal *growing_period2;      /**< lenght of growing period in days */
+  Storereal *cft_pet2; /**< cft PET */
+  Storereal *cft_transp2;        /**< cft specific transpiration (mm) */
+  Storereal *cft_evap2;          /**< cft specific soil evaporation (mm) */
+  Storereal *cft_interc2;        /**< cft specific interception (mm) */
+  Storereal *cft_nir2;           /**< cft specific net irrigation requirement (mm) */
+  Storereal *cft_temp2;          /**< cft specific temperature sum (day degC) */
+  Storereal *cft_prec2;          /**< cft specific precipitation (mm) */  
+  Storereal *cft_srad2;          /**< cft specific short-wave radiation (W/m2) */
+  Storereal *cft_aboveground_biomass2; /**< above ground biomass for crops before harvest (for grass before last harvest of year)*/
+  Storereal *cftfrac2;           /**< cft fraction */
 #endif
-  Real *pft_npp;         /**< Pft specific NPP (gC/m2) */
+  Storereal *pft_npp;         /**< Pft specific NPP (gC/m2) */
   Harvest *pft_harvest;
-  Real *fpc;             /**< foliar projective cover (FPC) */
-  Real *pft_gcgp;
-  Real *gcgp_count;
-  Real mevap_lake;       /**< Monthly lake evaporation (mm) */
-  Real aevap_lake;       /**< Yearly lake evaporation (mm) */
-  Real mevap_res;        /**< Monthly reservoir evaporation (mm) */
-  Real aevap_res;        /**< Yearly reservoir evaporation (mm) */
-  Real mprec_res;        /**< Monthly reservoir precipitation (mm) */
-  Real mres_storage;     /**< Monthly mean reservoir storage (million m3) */
-  Real mres_demand;      /**< Monthly reservoir demand (million m3) */
-  Real mtarget_release;  /**< Monthly target release (1.000.000 m3/day) */
-  Real mres_cap;         /**< monthly output of reservoir capacity (in million m3) */
-  Real mwd_local;        /**<  monthly local withdrawal (mm) total water used for local and neighbour irrigation, including water that goes into irrig_stor, which could go back to river */
-  Real mwd_neighb;       /**< monthly neighbour withdrawal (mm); negative values means give away to neighbour, positive taken for local irrigation from neighbour */
-  Real mwd_res;          /**< monthly reservoir withdrawal (mm) */
-  Real mwd_return;       /**< monthly withdrawals returned to river (mm) */
-  Real aconv_loss_evap;  /**< Yearly evaporative conveyance loss of irrigation water withdrawals (mm) */
-  Real aconv_loss_drain; /**< Yearly drainage conveyance loss (mm) */
-  Real mconv_loss_evap;  /**< Monthly evaporative conveyance loss (mm) */
-  Real mconv_loss_drain; /**< Monthly drainage conveyance loss (mm) */
-  Real mstor_return;     /**< Monthly water amount returned from irrig stor into river system*/
-  Real mprec;            /**< Monthly precipitation (mm)*/
-  Real mrain;            /**< Monthly precipitation fallen as rain (minus snowfall) (mm)*/
-  Real msnowf;           /**< Monthly precipitation fallen as snow */
-  Real mmelt;            /**< Monthly snowmelt (mm)*/
-  Real msnowrunoff;      /**< Monthly runoff from snow above snowpack maximum */
-  Real mswe;             /**< Monthly average snow water equivalent (mm)*/
-  Real awateruse_hil;    /**< yearly water withdrawal of household, industry and livestock */
-  Real mreturn_flow_b;   /**< monthly blue water return flow of runoff, conv. loss is not included */
-  Real input_lake;       /**< yearly precipitation input to lakes (mm) */
-  Real adischarge;       /**< Annual discharge (1.000.000 m3/year) */
-  Real surface_storage;  /**< Water stored in the suface storages by the end of year (dm3) */
-  Real soil_storage;     /**< Water stored in the soil column by the end of year (dm3) */
-  Real *cftfrac;         /**< cft fraction */
-  Real *cft_consump_water_g; /**< CFT specific green water consumption (mm) */
-  Real *cft_consump_water_b; /**< CFT specific blue water consumption (mm) */
-  Real *growing_period;      /**< lenght of growing period in days */
-  Real *cft_pet;           /**< cft PET */
-  Real *cft_transp;        /**< cft specific transpiration (mm) */
-  Real *cft_transp_b;      /**< cft specific transpiration (mm) */
-  Real *cft_evap;          /**< cft specific soil evaporation (mm) */
-  Real *cft_evap_b;        /**< cft specific blue soil evaporation (mm) */
-  Real *cft_interc;        /**< cft specific interception (mm) */
-  Real *cft_interc_b;      /**< cft specific blue interception (mm) */
-  Real *cft_return_flow_b; /**< cft specific irrigation return flows from surface runoff, lateral runoff and percolation (mm) */
-  Real *cft_nir;           /**< cft specific net irrigation requirement (mm) */
-  Real *cft_fpar;          /**< cft specific fpar */
-  Real *cft_temp;          /**< cft specific temperature sum (day degC) */
-  Real *cft_prec;          /**< cft specific precipitation (mm) */  
-  Real *cft_srad;          /**< cft specific short-wave radiation (W/m2) */
-  Real *cft_aboveground_biomass; /**< above ground biomass for crops before harvest (for grass before last harvest of year)*/
-  Real *cft_conv_loss_evap; /**< cft specific evaporative conveyance losses (mm) */
-  Real *cft_conv_loss_drain; /**< cft specific drainage conveyance losses (mm) */
+  Storereal *fpc;             /**< foliar projective cover (FPC) */
+  Storereal *pft_gcgp;
+  Storereal *gcgp_count;
+  Storereal mevap_lake;       /**< Monthly lake evaporation (mm) */
+  Storereal aevap_lake;       /**< Yearly lake evaporation (mm) */
+  Storereal mevap_res;        /**< Monthly reservoir evaporation (mm) */
+  Storereal aevap_res;        /**< Yearly reservoir evaporation (mm) */
+  Storereal mprec_res;        /**< Monthly reservoir precipitation (mm) */
+  Storereal mres_storage;     /**< Monthly mean reservoir storage (million m3) */
+  Storereal mres_demand;      /**< Monthly reservoir demand (million m3) */
+  Storereal mtarget_release;  /**< Monthly target release (1.000.000 m3/day) */
+  Storereal mres_cap;         /**< monthly output of reservoir capacity (in million m3) */
+  Storereal mwd_local;        /**<  monthly local withdrawal (mm) total water used for local and neighbour irrigation, including water that goes into irrig_stor, which could go back to river */
+  Storereal mwd_neighb;       /**< monthly neighbour withdrawal (mm); negative values means give away to neighbour, positive taken for local irrigation from neighbour */
+  Storereal mwd_res;          /**< monthly reservoir withdrawal (mm) */
+  Storereal mwd_return;       /**< monthly withdrawals returned to river (mm) */
+  Storereal aconv_loss_evap;  /**< Yearly evaporative conveyance loss of irrigation water withdrawals (mm) */
+  Storereal aconv_loss_drain; /**< Yearly drainage conveyance loss (mm) */
+  Storereal mconv_loss_evap;  /**< Monthly evaporative conveyance loss (mm) */
+  Storereal mconv_loss_drain; /**< Monthly drainage conveyance loss (mm) */
+  Storereal mstor_return;     /**< Monthly water amount returned from irrig stor into river system*/
+  Storereal mprec;            /**< Monthly precipitation (mm)*/
+  Storereal mrain;            /**< Monthly precipitation fallen as rain (minus snowfall) (mm)*/
+  Storereal msnowf;           /**< Monthly precipitation fallen as snow */
+  Storereal mmelt;            /**< Monthly snowmelt (mm)*/
+  Storereal msnowrunoff;      /**< Monthly runoff from snow above snowpack maximum */
+  Storereal mswe;             /**< Monthly average snow water equivalent (mm)*/
+  Storereal awateruse_hil;    /**< yearly water withdrawal of household, industry and livestock */
+  Storereal mreturn_flow_b;   /**< monthly blue water return flow of runoff, conv. loss is not included */
+  Storereal input_lake;       /**< yearly precipitation input to lakes (mm) */
+  Storereal adischarge;       /**< Annual discharge (1.000.000 m3/year) */
+  Storereal surface_storage;  /**< Water stored in the suface storages by the end of year (dm3) */
+  Storereal soil_storage;     /**< Water stored in the soil column by the end of year (dm3) */
+  Storereal *cftfrac;         /**< cft fraction */
+  Storereal *cft_consump_water_g; /**< CFT specific green water consumption (mm) */
+  Storereal *cft_consump_water_b; /**< CFT specific blue water consumption (mm) */
+  Storereal *growing_period;      /**< lenght of growing period in days */
+  Storereal *cft_pet;           /**< cft PET */
+  Storereal *cft_transp;        /**< cft specific transpiration (mm) */
+  Storereal *cft_transp_b;      /**< cft specific transpiration (mm) */
+  Storereal *cft_evap;          /**< cft specific soil evaporation (mm) */
+  Storereal *cft_evap_b;        /**< cft specific blue soil evaporation (mm) */
+  Storereal *cft_interc;        /**< cft specific interception (mm) */
+  Storereal *cft_interc_b;      /**< cft specific blue interception (mm) */
+  Storereal *cft_return_flow_b; /**< cft specific irrigation return flows from surface runoff, lateral runoff and percolation (mm) */
+  Storereal *cft_nir;           /**< cft specific net irrigation requirement (mm) */
+  Storereal *cft_fpar;          /**< cft specific fpar */
+  Storereal *cft_temp;          /**< cft specific temperature sum (day degC) */
+  Storereal *cft_prec;          /**< cft specific precipitation (mm) */  
+  Storereal *cft_srad;          /**< cft specific short-wave radiation (W/m2) */
+  Storereal *cft_aboveground_biomass; /**< above ground biomass for crops before harvest (for grass before last harvest of year)*/
+  Storereal *cft_conv_loss_evap; /**< cft specific evaporative conveyance losses (mm) */
+  Storereal *cft_conv_loss_drain; /**< cft specific drainage conveyance losses (mm) */
   int  *cft_irrig_events;  /**< number of irrigation days within growing season */
-  Real prod_turnover;      /**< carbon emissions from product turnover [gC/m2/a] in IMAGE coupling */
-  Real deforest_emissions; /**< carbon emissions from deforested wood burnt [gC/m2/a] in IMAGE coupling */
-  Real trad_biofuel;       /**< carbon emissions from traditional biofuel burnt [gC/m2/a] in IMAGE coupling */
-  Real flux_firewood;      /**< carbon emissions from domestic wood use [gC/m2/a]*/
-  Real fburn;              /**< fraction of deforested wood burnt [0-1]*/
-  Real ftimber;            /**< fraction of deforested wood harvested as timber [0-1]*/
-  Real timber_harvest;     /**< carbon harvested as timber [gC/m2/a] */
-  Real product_pool_fast;  /**< carbon in the fast product pool */
-  Real product_pool_slow;  /**< carbon in the slow product pool */
-  Real *cft_luc_image;     /**< LUC data received by IMAGE [0-1], CFT specific */
-  Real msoiltemp[NSOILLAYER]; /**< monthly soil temperature in deg C for  6 layer*/
-  Real mrunoff_surf;       /**< monthly surface runoff in mm*/
-  Real mrunoff_lat;        /**< monthly lateral runoff in mm*/
-  Real mseepage;           /**< monthly seepage water in mm*/
-  Real mgcons_rf;          /**< monthly green water consumption on rainfed stands */
-  Real mgcons_irr;         /**< monthly green water consumption on irrigated stands */
-  Real mbcons_irr;         /**< monthly blue water consumption on irrigated stands */
-  Real mfapar;             /**< monthly FAPAR (unitless) */
-  Real malbedo;            /**< monthly albedo (unitless) */
-  Real mphen_tmin;         /**< monthly phenology cold-temperature limiting function */
-  Real mphen_tmax;         /**< monthly phenology heat stress limiting function */
-  Real mphen_light;        /**< monthly phenology light limiting function */
-  Real mphen_water;        /**< monthly phenology water limiting function */
-  Real mwscal;             /**< monthly water scalar */
-  Real dcflux;             /**< daily carbon flux from LPJ to atmosphere (gC/m2/day) */
+  Storereal prod_turnover;      /**< carbon emissions from product turnover [gC/m2/a] in IMAGE coupling */
+  Storereal deforest_emissions; /**< carbon emissions from deforested wood burnt [gC/m2/a] in IMAGE coupling */
+  Storereal trad_biofuel;       /**< carbon emissions from traditional biofuel burnt [gC/m2/a] in IMAGE coupling */
+  Storereal flux_firewood;      /**< carbon emissions from domestic wood use [gC/m2/a]*/
+  Storereal fburn;              /**< fraction of deforested wood burnt [0-1]*/
+  Storereal ftimber;            /**< fraction of deforested wood harvested as timber [0-1]*/
+  Storereal timber_harvest;     /**< carbon harvested as timber [gC/m2/a] */
+  Storereal product_pool_fast;  /**< carbon in the fast product pool */
+  Storereal product_pool_slow;  /**< carbon in the slow product pool */
+  Storereal *cft_luc_image;     /**< LUC data received by IMAGE [0-1], CFT specific */
+  Storereal msoiltemp[NSOILLAYER]; /**< monthly soil temperature in deg C for  6 layer*/
+  Storereal mrunoff_surf;       /**< monthly surface runoff in mm*/
+  Storereal mrunoff_lat;        /**< monthly lateral runoff in mm*/
+  Storereal mseepage;           /**< monthly seepage water in mm*/
+  Storereal mgcons_rf;          /**< monthly green water consumption on rainfed stands */
+  Storereal mgcons_irr;         /**< monthly green water consumption on irrigated stands */
+  Storereal mbcons_irr;         /**< monthly blue water consumption on irrigated stands */
+  Storereal mfapar;             /**< monthly FAPAR (unitless) */
+  Storereal malbedo;            /**< monthly albedo (unitless) */
+  Storereal mphen_tmin;         /**< monthly phenology cold-temperature limiting function */
+  Storereal mphen_tmax;         /**< monthly phenology heat stress limiting function */
+  Storereal mphen_light;        /**< monthly phenology light limiting function */
+  Storereal mphen_water;        /**< monthly phenology water limiting function */
+  Storereal mwscal;             /**< monthly water scalar */
+  Storereal dcflux;             /**< daily carbon flux from LPJ to atmosphere (gC/m2/day) */
 #ifdef COUPLING_WITH_FMS
-  Real dwflux;             /**< daily water flux from LPJ to atmosphere (kg/m2/day) */
+  Storereal dwflux;             /**< daily water flux from LPJ to atmosphere (kg/m2/day) */
 #endif
-  Real mirrig_rw;          /**< monthly supplementary rain water irrigation in mm */
-  Real mlakevol;           /**< monthly mean lake content volume in dm3 */
-  Real mlaketemp;          /**< monthly mean lake surface temperature in deg C */
+  Storereal mirrig_rw;          /**< monthly supplementary rain water irrigation in mm */
+  Storereal mlakevol;           /**< monthly mean lake content volume in dm3 */
+  Storereal mlaketemp;          /**< monthly mean lake surface temperature in deg C */
   Daily_outputs daily;     /**< structure for daily outputs */
 } Output;
 
@@ -287,17 +313,17 @@ extern int outputsize(int,int,int,int);
 extern Type getoutputtype(int);
 extern int getnyear(int);
 #ifdef USE_MPI
-extern int mpi_write(FILE *,void *,MPI_Datatype,int,int *,
-                     int *,int,MPI_Comm);
-extern int mpi_write_txt(FILE *,void *,MPI_Datatype,int,int *,
-                         int *,int,MPI_Comm);
+extern Gatherplan *newgatherplan(int,MPI_Comm);
+extern void *mpi_gather(Gatherplan *,const void *,MPI_Datatype);
+extern void freegatherplan(Gatherplan *);
+extern int mpi_write(FILE *,void *,MPI_Datatype,Gatherplan *);
+extern int mpi_write_txt(FILE *,void *,MPI_Datatype,Gatherplan *);
 #endif
 extern Bool ismonthlyoutput(int);
 
 /* Definition of macros */
 
 #define isopen(output,index) output->files[index].isopen
-#define output_flux(output,flux) writedouble_socket(output->socket,(Real *)&flux,sizeof(Flux)/sizeof(Real))
 #define isdailyoutput(index) (index>=D_LAI && index<=D_PET)
 
 #endif
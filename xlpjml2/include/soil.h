@@ -59,6 +59,9 @@
 #define ORGDENS 1400     /* density of organic soil substances [kg/m3]*/
 #define PRIESTLEY_TAYLOR 1.32 /* Priestley-Taylor coefficient */
 #define SOILDEPTH_IRRIG 500 /*size of layer considered for calculation of irrigation ammount*/
+#define K_SOLID 8     /* thermal conductivity of soil minerals (W/m/K) */
+#define K_ICE 2.2     /* thermal conductivity of ice (W/m/K) */
+#define K_WATER 0.57  /* thermal conductivity of water (W/m/K) */
 
 /* Declaration of variables */
 
@@ -111,6 +114,13 @@ typedef struct
 #endif
 } Litter;
 
+typedef struct
+{
+  Real tree[NFUELCLASS]; /**< above-ground tree litter for each fuel class (gC/m2) */
+  Real grass;            /**< above-ground grass litter (gC/m2) */
+  Real sum_quick;        /**< above-ground litter without 1000h fuel (gC/m2) */
+} Litter_ag;
+
 typedef struct
 {
   Real harvest,residual,residuals_burnt,residuals_burntinfield;
@@ -133,6 +143,7 @@ typedef struct
   Real wpwps[NSOILLAYER]; /**< water at permanent wilting point in mm, depends on soildepth*/
   Real bulkdens[NSOILLAYER]; /**< bulk density of soil [kg/m3]*/
   Real k_dry[NSOILLAYER]; /**< thermal conductivity of dry soil */
+  Real k_sat[NSOILLAYER]; /**< thermal conductivity of saturated unfrozen soil */
   int hsg;        /**< hydrological soil group for CN */
   Real tdiff_0;   /**< thermal diffusivity (mm^2/s) at wilting point (0% whc) */
   Real tdiff_15;  /**< thermal diffusivity (mm^2/s) at 15% whc */
@@ -204,6 +215,7 @@ extern void getlag(Soil *,int);
 extern int getnsoilcode(const Filename *,unsigned int,Bool);
 extern Soilstate getstate(Real *); /*temperature above/below/at T_zero?*/
 extern Bool initsoil(Soil *soil,const Soilpar *, int);
+extern void litter_ag(Litter_ag *,const Litter *);
 extern Real litter_ag_sum(const Litter *);
 extern Real litter_ag_grass(const Litter *);
 extern Real litter_ag_sum_quick(const Litter *);
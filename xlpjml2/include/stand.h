@@ -51,9 +51,16 @@ struct stand
   int prescribe_landcover;
   const Real *landcover;
   void *data;                 /**< stand-specific extensions */
+  int next;                   /**< index of next stand with same land-use type or NOT_FOUND */
 };
 
 typedef List *Standlist;
+
+typedef struct
+{
+  int first[NLANDUSETYPE];    /**< index of first stand of land-use type or NOT_FOUND */
+  int n[NLANDUSETYPE];        /**< number of stands of land-use type */
+} Standindex;
 typedef struct landcover *Landcover;
 
 /* Declaration of functions */
@@ -70,12 +77,14 @@ extern int addstand(const Standtype *,Cell *);
 extern void initstand (Stand *);
 extern void freestand(Stand *);
 extern int delstand(Standlist,int);
+extern void updatestandindex(Cell *);
+extern void setstandtype(Stand *,const Standtype *);
 extern void freestandlist(Standlist);
 extern void mixsoil(Stand *,const Stand *);
-extern Bool check_lu(const Standlist ,Real,int,Bool);
+extern Bool check_lu(const Cell *,Real,int,Bool);
 extern void check_stand_fracs(const Cell *,Real);
-extern int findstand(const Standlist, Landusetype, Bool);
-extern int findlandusetype(const Standlist,Landusetype);
+extern int findstand(const Cell *,Landusetype,Bool);
+extern int findlandusetype(const Cell *,Landusetype);
 extern void allocation_today(Stand *, int);
 extern void light(Stand *,int,const Real[]);
 extern Real establishmentpft(Stand *,const Pftpar[],int,int,Real,int);
@@ -86,7 +95,7 @@ extern Real roughnesslength(const Standlist);
 extern void waterbalance(Stand *,Real [BOTTOMLAYER],Real [BOTTOMLAYER],Real *,Real *,Real,Real,
                          Real,Real *,Bool);
 extern Real infil_perc_irr(Stand *,Real,Real *,Bool);
-extern Real infil_perc_rain(Stand *,Real,Real *,Bool);
+extern Real infil_perc_rain(Stand *,Real,Real *,const Config *);
 extern Real albedo_stand(Stand *);                            
 extern Landcover initlandcover(int,const Config *);
 extern Bool readlandcover(Landcover,const Cell *,int,const Config *);
@@ -97,6 +106,9 @@ extern void freelandcover(Landcover,Bool);
 
 #define getstand(list,index) ((Stand *)getlistitem(list,index))
 #define foreachstand(stand,i,list) for(i=0;i<getlistlen(list) && (stand=getstand(list,i));i++)
+/* loop over all stands of land-use type in order of stand list */
+#define foreachstandoftype(stand,i,cell,type) for(i=(cell)->standindex.first[type];i!=NOT_FOUND && (stand=getstand((cell)->standlist,i));i=stand->next)
+#define nstandoftype(cell,type) (cell)->standindex.n[type]
 #define printstandlist(standlist,pftlist) fprintstandlist(stdout,standlist,pftlist)
 
 /*
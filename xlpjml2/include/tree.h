@@ -49,6 +49,8 @@ typedef struct
   Treephys2 sapl;                   /**< sapling */
   Real sapling_C;		    /**< sapling C per (m2)*/
   Real allom1,allom2,allom3,allom4; /**< allometry */
+  Real allom_k1;                    /**< allom2^(2/allom3)*4/(pi*wooddens), used in allocation */
+  Real allom_exp;                   /**< exponent 1+2/allom3, used in allocation */
   Real aphen_min,aphen_max;
   Real height_max;                  /**< maximum height of tree (m) */
   Real reprod_cost;                 /**< reproduction cost */
@@ -90,6 +92,9 @@ extern void litter_update_tree(Litter *, Pft *,Real);
 extern void litter_update_fire_tree(Litter *, Pft *,Real);
 extern void allometry_tree(Pft *pft);
 extern Bool allocation_tree(Litter *,Pft *,Real *);
+#ifdef CHECK_ALLOCATION
+extern void checkallocation_tree(void);
+#endif
 extern Real lai_tree(const Pft *);
 extern Real actual_lai_tree(const Pft *);
 extern Real turnover_tree(Litter *,Pft *);
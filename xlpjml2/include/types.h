@@ -52,6 +52,12 @@
 
 typedef double Real; /* Default floating point type in LPJ */
 
+#ifdef USE_MIXED_PRECISION
+typedef float Storereal; /* type for climate, output and routing storage */
+#else
+typedef Real Storereal;
+#endif
+
 typedef int Bool; /* type boolean (TRUE/FALSE) */
 
 typedef unsigned char Byte;
@@ -64,6 +70,22 @@ extern char *typenames[];
 typedef enum { LPJ_BYTE, LPJ_SHORT, LPJ_INT, LPJ_FLOAT, LPJ_DOUBLE } Type;
 typedef enum { NO_ERR, ERR, VERB } Verbosity;
 
+/* Subsystems for memory accounting, set by MEMTAG in source files */
+
+typedef enum { MEM_OTHER, MEM_GRID, MEM_STAND, MEM_OUTPUT, MEM_CLIMATE,
+               MEM_STORE, MEM_INPUT, MEM_PNET, MEM_RESERVOIR, NMEMTAG } Memtag;
+
+typedef struct
+{
+	long long count[NMEMTAG]; /* number of allocations */
+	long long live[NMEMTAG];  /* allocated bytes not freed */
+	long long peak[NMEMTAG];  /* maximum of allocated bytes */
+	long long live_total;     /* allocated bytes of all subsystems */
+	long long peak_total;     /* maximum of allocated bytes of all subsystems */
+} Memstat;
+
+extern char *memtagnames[];
+
 typedef struct
 {
 	char *name; /* name of file */
@@ -125,6 +147,7 @@ extern Bool fscansize(LPJfile *, size_t *, const char *, Bool, Verbosity);
 extern Bool fscanuint(LPJfile *, unsigned int *, const char *, Bool, Verbosity);
 extern Bool fscanfloat(LPJfile *, float *, const char *, Bool, Verbosity);
 extern void fprinttime(FILE *, int);
+extern double mrun(void);
 extern Bool readrealvec(FILE *, Real *, Real, Real, size_t, Bool, Type);
 extern Bool readfloatvec(FILE *, float *, float, size_t, Bool, Type);
 extern Bool readintvec(FILE *, int *, size_t, Bool, Type);
@@ -139,6 +162,13 @@ extern char* getfilename(void);
 extern void initscan(const char *);
 extern void fputprintable(FILE *, const char *);
 extern Bool fscaninteof(FILE *, int *, const char *, Bool *, Bool);
+extern Bool getmemstat(Memstat *);
+extern long long getmaxrss(void);
+#ifdef WITH_MEMSTAT
+extern void *lpjmalloc(size_t, Memtag);
+extern void *lpjrealloc(void *, size_t, Memtag);
+extern void lpjfree(void *);
+#endif
 #ifdef WITH_FPE
 extern void enablefpe(void);
 #endif
@@ -156,14 +186,26 @@ extern void enablefpe(void);
 
 #define repeatch(c,count) frepeatch(stdout,c,count)
 #define banner(s,size,w) fbanner(stdout,s,size,w)
+#ifndef MEMTAG
+#define MEMTAG MEM_OTHER /* memory accounting tag of source file */
+#endif
+#ifdef WITH_MEMSTAT
+/* allocations are accounted by subsystem, types.h has to be included after stdlib.h */
+#define newvec(type,size) (type *)lpjmalloc(sizeof(type)*(size),MEMTAG)
+#define newvec2(type,lo,hi) (type *)lpjmalloc(sizeof(type)*(hi-(lo)+1),MEMTAG)-(lo)
+#define new(type) (type *)lpjmalloc(sizeof(type),MEMTAG)
+#define free(ptr) lpjfree(ptr)
+#define realloc(ptr,size) lpjrealloc(ptr,size,MEMTAG)
+#else
 #define newvec(type,size) (type *)malloc(sizeof(type)*(size))
 #define newvec2(type,lo,hi) (type *)malloc(sizeof(type)*(hi-(lo)+1))-(lo)
+#define new(type) (type *)malloc(sizeof(type))
+#endif
 #define newmatrix(type,ysize,xsize) (type **)newmat(sizeof(type),ysize,xsize)
 #define freevec(ptr,lo,hi) free(ptr+lo)
 #define check(ptr) if((ptr)==NULL) fail(ALLOC_MEMORY_ERR,FALSE,"Cannot allocate memory for '%s' in %s()",#ptr,__FUNCTION__)
 #define printintf(i) fprintintf(stdout,i)
 
-#define new(type) (type *)malloc(sizeof(type))
 #ifndef min         /* min macro defined? */
 #define min(a,b) (((a)<(b)) ?  (a) : (b))
 #endif
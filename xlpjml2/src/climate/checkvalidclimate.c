@@ -15,6 +15,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_CLIMATE
+
 #include "lpj.h"
 
 static Bool checkvalid(Climatefile *climate, /**< climate data file */
@@ -22,9 +22,20 @@ void closeclimatefile(Climatefile *file, /**< pointer to climate data file */
 {
   if(file->fmt!=FMS)
   {
+    free(file->vec);
     if(file->fmt==CDF)
       closeclimate_netcdf(file,isroot);
     else
+    {
       fclose(file->file);
+      free(file->buffer);
+      free(file->filename);
+      freechunkheader(file->chunk);
+#ifdef USE_MPI
+      free(file->counts);
+      free(file->offsets);
+      free(file->range);
+#endif
+    }
   }
 } /* of 'closeclimatefile' */
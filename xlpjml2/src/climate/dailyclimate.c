@@ -38,7 +38,7 @@ void dailyclimate(Dailyclimate *daily,    /**< */
       climbuf->mtemp+=daily->temp;
     }
     else
-      daily->temp=interpolate(getcelltemp(climate,cell),month,dayofmonth);
+      daily->temp=interpolatestore(getcelltemp(climate,cell),month,dayofmonth);
   }
   else
   {
@@ -47,30 +47,30 @@ void dailyclimate(Dailyclimate *daily,    /**< */
   }
   if(climate->data.sun!=NULL)
     daily->sun=isdaily(climate->file_cloud) ? climate->data.sun[cell*NDAYYEAR+day-1]
-                      : interpolate(getcellsun(climate,cell),month,dayofmonth);
+                      : interpolatestore(getcellsun(climate,cell),month,dayofmonth);
   if(climate->data.lwnet!=NULL)
     daily->lwnet=isdaily(climate->file_lwnet) ? climate->data.lwnet[cell*NDAYYEAR+day-1]
-                      : interpolate(getcelllwnet(climate,cell),month,dayofmonth);
+                      : interpolatestore(getcelllwnet(climate,cell),month,dayofmonth);
   if(climate->data.swdown!=NULL)
     daily->swdown=isdaily(climate->file_swdown) ? climate->data.swdown[cell*NDAYYEAR+day-1]
-                      : interpolate(getcellswdown(climate,cell),month,dayofmonth);
+                      : interpolatestore(getcellswdown(climate,cell),month,dayofmonth);
   if(climate->data.wind!=NULL)
   {
     if(isdaily(climate->file_wind))
       daily->windspeed=climate->data.wind[cell*NDAYYEAR+day-1];
     else
-      daily->windspeed=interpolate(getcellwind(climate,cell),month,dayofmonth);
+      daily->windspeed=interpolatestore(getcellwind(climate,cell),month,dayofmonth);
   }
   if(climate->data.tamp!=NULL)
   {
     if(climate->data.tmax!=NULL)
     {
-      daily->tmin=isdaily(climate->file_tamp) ?  climate->data.tamp[cell*NDAYYEAR+day-1] : interpolate(getcelltamp(climate,cell),month,dayofmonth);
-      daily->tmax=isdaily(climate->file_tmax) ?  climate->data.tmax[cell*NDAYYEAR+day-1] : interpolate(getcelltmax(climate,cell),month,dayofmonth);
+      daily->tmin=isdaily(climate->file_tamp) ?  climate->data.tamp[cell*NDAYYEAR+day-1] : interpolatestore(getcelltamp(climate,cell),month,dayofmonth);
+      daily->tmax=isdaily(climate->file_tmax) ?  climate->data.tmax[cell*NDAYYEAR+day-1] : interpolatestore(getcelltmax(climate,cell),month,dayofmonth);
     }
     else
     {
-      tamp=isdaily(climate->file_tamp) ?  climate->data.tamp[cell*NDAYYEAR+day-1] : interpolate(getcelltamp(climate,cell),month,dayofmonth);
+      tamp=isdaily(climate->file_tamp) ?  climate->data.tamp[cell*NDAYYEAR+day-1] : interpolatestore(getcelltamp(climate,cell),month,dayofmonth);
       daily->tmin=daily->temp-tamp*0.5;
       daily->tmax=daily->temp+tamp*0.5;
     }
@@ -80,7 +80,7 @@ void dailyclimate(Dailyclimate *daily,    /**< */
     if(isdaily(climate->file_lightning))
       daily->lightning=climate->data.lightning[cell*NDAYYEAR+day-1];
     else
-      daily->lightning=interpolate(getcelllightning(climate,cell),month,dayofmonth)*ndaymonth1[month];
+      daily->lightning=interpolatestore(getcelllightning(climate,cell),month,dayofmonth)*ndaymonth1[month];
   }
   if(climate->file_prec.fmt!=FMS)
   {
@@ -92,7 +92,7 @@ void dailyclimate(Dailyclimate *daily,    /**< */
     else
     {
       daily->prec=(israndomprec(climate)) ? climbuf->dval_prec[dayofmonth+1] :
-          interpolate(getcellprec(climate,cell),month,dayofmonth)*
+          interpolatestore(getcellprec(climate,cell),month,dayofmonth)*
                         ndaymonth1[month];
       daily->prec=(daily->prec>0.000001) ? daily->prec : 0.0;
     }
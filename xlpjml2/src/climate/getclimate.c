@@ -17,10 +17,12 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_CLIMATE
+
 #include "lpj.h"
 
 Bool readclimate(Climatefile *file,   /**< climate data file */
-                 Real data[],         /**< climate data read */
+                 Storereal data[],    /**< climate data read */
                  Real intercept,      /**< offset for data */
                  Real slope,          /**< scale factor for data*/
                  const Cell grid[],   /**< LPJ grid */
@@ -30,6 +32,10 @@ Bool readclimate(Climatefile *file,   /**< climate data file */
 {
   int rc;
   long long index;
+  Real *vec;
+#ifdef USE_MIXED_PRECISION
+  int i;
+#endif
   if(file->fmt==FMS)
     return FALSE;
   index=year-file->firstyear;
@@ -39,16 +45,28 @@ Bool readclimate(Climatefile *file,   /**< climate data file */
       fprintf(stderr,"ERROR130: Invalid year %d in readclimate().\n",year);
     return TRUE;
   }
+  if(file->fmt!=CDF && (file->nbuffer>1 || file->chunk!=NULL))
+    return iserror(readclimatebuffer(file,data,intercept,slope,index,config),config);
+#ifdef USE_MIXED_PRECISION
+  /* data are read in double precision into buffer allocated by initclimate() */
+  vec=file->vec;
+#else
+  vec=data;
+#endif
   if(file->fmt==CDF)
-    rc=readclimate_netcdf(file,data,grid,index,config);
+    rc=readclimate_netcdf(file,vec,grid,index,config);
   else
   {
     if(fseek(file->file,index*file->size+file->offset,SEEK_SET))
       rc=TRUE;
     else
-      rc=readrealvec(file->file,data,intercept,slope,file->n,file->swap,
+      rc=readrealvec(file->file,vec,intercept,slope,file->n,file->swap,
                      file->datatype);
   }
+#ifdef USE_MIXED_PRECISION
+  for(i=0;i<file->n;i++)
+    data[i]=(Storereal)vec[i];
+#endif
   return iserror(rc,config);
 } /* of'readclimate' */
 
@@ -58,7 +76,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
                 const Config *config /**< LPJ configuration */
                )                     /** \return TRUE on error */
 {
-  Real *wet;
+  Storereal *wet;
   int i,index;
   Bool rc;
   if(readclimate(&climate->file_temp,climate->data.temp,0,climate->file_temp.scalar,grid,year,config))
@@ -171,7 +189,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
     else if(!climate->file_wet.ready)
     {
       climate->file_wet.ready=TRUE;
-      wet=newvec(Real,climate->file_wet.n);
+      wet=newvec(Storereal,climate->file_wet.n);
       if(wet==NULL)
       {
         printallocerr("wet");
@@ -16,13 +16,31 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_CLIMATE
+
 #include "lpj.h"
 
+#ifdef USE_MIXED_PRECISION
+static Bool newconvvec(Climatefile *file,const Storereal *data)
+{
+  /* buffer is not needed for unused files and files read by readclimatebuffer() */
+  if(data==NULL || file->fmt==FMS ||
+     (file->fmt!=CDF && (file->nbuffer>1 || file->chunk!=NULL)))
+    return FALSE;
+  file->vec=newvec(Real,file->n);
+  return file->vec==NULL;
+} /* of 'newconvvec' */
+#endif
+
 Climate *initclimate(const Cell grid[],   /**< LPJ grid */
                      const Config *config /**< pointer to LPJ configuration */
                     )                     /** \return allocated climate data struct or NULL on error */
 {
   Climate *climate;
+  Real *lightning;
+#ifdef USE_MIXED_PRECISION
+  int i;
+#endif
   climate=new(Climate);
   if(climate==NULL)
   {
@@ -316,7 +334,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     climate->data.prec=NULL;
   else
   {
-    if((climate->data.prec=newvec(Real,climate->file_prec.n))==NULL)
+    if((climate->data.prec=newvec(Storereal,climate->file_prec.n))==NULL)
     {
       printallocerr("prec");
       free(climate->co2.data);
@@ -328,7 +346,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     climate->data.temp=NULL;
   else
   {
-    if((climate->data.temp=newvec(Real,climate->file_temp.n))==NULL)
+    if((climate->data.temp=newvec(Storereal,climate->file_temp.n))==NULL)
     {
       printallocerr("temp");
       free(climate->co2.data);
@@ -343,7 +361,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       climate->data.wind=NULL;
     else
     {
-      if((climate->data.wind=newvec(Real,climate->file_wind.n))==NULL)
+      if((climate->data.wind=newvec(Storereal,climate->file_wind.n))==NULL)
       {
         printallocerr("wind");
         free(climate->co2.data);
@@ -357,7 +375,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       climate->data.tamp=NULL;
     else
     {
-      if((climate->data.tamp=newvec(Real,climate->file_tamp.n))==NULL)
+      if((climate->data.tamp=newvec(Storereal,climate->file_tamp.n))==NULL)
       {
         printallocerr("tamp");
         free(climate->co2.data);
@@ -370,7 +388,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     }
     if(config->tmax_filename.name!=NULL)
     {
-      if((climate->data.tmax=newvec(Real,climate->file_tmax.n))==NULL)
+      if((climate->data.tmax=newvec(Storereal,climate->file_tmax.n))==NULL)
       {
         printallocerr("tmax");
         free(climate->co2.data);
@@ -384,7 +402,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     }
     else
       climate->data.tmax=NULL;
-    if((climate->data.lightning=newvec(Real,climate->file_lightning.n))==NULL)
+    if((climate->data.lightning=newvec(Storereal,climate->file_lightning.n))==NULL)
     {
       printallocerr("lightning");
       free(climate->co2.data);
@@ -397,11 +415,35 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     }
     if(climate->file_lightning.fmt!=CDF && climate->file_lightning.version<=1)
       climate->file_lightning.scalar=1e-7;
+#ifdef USE_MIXED_PRECISION
+    /* lightning is read in double precision and stored as float */
+    if((lightning=newvec(Real,climate->file_lightning.n))==NULL)
+    {
+      printallocerr("lightning");
+      return NULL;
+    }
+#else
+    lightning=climate->data.lightning;
+#endif
     if(climate->file_lightning.fmt==CDF)
     {
-     if(readclimate_netcdf(&climate->file_lightning,climate->data.lightning,grid,0,config))
+     if(readclimate_netcdf(&climate->file_lightning,lightning,grid,0,config))
        return NULL;
     }
+    else if(climate->file_lightning.chunk!=NULL)
+    {
+      if(readclimatebuffer(&climate->file_lightning,climate->data.lightning,0,climate->file_lightning.scalar,0,config))
+      {
+        fputs("ERROR192: Cannot read lightning in initclimate().\n",stderr);
+        closeclimatefile(&climate->file_lightning,isroot(*config));
+        return NULL;
+      }
+      closeclimatefile(&climate->file_lightning,isroot(*config));
+#ifdef USE_MIXED_PRECISION
+      for(i=0;i<climate->file_lightning.n;i++)
+        lightning[i]=climate->data.lightning[i];
+#endif
+    }
     else
     {
       if(fseek(climate->file_lightning.file,climate->file_lightning.offset,SEEK_SET))
@@ -410,7 +452,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
         closeclimatefile(&climate->file_lightning,isroot(*config));
         return NULL;
       }
-      if(readrealvec(climate->file_lightning.file,climate->data.lightning,0,climate->file_lightning.scalar,climate->file_lightning.n,climate->file_lightning.swap,climate->file_lightning.datatype))
+      if(readrealvec(climate->file_lightning.file,lightning,0,climate->file_lightning.scalar,climate->file_lightning.n,climate->file_lightning.swap,climate->file_lightning.datatype))
       {
         fputs("ERROR192: Cannot read lightning in initclimate().\n",stderr);
         closeclimatefile(&climate->file_lightning,isroot(*config));
@@ -418,6 +460,11 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       }
       closeclimatefile(&climate->file_lightning,isroot(*config));
     }
+#ifdef USE_MIXED_PRECISION
+    for(i=0;i<climate->file_lightning.n;i++)
+      climate->data.lightning[i]=(Storereal)lightning[i];
+    free(lightning);
+#endif
   }
   else
     climate->data.wind=climate->data.tamp=climate->data.lightning=climate->data.tmax=NULL;
@@ -429,7 +476,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
         climate->data.lwnet=NULL;
       else
       {
-        if((climate->data.lwnet=newvec(Real,climate->file_lwnet.n))==NULL)
+        if((climate->data.lwnet=newvec(Storereal,climate->file_lwnet.n))==NULL)
         {
           printallocerr("lwnet");
           free(climate->co2.data);
@@ -452,7 +499,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       climate->data.swdown=NULL;
     else
     {
-      if((climate->data.swdown=newvec(Real,climate->file_swdown.n))==NULL)
+      if((climate->data.swdown=newvec(Storereal,climate->file_swdown.n))==NULL)
       {
         printallocerr("swdown");
         free(climate->co2.data);
@@ -476,7 +523,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       climate->data.sun=NULL;
     else
     {
-      if((climate->data.sun=newvec(Real,climate->file_cloud.n))==NULL)
+      if((climate->data.sun=newvec(Storereal,climate->file_cloud.n))==NULL)
       {
         printallocerr("cloud");
         free(climate->co2.data);
@@ -499,7 +546,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
       climate->data.wet=NULL;
     else
     {
-      if((climate->data.wet=newvec(Real,climate->file_wet.n))==NULL)
+      if((climate->data.wet=newvec(Storereal,climate->file_wet.n))==NULL)
       {
         printallocerr("wet");
         free(climate->co2.data);
@@ -525,7 +572,7 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
   }
   if(config->prescribe_burntarea)
   {
-    if((climate->data.burntarea=newvec(Real,climate->file_burntarea.n))==NULL)
+    if((climate->data.burntarea=newvec(Storereal,climate->file_burntarea.n))==NULL)
     {
       printallocerr("burntarea");
       free(climate->co2.data);
@@ -551,5 +598,29 @@ Climate *initclimate(const Cell grid[],   /**< LPJ grid */
     }
   }
 
+#ifdef USE_MIXED_PRECISION
+  /* data are read in double precision, conversion buffers are allocated once */
+  if(newconvvec(&climate->file_temp,climate->data.temp) ||
+     newconvvec(&climate->file_prec,climate->data.prec) ||
+     newconvvec(&climate->file_tmax,climate->data.tmax) ||
+     newconvvec(&climate->file_cloud,climate->data.sun) ||
+     newconvvec(&climate->file_lwnet,climate->data.lwnet) ||
+     newconvvec(&climate->file_swdown,climate->data.swdown) ||
+     newconvvec(&climate->file_wind,climate->data.wind) ||
+     newconvvec(&climate->file_tamp,climate->data.tamp) ||
+     newconvvec(&climate->file_wet,climate->data.wet) ||
+     newconvvec(&climate->file_burntarea,climate->data.burntarea)
+#ifdef IMAGE
+     || (config->sim_id==LPJML_IMAGE &&
+         (newconvvec(&climate->file_temp_var,climate->data.temp) ||
+          newconvvec(&climate->file_prec_var,climate->data.prec)))
+#endif
+    )
+  {
+    printallocerr("vec");
+    freeclimate(climate,isroot(*config));
+    return NULL;
+  }
+#endif
   return climate;
 } /* of 'initclimate' */
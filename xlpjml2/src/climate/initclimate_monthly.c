@@ -17,12 +17,13 @@
 void initclimate_monthly(const Climate *climate, /**< Pointer to climate data */
                          Climbuf *climbuf,       /**< pointer to climate buffer */
                          int cell,               /**< cell index */
-                         int month               /**< month (0..11) */
+                         int month,              /**< month (0..11) */
+                         Randstream *rnd         /**< random stream of cell and month */
                         )                        /** \return void */
 {
   if(!isdaily(climate->file_prec) && israndomprec(climate))
     prdaily(climbuf->dval_prec,ndaymonth[month],
             (getcellprec(climate,cell))[month],
-            (getcellwet(climate,cell))[month]);
+            (getcellwet(climate,cell))[month],rnd);
   climbuf->mtemp=climbuf->mprec=0;
 } /* of 'initclimate_monthly' */
@@ -29,6 +29,12 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
   char *s;
   size_t offset;
   file->fmt=filename->fmt;
+  file->chunk=NULL;
+  file->vec=NULL;
+#ifdef USE_MPI
+  file->counts=file->offsets=NULL;
+  file->range=NULL;
+#endif
   if(filename->fmt==FMS)
   {
     file->time_step=DAY;
@@ -98,10 +104,10 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
       return FALSE;
     }
   }
-  if((file->file=openinputfile(&header,&file->swap,
-                               filename,
-                               headername,
-                               &version,&offset,config))==NULL)
+  if((file->file=openinputfile2(&header,&file->swap,
+                                filename,
+                                headername,
+                                &version,&offset,&file->chunk,config))==NULL)
     return TRUE;
   if (header.order==YEARCELL)
   {
@@ -109,6 +115,7 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
       fprintf(stderr,"ERROR127: Order YEARCELL in '%s' is not supported in this LPJ-Version.\n"
               "Please reorganize your input data!\n",filename->name);
     fclose(file->file);
+    freechunkheader(file->chunk);
     return TRUE;
   }
   if(filename->fmt!=RAW && header.nbands!=NMONTH && header.nbands!=NDAYYEAR)
@@ -117,6 +124,7 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
       fprintf(stderr,"ERROR127: Invalid number of bands %d in '%s'.\n",
               header.nbands,filename->name);
     fclose(file->file);
+    freechunkheader(file->chunk);
     return TRUE;
   }
   file->version=version;
@@ -135,8 +143,28 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
   else
     file->offset=(config->startgrid-header.firstcell)*header.nbands*
                  typesizes[file->datatype]+headersize(headername,version)+offset;
+  if(file->chunk!=NULL)
+  {
+    /* chunks are read for the cells of this task, offset is index of first cell */
+    file->offset=config->startgrid-header.firstcell;
+    file->nbuffer=file->chunk->nyear;
+  }
   file->time_step=(header.nbands==NDAYYEAR) ? DAY : MONTH;
   file->size=header.ncell*header.nbands*typesizes[file->datatype];
   file->n=header.nbands*config->ngridcell;
+  /* read-ahead buffer is allocated at first read */
+  if(file->chunk==NULL)
+    file->nbuffer=config->climate_buffer;
+  file->buffer=NULL;
+  file->buffer_index=file->buffer_nyear=0;
+  /* filename is kept for error messages */
+  file->filename=strdup(filename->name);
+  if(file->filename==NULL)
+  {
+    printallocerr("filename");
+    fclose(file->file);
+    freechunkheader(file->chunk);
+    return TRUE;
+  }
   return FALSE;
 } /* of 'openclimate' */
@@ -27,10 +27,12 @@
 void prdaily(Real dval_prec[],  /**< Daily precipitation array (mm)  */
              int ndaymonth,     /**< number of days in month */
              Real mval,         /**< total rainfall (mm) for month */
-             Real mval_wet      /**< expected number of rain days for month */
+             Real mval_wet,     /**< expected number of rain days for month */
+             Randstream *rnd    /**< random stream of cell and month */
              )                  /** \return void */
 {
   int d;
+  Real r[4];
   Real prob_rain; /** daily probability of rain for this month */
   Real mprec;     /** average rainfall per rain day for this month */
   Real mprec_sum; /** cumulative sum of rainfall for this month */
@@ -61,6 +63,9 @@ void prdaily(Real dval_prec[],  /**< Daily precipitation array (mm)  */
 #endif
       for (d=1;d<=ndaymonth;d++) 
       {
+        /* random numbers only depend on cell, date and iteration */
+        rnd->ctr[2]=d;
+        randstream(r,rnd);
 
         /**
         * ----------Transitional probabilities (Geng et al 1986)--------
@@ -74,16 +79,17 @@ void prdaily(Real dval_prec[],  /**< Daily precipitation array (mm)  */
         * parameter values (c1,c2) for an exponential distribution---------
         **/
 
-        if (drand48()>prob) 
+        if (r[0]>prob) 
           dval_prec[d]=0.0;
         else 
         {
-          dval_prec[d]=pow(-log(drand48()),c2)*mprec*c1;
+          dval_prec[d]=pow(-log(r[1]),c2)*mprec*c1;
           if (dval_prec[d]<0.1) 
             dval_prec[d]=0.0;
           mprec_sum+=dval_prec[d];
         }
       } /** of 'for(d=1;...)' */
+      rnd->ctr[3]++;
     } 
 
     /**
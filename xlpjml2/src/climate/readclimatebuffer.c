@@ -0,0 +1,240 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**            r  e  a  d  c  l  i  m  a  t  e  b  u  f  f  e  r  .  c             \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads climate data for a specified year from read-ahead           \n**/
+/**     buffer. Several consecutive years of the cell range of the task are        \n**/
+/**     read at once into the buffer in order to reduce the number of file         \n**/
+/**     accesses in the transient phase. Buffer holds only the cells of the        \n**/
+/**     task. In parallel runs the root task reads the cells of all tasks          \n**/
+/**     once per year and scatters them. Data are converted to Real when           \n**/
+/**     requested.                                                                 \n**/
+/**     For files in chunked format the year block of a chunk is                   \n**/
+/**     decompressed for the cells of the task.                                    \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static void convertrealvec(Storereal data[], /**< array of reals */
+                           const void *vec,  /**< raw data of file */
+                           Real intercept,   /**< intercept for rescaling data */
+                           Real slope,       /**< slope for rescaling data */
+                           size_t n,         /**< size of real array */
+                           Bool swap,        /**< byte order has to be swapped (TRUE/FALSE) */
+                           Type type         /**< type of data in file */
+                          )
+{
+  size_t i;
+  switch(type)
+  {
+    case LPJ_BYTE:
+      for(i=0;i<n;i++)
+        data[i]=intercept+((const Byte *)vec)[i]*slope;
+      break;
+    case LPJ_SHORT:
+      if(swap)
+        for(i=0;i<n;i++)
+          data[i]=intercept+swapshort(((const short *)vec)[i])*slope;
+      else
+        for(i=0;i<n;i++)
+          data[i]=intercept+((const short *)vec)[i]*slope;
+      break;
+    case LPJ_INT:
+      if(swap)
+        for(i=0;i<n;i++)
+          data[i]=intercept+swapint(((const int *)vec)[i])*slope;
+      else
+        for(i=0;i<n;i++)
+          data[i]=intercept+((const int *)vec)[i]*slope;
+      break;
+    case LPJ_FLOAT:
+      if(swap)
+        for(i=0;i<n;i++)
+          data[i]=intercept+swapfloat(((const int *)vec)[i])*slope;
+      else
+        for(i=0;i<n;i++)
+          data[i]=intercept+((const float *)vec)[i]*slope;
+      break;
+    case LPJ_DOUBLE:
+      if(swap)
+        for(i=0;i<n;i++)
+          data[i]=intercept+swapdouble(((const Num *)vec)[i])*slope;
+      else
+        for(i=0;i<n;i++)
+          data[i]=intercept+((const double *)vec)[i]*slope;
+      break;
+  } /* of switch */
+} /* of 'convertrealvec' */
+
+static Bool readyears(Climatefile *file, /**< climate data file */
+                      char *buffer,      /**< data read */
+                      long long size,    /**< bytes read per year */
+                      int index,         /**< index of first year in file */
+                      int nyear          /**< number of years */
+                     )                   /** \return TRUE on error */
+{
+  int year;
+  if(size==file->size)
+  {
+    /* all cells are read, years are contiguous in file */
+    if(fseek(file->file,index*file->size+file->offset,SEEK_SET))
+    {
+      fprintf(stderr,"ERROR267: Cannot seek to year %d in '%s'.\n",
+              file->firstyear+index,file->filename);
+      return TRUE;
+    }
+    if(fread(buffer,size,nyear,file->file)!=(size_t)nyear)
+    {
+      if(nyear==1)
+        fprintf(stderr,"ERROR267: Cannot read year %d in '%s'.\n",
+                file->firstyear+index,file->filename);
+      else
+        fprintf(stderr,"ERROR267: Cannot read years %d-%d in '%s'.\n",
+                file->firstyear+index,file->firstyear+index+nyear-1,file->filename);
+      return TRUE;
+    }
+    return FALSE;
+  }
+  for(year=0;year<nyear;year++)
+  {
+    if(fseek(file->file,(index+year)*file->size+file->offset,SEEK_SET))
+    {
+      fprintf(stderr,"ERROR267: Cannot seek to year %d in '%s'.\n",
+              file->firstyear+index+year,file->filename);
+      return TRUE;
+    }
+    if(fread(buffer+year*size,1,size,file->file)!=(size_t)size)
+    {
+      fprintf(stderr,"ERROR267: Cannot read year %d in '%s'.\n",
+              file->firstyear+index+year,file->filename);
+      return TRUE;
+    }
+  }
+  return FALSE;
+} /* of 'readyears' */
+
+#ifdef USE_MPI
+static Bool mpi_readyears(Climatefile *file,  /**< climate data file */
+                          long long size,     /**< bytes of task per year */
+                          int index,          /**< index of first year in file */
+                          int nyear,          /**< number of years */
+                          const Config *config /**< LPJmL configuration */
+                         )                    /** \return TRUE on error */
+{
+  /* root task reads cell range of all tasks once per year and scatters it */
+  int year,task,count;
+  Bool rc;
+  if(file->counts==NULL)
+  {
+    file->counts=newvec(int,config->ntask);
+    check(file->counts);
+    file->offsets=newvec(int,config->ntask);
+    check(file->offsets);
+    count=(int)size;
+    MPI_Allgather(&count,1,MPI_INT,file->counts,1,MPI_INT,config->comm);
+    file->offsets[0]=0;
+    for(task=1;task<config->ntask;task++)
+      file->offsets[task]=file->offsets[task-1]+file->counts[task-1];
+    if(isroot(*config))
+    {
+      file->range=malloc(file->offsets[config->ntask-1]+file->counts[config->ntask-1]);
+      check(file->range);
+    }
+  }
+  for(year=0;year<nyear;year++)
+  {
+    /* cells of root task are first in range of all tasks */
+    rc=(isroot(*config)) ? readyears(file,file->range,
+                                     file->offsets[config->ntask-1]+
+                                     file->counts[config->ntask-1],
+                                     index+year,1) : FALSE;
+    MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+    if(rc)
+      return TRUE;
+    MPI_Scatterv(file->range,file->counts,file->offsets,MPI_BYTE,
+                 file->buffer+year*size,(int)size,MPI_BYTE,0,config->comm);
+  }
+  return FALSE;
+} /* of 'mpi_readyears' */
+#endif
+
+Bool readclimatebuffer(Climatefile *file,   /**< climate data file */
+                       Storereal data[],    /**< climate data read */
+                       Real intercept,      /**< offset for data */
+                       Real slope,          /**< scale factor for data*/
+                       int index,           /**< year index in file */
+                       const Config *config /**< LPJmL configuration */
+                      )                     /** \return TRUE on error */
+{
+  long long size;
+  int nyear;
+  Bool rc;
+  if(file->chunk!=NULL)
+  {
+    if(index<file->buffer_index || index>=file->buffer_index+file->buffer_nyear)
+    {
+      /* year not in buffer, decompress chunks of year block for cells of task */
+      if(file->buffer==NULL)
+      {
+        file->buffer=malloc((size_t)file->chunk->nyear*file->n*typesizes[file->datatype]);
+        if(file->buffer==NULL)
+        {
+          printallocerr("buffer");
+          return TRUE;
+        }
+      }
+      file->buffer_nyear=0;
+      if(readchunks(file->file,file->chunk,file->swap,file->buffer,
+                    index/file->chunk->nyear,(int)file->offset,
+                    file->n/file->chunk->header.nbands))
+        return TRUE;
+      file->buffer_index=index/file->chunk->nyear*file->chunk->nyear;
+      file->buffer_nyear=min(file->chunk->nyear,file->nyear-file->buffer_index);
+    }
+    /* chunks are already converted into native byte order */
+    convertrealvec(data,
+                   file->buffer+(size_t)(index-file->buffer_index)*file->n*typesizes[file->datatype],
+                   intercept,slope,file->n,FALSE,file->datatype);
+    return FALSE;
+  }
+  if(index<file->buffer_index || index>=file->buffer_index+file->buffer_nyear)
+  {
+    /* year not in buffer, read next years at once */
+    nyear=min(file->nbuffer,file->nyear-index);
+    size=(long long)file->n*typesizes[file->datatype];
+    if(file->buffer==NULL)
+    {
+      /* allocate buffer for the cells of task and the maximum number of years */
+      file->buffer=malloc((size_t)file->nbuffer*size);
+      if(file->buffer==NULL)
+      {
+        printallocerr("buffer");
+        return TRUE;
+      }
+    }
+    file->buffer_nyear=0;
+#ifdef USE_MPI
+    if(config->ntask>1)
+      rc=mpi_readyears(file,size,index,nyear,config);
+    else
+#endif
+      rc=readyears(file,file->buffer,size,index,nyear);
+    if(rc)
+      return TRUE;
+    file->buffer_index=index;
+    file->buffer_nyear=nyear;
+  }
+  convertrealvec(data,
+                 file->buffer+(size_t)(index-file->buffer_index)*file->n*typesizes[file->datatype],
+                 intercept,slope,file->n,file->swap,file->datatype);
+  return FALSE;
+} /* of 'readclimatebuffer' */
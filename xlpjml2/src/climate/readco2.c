@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_CLIMATE
+
 #include "lpj.h"
 
 Bool readco2(Co2data *co2,             /**< pointer to co2 data */
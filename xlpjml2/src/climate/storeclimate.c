@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STORE
+
 #include "lpj.h"
 
 #define checkptr(ptr) if(ptr==NULL) {printallocerr(#ptr); return TRUE; }
@@ -29,69 +31,69 @@ Bool storeclimate(Climatedata *store,  /**< pointer to climate data to be stored
   /**
   * allocate arrays for climate storage
   **/
-  store->temp=newvec(Real,climate->file_temp.n*nyear);
+  store->temp=newvec(Storereal,climate->file_temp.n*nyear);
   checkptr(store->temp);
-  store->prec=newvec(Real,climate->file_prec.n*nyear);
+  store->prec=newvec(Storereal,climate->file_prec.n*nyear);
   checkptr(store->prec);
   if(climate->data.tmax!=NULL)
   {
-    store->tmax=newvec(Real,climate->file_tmax.n*nyear);
+    store->tmax=newvec(Storereal,climate->file_tmax.n*nyear);
     checkptr(store->tmax);
   }
   else
     store->tmax=NULL;
   if(climate->data.sun!=NULL)
   {
-    store->sun=newvec(Real,climate->file_cloud.n*nyear);
+    store->sun=newvec(Storereal,climate->file_cloud.n*nyear);
     checkptr(store->sun);
   }
   else
     store->sun=NULL;
   if(climate->data.lwnet!=NULL)
   {
-    store->lwnet=newvec(Real,climate->file_lwnet.n*nyear);
+    store->lwnet=newvec(Storereal,climate->file_lwnet.n*nyear);
     checkptr(store->lwnet);
   }
   else
     store->lwnet=NULL;
   if(climate->data.swdown!=NULL)
   {
-    store->swdown=newvec(Real,climate->file_swdown.n*nyear);
+    store->swdown=newvec(Storereal,climate->file_swdown.n*nyear);
     checkptr(store->swdown);
   }
   else
     store->swdown=NULL;
   if(climate->data.wet!=NULL)
   {
-    store->wet=newvec(Real,climate->file_wet.n*nyear);
+    store->wet=newvec(Storereal,climate->file_wet.n*nyear);
     checkptr(store->wet);
   }
   else
     store->wet=NULL;
   if(climate->data.wind!=NULL)
   {
-    store->wind=newvec(Real,climate->file_wind.n*nyear);
+    store->wind=newvec(Storereal,climate->file_wind.n*nyear);
     checkptr(store->wind);
   }
   else
     store->wind=NULL;
   if(climate->data.tamp!=NULL)
   {
-    store->tamp=newvec(Real,climate->file_tamp.n*nyear);
+    store->tamp=newvec(Storereal,climate->file_tamp.n*nyear);
     checkptr(store->tamp);
   }
   else
     store->tamp=NULL;
   if(climate->data.burntarea!=NULL)
   {
-    store->burntarea=newvec(Real,climate->file_burntarea.n*nyear);
+    store->burntarea=newvec(Storereal,climate->file_burntarea.n*nyear);
     checkptr(store->burntarea);
   }
   else
     store->burntarea=NULL;
   if(climate->data.lightning!=NULL)
   {
-    store->lightning=newvec(Real,climate->file_lightning.n);
+    store->lightning=newvec(Storereal,climate->file_lightning.n);
     checkptr(store->lightning);
     for(j=0;j<climate->file_lightning.n;j++)
       store->lightning[j]=climate->data.lightning[j];
@@ -247,3 +249,30 @@ void moveclimate(Climate *climate,  /**< Pointer to climate data */
   if(climate->data.burntarea!=NULL)
     climate->data.burntarea=store->burntarea+climate->file_burntarea.n*year;
 } /* of 'moveclimate' */
+
+long long storeclimatesize(const Climate *climate, /**< climate data */
+                           int nyear               /**< number of years stored */
+                          )                        /** \return size of climate storage (bytes) */
+{
+  long long n;
+  n=(long long)(climate->file_temp.n+climate->file_prec.n)*nyear;
+  if(climate->data.tmax!=NULL)
+    n+=(long long)climate->file_tmax.n*nyear;
+  if(climate->data.sun!=NULL)
+    n+=(long long)climate->file_cloud.n*nyear;
+  if(climate->data.lwnet!=NULL)
+    n+=(long long)climate->file_lwnet.n*nyear;
+  if(climate->data.swdown!=NULL)
+    n+=(long long)climate->file_swdown.n*nyear;
+  if(climate->data.wet!=NULL)
+    n+=(long long)climate->file_wet.n*nyear;
+  if(climate->data.wind!=NULL)
+    n+=(long long)climate->file_wind.n*nyear;
+  if(climate->data.tamp!=NULL)
+    n+=(long long)climate->file_tamp.n*nyear;
+  if(climate->data.burntarea!=NULL)
+    n+=(long long)climate->file_burntarea.n*nyear;
+  if(climate->data.lightning!=NULL)
+    n+=climate->file_lightning.n;
+  return n*sizeof(Storereal);
+} /* of 'storeclimatesize' */
@@ -37,6 +37,9 @@ void calc_cropdates(const Pftpar par[],     /**< PFT parameter array for crops *
   int cft,adjust_date;
   const Pftcroppar *croppar;
 
+  /* threshold can only be crossed upwards if temperature increases */
+  if(!(climbuf->temp[NDAYS-1]>climbuf->temp[NDAYS-2]))
+    return;
   for(cft=0;cft<ncft;cft++)
   {
 
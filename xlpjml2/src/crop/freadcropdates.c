@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 
 Cropdates *freadcropdates(FILE *file, /**< Pointer to binary file */
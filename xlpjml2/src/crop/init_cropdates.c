@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 
 Cropdates *init_cropdates(const Pftpar par[], /**< CFT parameter array */
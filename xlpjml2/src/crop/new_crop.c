@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STAND
+
 #include "lpj.h"
 #include "crop.h"
 
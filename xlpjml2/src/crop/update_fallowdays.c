@@ -22,16 +22,16 @@ void update_fallowdays(Cropdates *cropdates, /**< crop dates */
 {
   int cft;
   
-  for(cft=0;cft<ncft;cft++)
-  {
-
-    cropdates[cft].fallow--;
-    cropdates[cft].fallow_irrig--;
-  
-    if((lat>=0.0 && day==COLDEST_DAY_NHEMISPHERE) ||
-       (lat<0.0 && day==COLDEST_DAY_SHEMISPHERE)) 
+  if((lat>=0.0 && day==COLDEST_DAY_NHEMISPHERE) ||
+     (lat<0.0 && day==COLDEST_DAY_SHEMISPHERE)) 
+    for(cft=0;cft<ncft;cft++)
       cropdates[cft].fallow=cropdates[cft].fallow_irrig=0;
-  }
+  else
+    for(cft=0;cft<ncft;cft++)
+    {
+      cropdates[cft].fallow--;
+      cropdates[cft].fallow_irrig--;
+    }
 } /* of 'update_fallowdays' */
 
 /*local function update_fallowdays() is called in sowing()*/
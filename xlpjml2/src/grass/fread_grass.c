@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STAND
+
 #include "lpj.h"
 #include "grass.h"
 
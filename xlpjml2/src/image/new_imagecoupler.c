@@ -0,0 +1,148 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**          n  e  w  _  i  m  a  g  e  c  o  u  p  l  e  r  .  c                  \n**/
+/**                                                                                \n**/
+/**     extension of LPJ to couple LPJ online with IMAGE                           \n**/
+/**     Allocates message buffers for data exchanged with IMAGE.                   \n**/
+/**     All data of one year are exchanged as one message in each                  \n**/
+/**     direction. Message consists of segments in the order sent by               \n**/
+/**     IMAGE, data of each segment are stored cell by cell.                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef IMAGE
+
+static void initmessage(Image_message *msg,   /**< message */
+                        const int n[],        /**< items per cell of segments */
+                        int nseg,             /**< number of segments */
+                        Bool isreceive,       /**< message is received */
+                        const Image_coupler *coupler, /**< IMAGE coupler */
+                        const Config *config  /**< LPJmL configuration */
+                       )
+{
+  int i;
+  msg->nseg=nseg;
+  msg->offset[0]=0;
+  for(i=0;i<nseg;i++)
+    msg->offset[i+1]=msg->offset[i]+n[i];
+  msg->nitem=msg->offset[nseg];
+  msg->size=msg->nitem*config->nall;
+  msg->data=newvec(float,msg->nitem*config->ngridcell);
+  check(msg->data);
+  msg->buffer=NULL;
+#ifdef USE_MPI
+  msg->counts=newvec(int,config->ntask);
+  check(msg->counts);
+  msg->offsets=newvec(int,config->ntask);
+  check(msg->offsets);
+  for(i=0;i<config->ntask;i++)
+  {
+    msg->counts[i]=coupler->ncell[i]*msg->nitem;
+    msg->offsets[i]=coupler->celloffset[i]*msg->nitem;
+  }
+  msg->stage=NULL;
+  if(config->rank==0)
+  {
+    msg->buffer=newvec(float,msg->size);
+    check(msg->buffer);
+    msg->stage=newvec(float,msg->size);
+    check(msg->stage);
+  }
+#else
+  if(isreceive)
+  {
+    /* second buffer for data of next year received in the background */
+    msg->buffer=newvec(float,msg->size);
+    check(msg->buffer);
+  }
+#endif
+} /* of 'initmessage' */
+
+static void freemessage(Image_message *msg)
+{
+  free(msg->data);
+  free(msg->buffer);
+#ifdef USE_MPI
+  free(msg->stage);
+  free(msg->counts);
+  free(msg->offsets);
+#endif
+} /* of 'freemessage' */
+
+Image_coupler *new_imagecoupler(const Climate *climate, /**< climate data */
+                                const Config *config    /**< LPJmL configuration */
+                               )                        /** \return allocated coupler */
+{
+  Image_coupler *coupler;
+  int n[NIMAGEOUT];
+  int i;
+  coupler=new(Image_coupler);
+  check(coupler);
+  coupler->socket=config->in;
+  coupler->co2=0;
+  coupler->posted=coupler->rc=FALSE;
+#ifdef USE_MPI
+  coupler->ncell=newvec(int,config->ntask);
+  check(coupler->ncell);
+  coupler->celloffset=newvec(int,config->ntask);
+  check(coupler->celloffset);
+  getcounts(coupler->ncell,coupler->celloffset,config->nall,1,config->ntask);
+#endif
+  /* segments of message received from IMAGE */
+  n[IMAGE_TEMP]=n[IMAGE_PREC]=n[IMAGE_CLOUD]=n[IMAGE_WET]=(isdaily(climate->file_temp)) ? NDAYYEAR : NMONTH;
+  /* land-use data and product pools are only received with land use */
+  if(config->withlanduse!=NO_LANDUSE)
+  {
+    n[IMAGE_TIMBER_FRAC]=n[IMAGE_FBURNT]=1;
+    n[IMAGE_LANDUSE]=NIMAGECROPS;
+    n[IMAGE_PRODUCTPOOL]=sizeof(Timber)/sizeof(float);
+  }
+  else
+    n[IMAGE_TIMBER_FRAC]=n[IMAGE_FBURNT]=n[IMAGE_LANDUSE]=n[IMAGE_PRODUCTPOOL]=0;
+  initmessage(&coupler->in,n,NIMAGEIN,TRUE,coupler,config);
+  /* segments of message sent to IMAGE */
+  for(i=0;i<NIMAGEOUT;i++)
+    n[i]=1;
+  n[IMAGE_BIOMASS]=NBPOOLS;
+#ifndef SENDSEP
+  n[IMAGE_RH]=n[IMAGE_HARVEST_AGRIC]=n[IMAGE_HARVEST_BIOFUEL]=
+  n[IMAGE_HARVEST_TIMBER]=n[IMAGE_PRODUCT_TURNOVER_FAST]=
+  n[IMAGE_PRODUCT_TURNOVER_SLOW]=n[IMAGE_TRAD_BIOFUEL]=0;
+#endif
+  initmessage(&coupler->out,n,NIMAGEOUT,FALSE,coupler,config);
+  return coupler;
+} /* of 'new_imagecoupler' */
+
+void free_imagecoupler(Image_coupler *coupler /**< IMAGE coupler */
+                      )
+{
+  if(coupler!=NULL)
+  {
+#ifndef _WIN32
+    if(coupler->posted)
+    {
+      /* simulation stopped with receive still pending, shutdown of
+         socket lets the blocked read of the receiving thread return */
+      shutdown_socket(coupler->socket);
+      pthread_join(coupler->thread,NULL);
+    }
+#endif
+    freemessage(&coupler->in);
+    freemessage(&coupler->out);
+#ifdef USE_MPI
+    free(coupler->ncell);
+    free(coupler->celloffset);
+#endif
+    free(coupler);
+  }
+} /* of 'free_imagecoupler' */
+
+#endif
@@ -0,0 +1,109 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               r  e  c  e  i  v  e  _  i  m  a  g  e  .  c                      \n**/
+/**                                                                                \n**/
+/**     extension of LPJ to couple LPJ online with IMAGE                           \n**/
+/**     Receives message with data of one year from IMAGE. Receive is              \n**/
+/**     posted after data of the previous year are sent and done in a              \n**/
+/**     separate thread on the root task, so that it overlaps with the             \n**/
+/**     remaining work of the previous year.                                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef IMAGE
+
+static void *receive(void *arg)
+{
+  Image_coupler *coupler;
+  coupler=arg;
+  /* message consists of CO2 concentration followed by segments of 4 byte items */
+  coupler->rc=readdouble_socket(coupler->socket,&coupler->co2_recv,1);
+  if(!coupler->rc)
+    coupler->rc=readfloat_socket(coupler->socket,coupler->in.buffer,
+                                 coupler->in.size);
+  return NULL;
+} /* of 'receive' */
+
+void post_image_receive(Image_coupler *coupler, /**< IMAGE coupler */
+                        const Config *config    /**< LPJmL configuration */
+                       )
+{
+  if(config->rank==0)
+  {
+#ifndef _WIN32
+    if(!pthread_create(&coupler->thread,NULL,receive,coupler))
+    {
+      coupler->posted=TRUE;
+      return;
+    }
+#endif
+    /* data is received in wait_image_receive() */
+    coupler->posted=FALSE;
+  }
+} /* of 'post_image_receive' */
+
+Bool wait_image_receive(Image_coupler *coupler, /**< IMAGE coupler */
+                        const Config *config    /**< LPJmL configuration */
+                       )                        /** \return TRUE on error */
+{
+  Bool rc=FALSE;
+#ifndef USE_MPI
+  float *data;
+#endif
+  if(config->rank==0)
+  {
+#ifdef DEBUG_IMAGE
+    printf("waiting for data from IMAGE\n");
+    fflush(stdout);
+#endif
+#ifndef _WIN32
+    if(coupler->posted)
+    {
+      pthread_join(coupler->thread,NULL);
+      coupler->posted=FALSE;
+    }
+    else
+#endif
+      receive(coupler);
+    rc=coupler->rc;
+    if(rc)
+      fputs("ERROR172: Simulation stopped for lack of data from IMAGE.\n",stderr);
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+  if(rc)
+    return TRUE;
+  MPI_Bcast(&coupler->co2_recv,1,MPI_DOUBLE,0,config->comm);
+  if(config->rank==0)
+    reorder_image(&coupler->in,coupler,config->ntask,config->nall,TRUE);
+  MPI_Scatterv(coupler->in.stage,coupler->in.counts,coupler->in.offsets,
+               MPI_FLOAT,coupler->in.data,coupler->in.counts[config->rank],
+               MPI_FLOAT,0,config->comm);
+#else
+  if(rc)
+    return TRUE;
+  /* swap buffers, buffer is free for data of next year */
+  data=coupler->in.data;
+  coupler->in.data=coupler->in.buffer;
+  coupler->in.buffer=data;
+#endif
+  coupler->co2=(Real)coupler->co2_recv;
+#ifdef DEBUG_IMAGE
+  if(config->rank==0)
+  {
+    printf("got CO2 (%g) and data from IMAGE\n",coupler->co2);
+    fflush(stdout);
+  }
+#endif
+  return FALSE;
+} /* of 'wait_image_receive' */
+
+#endif
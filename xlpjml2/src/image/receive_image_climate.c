@@ -17,18 +17,15 @@
 
 #ifdef IMAGE
 
-Bool receive_image_climate(Climate *climate,    /**< Climate data */
-                           const Cell grid[],   /**< LPJ grid */
-                           int year,            /**< year (AD) */
-                           const Config *config /**< LPJ configuration */
-                          )                     /** \return TRUE on error */
+Bool receive_image_climate(Climate *climate,             /**< Climate data */
+                           const Cell grid[],            /**< LPJ grid */
+                           int year,                     /**< year (AD) */
+                           const Image_coupler *coupler, /**< data received from IMAGE */
+                           const Config *config          /**< LPJ configuration */
+                          )                              /** \return TRUE on error */
 {
   int i;
-#ifdef USE_MPI
-  int *counts,*offsets;
-  int n;
-#endif
-  float *image_data;
+  const float *image_data;
 #ifdef IMAGE_CLIM_AVG
   for(i=0;i<climate->file_temp_var.n;i++)
     climate->data.temp[i]=0; /* setting varibility to 0 */
@@ -47,24 +44,7 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
   }
 #endif
     
-  image_data = newvec(float,climate->file_temp_var.n);
-  check(image_data);
-#ifdef USE_MPI
-  counts=newvec(int,config->ntask);
-  check(counts);
-  offsets=newvec(int,config->ntask);
-  check(offsets);
-  n=(isdaily(climate->file_temp)) ? NDAYYEAR : NMONTH;
-  getcounts(counts,offsets,config->nall,n,config->ntask);
-  mpi_read_socket(config->in,image_data,MPI_FLOAT,n*config->nall,counts,
-                 offsets,config->rank,config->comm);
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting temperature data, size should be %d\n",climate->file_temp_var.n);
-  fflush(stdout);
-#endif
-  readfloat_socket(config->in,image_data,climate->file_temp_var.n);
-#endif
+  image_data=getsegment_image(&coupler->in,IMAGE_TEMP,config->ngridcell);
 
   /* adding IMAGE temperature to absolute temperature variability */
   for(i=0;i<climate->file_temp_var.n;i++)
@@ -78,7 +58,6 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
     }
 #endif
   }
-  free(image_data);
 
   /* IMAGE precipitation consists of CRU variability (%) and IMAGE prec */
 #ifdef IMAGE_CLIM_AVG
@@ -99,18 +78,7 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
   }
 #endif
    
-  image_data = newvec(float,climate->file_prec_var.n);
-  check(image_data);
-#ifdef USE_MPI
-  mpi_read_socket(config->in,image_data,MPI_FLOAT,n*config->nall,counts,
-                 offsets,config->rank,config->comm);
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting precip data, size should be %d\n",climate->file_prec_var.n);
-  fflush(stdout);
-#endif
-  readfloat_socket(config->in,image_data,climate->file_prec_var.n);
-#endif
+  image_data=getsegment_image(&coupler->in,IMAGE_PREC,config->ngridcell);
  
   for(i=0;i<climate->file_prec_var.n;i++)
   {
@@ -125,20 +93,7 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
 #endif
   }
 
-  free(image_data);
-  
-  image_data = newvec(float,climate->file_cloud.n);
-  check(image_data);
-#ifdef USE_MPI
-  mpi_read_socket(config->in,image_data,MPI_FLOAT,n*config->nall,counts,
-                 offsets,config->rank,config->comm);
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting cloudiness data, size should be %d\n",climate->file_cloud.n);
-  fflush(stdout);
-#endif
-  readfloat_socket(config->in,image_data,climate->file_cloud.n);
-#endif
+  image_data=getsegment_image(&coupler->in,IMAGE_CLOUD,config->ngridcell);
 
   /* assigning IMAGE cloudiness */
   for(i=0;i<climate->file_cloud.n;i++)
@@ -152,22 +107,8 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
     }
 #endif
   }
-  free(image_data);
 
-  image_data = newvec(float,climate->file_wet.n);
-  check(image_data);
-#ifdef USE_MPI
-  mpi_read_socket(config->in,image_data,MPI_FLOAT,n*config->nall,counts,
-                 offsets,config->rank,config->comm);
-  free(counts);
-  free(offsets);
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting wet day data, size should be %d\n",climate->file_wet.n);
-  fflush(stdout);
-#endif
-  readfloat_socket(config->in,image_data,climate->file_wet.n);
-#endif
+  image_data=getsegment_image(&coupler->in,IMAGE_WET,config->ngridcell);
 
   /* assigning IMAGE number of wet days */
   if(israndomprec(climate))
@@ -182,8 +123,6 @@ Bool receive_image_climate(Climate *climate,    /**< Climate data */
       }
 #endif
     }
-  free(image_data);
-
   return FALSE;
 } /* of 'receive_image_climate' */
 
@@ -16,28 +16,11 @@
 
 #ifdef IMAGE
 
-Real receive_image_co2(const Config *config /**< LPJ configuration */
-                      )                  /** \return atmospheric CO2 (ppm) */
+Real receive_image_co2(const Image_coupler *coupler /**< IMAGE coupler */
+                      )                             /** \return atmospheric CO2 (ppm) */
 {
-  double co2;
-#ifdef USE_MPI
-  if(config->rank==0)
-  {
-#endif
-#ifdef DEBUG_IMAGE
-  printf("reading CO2 from IMAGE\n");
-  fflush(stdout);
-#endif
-  readdouble_socket(config->in,&co2,1);
-#ifdef DEBUG_IMAGE
-  printf("got CO2 (%g) from IMAGE\n",co2);
-  fflush(stdout);
-#endif
-#ifdef USE_MPI
-  }
-  MPI_Bcast(&co2,1,MPI_DOUBLE,0,config->comm);
-#endif
-  return (Real)co2;
+  /* CO2 concentration is part of message received by wait_image_receive() */
+  return coupler->co2;
 } /* of 'receive_image_co2' */
 
 #endif
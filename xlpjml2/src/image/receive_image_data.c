@@ -16,28 +16,16 @@
 
 #ifdef IMAGE
 
-Bool receive_image_data(Cell *cell,          /**< LPJ grid */
-                        int npft,            /**< number of natural PFTs */
-                        int ncft,            /**< number of crop PFTS */
-                        const Config *config /**< LPJ configuration */
-                       )                     /** \return TRUE on error */
+void receive_image_data(Cell *cell,                   /**< LPJ grid */
+                        int npft,                     /**< number of natural PFTs */
+                        int ncft,                     /**< number of crop PFTS */
+                        const Image_coupler *coupler, /**< data received from IMAGE */
+                        const Config *config          /**< LPJ configuration */
+                       )
 {
   if(config->withlanduse!=NO_LANDUSE)
-  {
-    if(receive_image_luc(cell,npft,ncft,config))
-    {
-      fprintf(stderr,"ERROR172: Simulation stopped for lack of LUC data from IMAGE\n");
-      fflush(stderr);
-      return TRUE;
-    }
-  }
-  if(receive_image_productpools(cell,config))
-  {
-    fprintf(stderr,"ERROR173: Simulation stopped for lack of product pool data from IMAGE\n");
-    fflush(stderr);
-    return TRUE;
-  }
-  return FALSE;
+    receive_image_luc(cell,npft,ncft,coupler,config);
+  receive_image_productpools(cell,coupler,config);
 } /* of 'receive_image_data' */
 
 #endif
@@ -17,8 +17,6 @@
 
 #ifdef IMAGE
 
-#define NIMAGECROPS (sizeof(Image_landuse)/sizeof(float))
-
 static void reducelandfrac(Cell *cell,Real cropsum,int ncft)
 {
   int i,j;
@@ -76,52 +74,24 @@ static void reducelandfrac(Cell *cell,Real cropsum,int ncft)
   }
 }
 
-Bool receive_image_luc(Cell *grid,          /* LPJ grid */
-                       int npft,            /* number of natural PFTs */
-                       int ncft,            /* number of crop PFTs */
-                       const Config *config /* Grid configuration */
-                      )                     /* returns TRUE on error */
+void receive_image_luc(Cell *grid,                   /* LPJ grid */
+                       int npft,                     /* number of natural PFTs */
+                       int ncft,                     /* number of crop PFTs */
+                       const Image_coupler *coupler, /* data received from IMAGE */
+                       const Config *config          /* Grid configuration */
+                      )
 {
   int i;
   Real cropsum;
 #ifdef DEBUG_IMAGE
   float sum;
 #endif
-  Image_landuse *image_landuse;
-  float *image_data;
-  int *image_data_int;
-#ifdef USE_MPI
-  int *counts,*offsets;
-#endif
+  const Image_landuse *image_landuse;
+  const float *image_data;
+  const int *image_data_int;
 
   /* get timber harvest shares from IMAGE */
-  image_data = newvec(float,config->ngridcell);
-  check(image_data);
-#ifdef USE_MPI
-  counts=newvec(int,config->ntask);
-  check(counts);
-  offsets=newvec(int,config->ntask);
-  check(offsets);
-  getcounts(counts,offsets,config->nall,1,config->ntask);
-  if(mpi_read_socket(config->in,image_data,MPI_FLOAT,config->nall,counts,
-                     offsets,config->rank,config->comm))
-  {
-    free(offsets);
-    free(counts);
-    free(image_data);
-    return TRUE;
-  }
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting timber harvest shares\n");
-  fflush(stdout);
-#endif
-  if(readfloat_socket(config->in, image_data, config->ngridcell))
-  {
-    free(image_data);
-    return TRUE;
-  }
-#endif
+  image_data=getsegment_image(&coupler->in,IMAGE_TIMBER_FRAC,config->ngridcell);
 #ifdef DEBUG_IMAGE
   printf("assigning timber harvest shares\n");
   fflush(stdout);
@@ -142,31 +112,9 @@ Bool receive_image_luc(Cell *grid,          /* LPJ grid */
     }
 #endif
   }
-  free(image_data);
 
   /* get timber burnt shares from IMAGE */
-  image_data_int = newvec(int,config->ngridcell);
-  check(image_data_int);
-#ifdef USE_MPI
-  if(mpi_read_socket(config->in,image_data_int,MPI_INT,config->nall,counts,
-                     offsets,config->rank,config->comm))
-  {
-    free(offsets);
-    free(counts);
-    free(image_data_int);
-    return TRUE;
-  }
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting timber burnt shares\n");
-  fflush(stdout);
-#endif
-  if(readint_socket(config->in,image_data_int,config->ngridcell))
-  {
-    free(image_data_int);
-    return TRUE;
-  }
-#endif
+  image_data_int=(const int *)getsegment_image(&coupler->in,IMAGE_FBURNT,config->ngridcell);
 #ifdef DEBUG_IMAGE
   printf("assigning timber burnt shares\n");
   fflush(stdout);
@@ -187,34 +135,9 @@ Bool receive_image_luc(Cell *grid,          /* LPJ grid */
     }
 #endif
   }
-  free(image_data_int);
 
   /* get land-use shares from IMAGE */
-  image_landuse = newvec(Image_landuse,config->ngridcell);
-  check(image_landuse);
-#ifdef USE_MPI
-  getcounts(counts,offsets,config->nall,NIMAGECROPS,config->ntask);
-  if(mpi_read_socket(config->in,image_landuse,MPI_FLOAT,config->nall*NIMAGECROPS,
-                     counts,offsets,config->rank,config->comm))
-  {
-    free(offsets);
-    free(counts);
-    free(image_landuse);
-    return TRUE;
-  }
-  free(offsets);
-  free(counts);
-#else
-#ifdef DEBUG_IMAGE
-  printf("getting crop shares\n");
-  fflush(stdout);
-#endif
-  if(readfloat_socket(config->in,(float *)image_landuse,config->ngridcell*NIMAGECROPS))
-  {
-    free(image_landuse);
-    return TRUE;
-  }
-#endif
+  image_landuse=(const Image_landuse *)getsegment_image(&coupler->in,IMAGE_LANDUSE,config->ngridcell);
 #ifdef DEBUG_IMAGE
   printf("assigning IMAGE crop groups to LPJmL CFTs\n");
   fflush(stdout);
@@ -369,18 +292,10 @@ Bool receive_image_luc(Cell *grid,          /* LPJ grid */
       }
     }/* if skip */
   }
-#ifdef DEBUG_IMAGE
-  printf("done with everything, freeing memory\n");
-  fflush(stdout);
-#endif
-
-  free(image_landuse);
 #ifdef DEBUG_IMAGE
   printf("done in receive_image_luc()\n");
   fflush(stdout);
 #endif
-
-  return FALSE;
 } /* of 'receive_image_luc' */
 
 #endif
@@ -16,41 +16,17 @@
 
 #ifdef IMAGE
 
-Bool receive_image_productpools(Cell *cell,          /**< LPJ grid */
-                                const Config *config /**< LPJ configuration */
-                               )                     /** \return TRUE on error */
+void receive_image_productpools(Cell *cell,                   /**< LPJ grid */
+                                const Image_coupler *coupler, /**< data received from IMAGE */
+                                const Config *config          /**< LPJ configuration */
+                               )
 {
-  Bool rc;
   int i;
   Timber *image_timber_distribution;
   Real sum;
-#ifdef USE_MPI
-  int *counts,*offsets;
-#endif
 
   /* get timber product pools from IMAGE */
-  image_timber_distribution = newvec(Timber,config->ngridcell);
-  check(image_timber_distribution);
-#ifdef USE_MPI
-  counts=newvec(int,config->ntask);
-  check(counts);
-  offsets=newvec(int,config->ntask);
-  check(offsets);
-  getcounts(counts,offsets,config->nall,sizeof(Timber)/sizeof(float),config->ntask);
-  rc=mpi_read_socket(config->in,(float *)image_timber_distribution,MPI_FLOAT,
-                     config->nall*sizeof(Timber)/sizeof(float),counts,
-                     offsets,config->rank,config->comm);
-  free(counts);
-  free(offsets);
-#else
-  rc=readfloat_socket(config->in,(float *)image_timber_distribution,
-                      config->ngridcell*sizeof(Timber)/sizeof(float));
-
-#ifdef DEBUG_IMAGE
-  printf("received timber product pools\n");
-  fflush(stdout);
-#endif
-#endif
+  image_timber_distribution=(Timber *)getsegment_image(&coupler->in,IMAGE_PRODUCTPOOL,config->ngridcell);
   for(i=0;i<config->ngridcell;i++)
   {
     if(!cell[i].skip)
@@ -84,8 +60,6 @@ Bool receive_image_productpools(Cell *cell,          /**< LPJ grid */
 #endif
     }
   }
-  free(image_timber_distribution);
-  return rc;
 } /* of 'receive_image_productpools' */
 
 #endif
@@ -0,0 +1,44 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               r  e  o  r  d  e  r  _  i  m  a  g  e  .  c                      \n**/
+/**                                                                                \n**/
+/**     extension of LPJ to couple LPJ online with IMAGE                           \n**/
+/**     Reorders message between layout on socket, where each segment              \n**/
+/**     holds data of all cells, and layout for gather and scatter,                \n**/
+/**     where data of each task are contiguous                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#if defined(IMAGE) && defined(USE_MPI)
+
+void reorder_image(Image_message *msg,           /**< message */
+                   const Image_coupler *coupler, /**< IMAGE coupler */
+                   int ntask,                    /**< number of tasks */
+                   int nall,                     /**< number of cells */
+                   Bool tostage                  /**< reorder from buffer to stage (TRUE/FALSE) */
+                  )
+{
+  int task,s,n;
+  float *stage,*buffer;
+  for(task=0;task<ntask;task++)
+    for(s=0;s<msg->nseg;s++)
+    {
+      n=nitems_image(msg,s)*coupler->ncell[task];
+      buffer=msg->buffer+msg->offset[s]*nall+nitems_image(msg,s)*coupler->celloffset[task];
+      stage=msg->stage+msg->offsets[task]+msg->offset[s]*coupler->ncell[task];
+      if(tostage)
+        memcpy(stage,buffer,n*sizeof(float));
+      else
+        memcpy(buffer,stage,n*sizeof(float));
+    }
+} /* of 'reorder_image' */
+
+#endif
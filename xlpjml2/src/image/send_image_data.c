@@ -18,15 +18,14 @@
 #include "grass.h"
 #include "crop.h"
 
-#define NBPOOLS (sizeof(Biomass)/sizeof(float))
-
 #ifdef IMAGE
 
-Bool send_image_data(const Cell grid[],      /**< LPJ grid */
-                     const Climate *climate, /**< Climate data */
-                     int npft,               /**< number of natural PFTs */
-                     const Config *config    /**< LPJmL configuration */
-                    )                        /** \return TRUE on error */
+Bool send_image_data(const Cell grid[],       /**< LPJ grid */
+                     const Climate *climate,  /**< Climate data */
+                     int npft,                /**< number of natural PFTs */
+                     Image_coupler *coupler,  /**< IMAGE coupler */
+                     const Config *config     /**< LPJmL configuration */
+                    )                         /** \return TRUE on error */
 {
   Bool rc;
   float *nep_image;
@@ -44,36 +43,21 @@ Bool send_image_data(const Cell grid[],      /**< LPJ grid */
   const Pfttree *tree;
   const Pftgrass *grass;
   const Pftcrop *crop;
-#ifdef USE_MPI
-  int *counts,*offsets;
-#endif
-  nep_image = newvec(float,config->ngridcell);
-  check(nep_image);
-  biomass_image = newvec(Biomass,config->ngridcell);
-  check(biomass_image);
-  biome_image = newvec(int,config->ngridcell);
-  check(biome_image);
-  npp_image = newvec(float,config->ngridcell);
-  check(npp_image);
-  fire_image = newvec(float,config->ngridcell);
-  check(fire_image);
-  fireemission_deforest_image = newvec(float,config->ngridcell);
-  check(fireemission_deforest_image);
+  /* all data are sent in one message, segments are stored in preallocated buffer */
+  biomass_image=(Biomass *)getsegment_image(&coupler->out,IMAGE_BIOMASS,config->ngridcell);
+  biome_image=(int *)getsegment_image(&coupler->out,IMAGE_BIOME,config->ngridcell);
+  nep_image=getsegment_image(&coupler->out,IMAGE_NEP,config->ngridcell);
+  npp_image=getsegment_image(&coupler->out,IMAGE_NPP,config->ngridcell);
+  fire_image=getsegment_image(&coupler->out,IMAGE_FIRE,config->ngridcell);
+  fireemission_deforest_image=getsegment_image(&coupler->out,IMAGE_FIREEMISSION_DEFOREST,config->ngridcell);
 #ifdef SENDSEP
-  harvest_agric_image = newvec(float,config->ngridcell);
-  check(harvest_agric_image);
-  harvest_biofuel_image = newvec(float,config->ngridcell);
-  check(harvest_biofuel_image);
-  product_turnover_fast_image = newvec(float,config->ngridcell);
-  check(product_turnover_fast_image);
-  product_turnover_slow_image = newvec(float,config->ngridcell);
-  check(product_turnover_slow_image);
-  harvest_timber_image = newvec(float,config->ngridcell);
-  check(harvest_timber_image);
-  rh_image = newvec(float,config->ngridcell);
-  check(rh_image);
-  trad_biofuel_image = newvec(float,config->ngridcell);
-  check(trad_biofuel_image);
+  rh_image=getsegment_image(&coupler->out,IMAGE_RH,config->ngridcell);
+  harvest_agric_image=getsegment_image(&coupler->out,IMAGE_HARVEST_AGRIC,config->ngridcell);
+  harvest_biofuel_image=getsegment_image(&coupler->out,IMAGE_HARVEST_BIOFUEL,config->ngridcell);
+  harvest_timber_image=getsegment_image(&coupler->out,IMAGE_HARVEST_TIMBER,config->ngridcell);
+  product_turnover_fast_image=getsegment_image(&coupler->out,IMAGE_PRODUCT_TURNOVER_FAST,config->ngridcell);
+  product_turnover_slow_image=getsegment_image(&coupler->out,IMAGE_PRODUCT_TURNOVER_SLOW,config->ngridcell);
+  trad_biofuel_image=getsegment_image(&coupler->out,IMAGE_TRAD_BIOFUEL,config->ngridcell);
 #endif
   /* init data fields */
 #ifdef DEBUG_IMAGE
@@ -222,44 +206,15 @@ Bool send_image_data(const Cell grid[],      /**< LPJ grid */
   }
   /* send data */
 #ifdef USE_MPI
-  counts=newvec(int,config->ntask);
-  check(counts);
-  offsets=newvec(int,config->ntask);
-  check(offsets);
-  getcounts(counts,offsets,config->nall,NBPOOLS,config->ntask);
-  mpi_write_socket(config->out,biomass_image,MPI_FLOAT,
-                   config->nall*NBPOOLS,counts,offsets,config->rank,config->comm);
-  getcounts(counts,offsets,config->nall,1,config->ntask);
-  mpi_write_socket(config->out,biome_image,MPI_INT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,nep_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,npp_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-#ifdef SENDSEP
-  mpi_write_socket(config->out,rh_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,harvest_agric_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,harvest_biofuel_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,harvest_timber_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-#endif
-  mpi_write_socket(config->out,fire_image,MPI_FLOAT,config->nall,
-                   counts,offsets,config->rank,config->comm);
-  rc=mpi_write_socket(config->out,fireemission_deforest_image,MPI_FLOAT,
-                   config->nall,counts,offsets,config->rank,config->comm);
-#ifdef SENDSEP
-  mpi_write_socket(config->out,product_turnover_fast_image,MPI_FLOAT,
-                   config->nall,counts,offsets,config->rank,config->comm);
-  mpi_write_socket(config->out,product_turnover_slow_image,MPI_FLOAT,
-                   config->nall,counts,offsets,config->rank,config->comm);
-  rc=mpi_write_socket(config->out,trad_biofuel_image,MPI_FLOAT,
-                   config->nall,counts,offsets,config->rank,config->comm);
-#endif
-  free(counts);
-  free(offsets);
+  MPI_Gatherv(coupler->out.data,coupler->out.counts[config->rank],MPI_FLOAT,
+              coupler->out.stage,coupler->out.counts,coupler->out.offsets,
+              MPI_FLOAT,0,config->comm);
+  if(config->rank==0)
+  {
+    reorder_image(&coupler->out,coupler,config->ntask,config->nall,FALSE);
+    rc=writefloat_socket(config->out,coupler->out.buffer,coupler->out.size);
+  }
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
 #else
 #ifdef DEBUG_IMAGE
   printf("sending data\n");
@@ -272,45 +227,13 @@ Bool send_image_data(const Cell grid[],      /**< LPJ grid */
   printf("fire[1] %g\n",fire_image[1]);
   printf("fireem[1] %g\n",fireemission_deforest_image[1]);
   fflush(stdout);
-  /*printf("biomass pools[67032] %g %g %g %g %g %g %g\n",biomass_image[67032].branches,
-    biomass_image[67032].charcoal,biomass_image[67032].humus,biomass_image[67032].leaves,
-    biomass_image[67032].litter,biomass_image[67032].roots,biomass_image[67032].stems);
-  printf("biome[67032] %d\n",biome_image[67032]);
-  printf("nep[67032] %g\n",nep_image[67032]);
-  printf("npp[67032] %g\n",npp_image[67032]);
-  printf("fire[67032] %g\n",fire_image[67032]);
-  printf("fireem[67032] %g\n",fireemission_deforest_image[67032]);*/
-  fflush(stdout);
-#endif
-  writefloat_socket(config->out, biomass_image, config->ngridcell*NBPOOLS);
-  writeint_socket(config->out, biome_image, config->ngridcell);
-  writefloat_socket(config->out, nep_image, config->ngridcell);
-  writefloat_socket(config->out, npp_image, config->ngridcell);
-#ifdef SENDSEP
-  writefloat_socket(config->out, rh_image, config->ngridcell);
-  writefloat_socket(config->out, harvest_agric_image, config->ngridcell);
-  writefloat_socket(config->out, harvest_biofuel_image, config->ngridcell);
-  writefloat_socket(config->out, harvest_timber_image, config->ngridcell);
 #endif
-  writefloat_socket(config->out, fire_image, config->ngridcell);
-  rc=writefloat_socket(config->out, fireemission_deforest_image, config->ngridcell);
-#ifdef SENDSEP
-  writefloat_socket(config->out, product_turnover_fast_image, config->ngridcell);
-  writefloat_socket(config->out, product_turnover_slow_image, config->ngridcell);
-  rc=writefloat_socket(config->out, trad_biofuel_image, config->ngridcell);
-#endif
-
+  rc=writefloat_socket(config->out,coupler->out.data,coupler->out.size);
 #ifdef DEBUG_IMAGE
   printf("done sending data\n");
   fflush(stdout);
 #endif
 #endif
-  free(biomass_image);
-  free(biome_image);
-  free(nep_image);
-  free(npp_image);
-  free(fire_image);
-  free(fireemission_deforest_image);
   return rc;
 } /* of 'send_image_data' */
 
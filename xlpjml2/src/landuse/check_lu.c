@@ -22,7 +22,7 @@
 #include "crop.h"
 #include "agriculture.h"
 
-Bool check_lu(const Standlist standlist, /**< List of stands */
+Bool check_lu(const Cell *cell,          /**< pointer to cell */
               Real landfrac,             /**< land fraction for crop */
               int id,                    /**< PFT index of crop */
               Bool irrigation            /**< irrigated (TRUE/FALSE) */
@@ -36,14 +36,13 @@ Bool check_lu(const Standlist standlist, /**< List of stands */
 
   if(landfrac>0)
   {
-    foreachstand(stand,s,standlist)
-      if(stand->type->landusetype==AGRICULTURE)
-      {
-        pft=getpft(&stand->pftlist,0);
-        data=stand->data;
-        if(pft->par->id==id && data->irrigation==irrigation)
-          return FALSE;
-      }
+    foreachstandoftype(stand,s,cell,AGRICULTURE)
+    {
+      pft=getpft(&stand->pftlist,0);
+      data=stand->data;
+      if(pft->par->id==id && data->irrigation==irrigation)
+        return FALSE;
+    }
     return TRUE;
   }
   else 
@@ -37,7 +37,7 @@ Real cultivate(Cell *cell,           /**< cell pointer */
   if(landfrac>=setasidestand->frac-0.00001)
   {
     setasidestand->type->freestand(setasidestand);
-    setasidestand->type=&agriculture_stand;
+    setstandtype(setasidestand,&agriculture_stand);
     new_agriculture(setasidestand);
     /* delete all PFTs */
     cutpfts(setasidestand);
@@ -179,7 +179,7 @@ Real daily_agriculture(Stand *stand, /**< stand pointer */
       delpft(&stand->pftlist,p);
       /* adjust index */
       p--;
-      stand->type=&kill_stand;
+      setstandtype(stand,&kill_stand);
       continue;
     }
   } /* of foreachpft() */
@@ -242,7 +242,7 @@ Real daily_agriculture(Stand *stand, /**< stand pointer */
     output->cft_irrig_events[pft->par->id-npft+data->irrigation*(ncft+NGRASS+NBIOMASSTYPE)]++; /* id is consecutively counted over natural pfts, biomass, and the cfts; ids for cfts are from 12-23, that is why npft (=12) is distracted from id */
   }
 
-  runoff+=infil_perc_rain(stand,rainmelt+rw_apply,&return_flow_b,config->rw_manage);
+  runoff+=infil_perc_rain(stand,rainmelt+rw_apply,&return_flow_b,config);
 
   foreachpft(pft,p,&stand->pftlist)
   {
@@ -397,7 +397,7 @@ Real daily_agriculture(Stand *stand, /**< stand pointer */
         data->irrig_amount=0;
       }
       delpft(&stand->pftlist,p);
-      stand->type=&kill_stand;
+      setstandtype(stand,&kill_stand);
       p--;
       continue;
     }
@@ -135,7 +135,7 @@ Real daily_biomass_tree(Stand *stand, /**< stand pointer */
     output->cft_irrig_events[rbtree(ncft)+data->irrigation*(ncft+NGRASS+NBIOMASSTYPE)]++;
   }
 
-  runoff+=infil_perc_rain(stand,rainmelt,&return_flow_b,config->rw_manage);
+  runoff+=infil_perc_rain(stand,rainmelt,&return_flow_b,config);
 
   foreachpft(pft,p,&stand->pftlist)
   {
@@ -141,7 +141,7 @@ Real daily_grassland(Stand *stand, /**< stand pointer */
     output->cft_irrig_events[rmgrass(ncft)+data->irrigation*(ncft+NGRASS+NBIOMASSTYPE)]++; /* id is consecutively counted over natural pfts, biomass, and the cfts; ids for cfts are from 12-23, that is why npft (=12) is distracted from id */
   }
 
-  runoff+=infil_perc_rain(stand,rainmelt+rw_apply,&return_flow_b,config->rw_manage);
+  runoff+=infil_perc_rain(stand,rainmelt+rw_apply,&return_flow_b,config);
 
   isphen = FALSE;
   foreachpft(pft,p,&stand->pftlist)
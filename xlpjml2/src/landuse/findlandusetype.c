@@ -14,14 +14,9 @@
 
 #include "lpj.h"
 
-int findlandusetype(const Standlist standlist, /**< stand list */
+int findlandusetype(const Cell *cell,          /**< pointer to cell */
                     Landusetype landusetype    /**< land-use type */
                    ) /** \return index of stand found or NOT_FOUND */
 {
-  int s;
-  const Stand *stand;
-  foreachstand(stand,s,standlist)
-    if(stand->type->landusetype==landusetype)
-      return s;
-  return NOT_FOUND;
+  return cell->standindex.first[landusetype];
 } /* of 'findlandusetype' */
@@ -17,7 +17,7 @@
 #include "lpj.h"
 #include "agriculture.h"
 
-int findstand(const Standlist standlist, /**< Stand list */
+int findstand(const Cell *cell,          /**< pointer to cell */
               Landusetype landusetype,   /**< landuse type */
               Bool irrigation            /**< irrigated (TRUE/FALSE) */
              ) /** \return index of stand found or NOT_FOUND */
@@ -25,8 +25,8 @@ int findstand(const Standlist standlist, /**< Stand list */
   int s;
   const Stand *stand;
   Irrigation *data; 
-  foreachstand(stand,s,standlist)
-    if(stand->type->landusetype==landusetype && stand->data!=NULL)
+  foreachstandoftype(stand,s,cell,landusetype)
+    if(stand->data!=NULL)
     {
       data=stand->data;
       if(data->irrigation==irrigation)
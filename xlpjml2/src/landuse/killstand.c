@@ -28,6 +28,8 @@ void killstand(Cell *cell,            /**< cell pointer */
   int s;
   Irrigation *data;
   Bool irrig;
+  if(nstandoftype(cell,KILL)==0)
+    return;
   foreachstand(stand,s,cell->standlist)
     if(stand->type->landusetype==KILL)
     {
@@ -35,6 +35,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_INPUT
+
 #include "lpj.h"
 #include "natural.h"
 #include "agriculture.h"
@@ -44,7 +44,7 @@ void deforest(Cell *cell,            /**< pointer to cell */
 {
   int s,pos;
   Stand *natstand,*cutstand;
-  s=findlandusetype(cell->standlist,NATURAL);
+  s=findlandusetype(cell,NATURAL);
   if(s!=NOT_FOUND)
   {
     natstand=getstand(cell->standlist,s);
@@ -91,7 +91,7 @@ static void regrowth(Cell *cell, /* pointer to cell */
   Pft *pft;
   Stand *setasidestand,*natstand,*mixstand;
   
-  s=findlandusetype(cell->standlist,irrig==TRUE ? SETASIDE_IR : SETASIDE_RF);
+  s=findlandusetype(cell,irrig==TRUE ? SETASIDE_IR : SETASIDE_RF);
   if(s!=NOT_FOUND)
   {
     setasidestand=getstand(cell->standlist,s);
@@ -111,7 +111,7 @@ static void regrowth(Cell *cell, /* pointer to cell */
       setasidestand->frac+=difffrac;
     }
 
-    s=findlandusetype(cell->standlist,NATURAL);
+    s=findlandusetype(cell,NATURAL);
     if(s!=NOT_FOUND)
     {        /*mixing of natural vegetation with regrowth*/
       natstand=getstand(cell->standlist,s);
@@ -124,7 +124,7 @@ static void regrowth(Cell *cell, /* pointer to cell */
     else
     {
       mixstand->type->freestand(mixstand);
-      mixstand->type=&natural_stand;
+      setstandtype(mixstand,&natural_stand);
       new_natural(mixstand);
       natstand=mixstand; 
     }
@@ -158,7 +158,7 @@ static void landexpansion(Cell *cell,            /* cell pointer */
   Irrigation *data;
   Stand *setasidestand,*mixstand;
 
-  s=findlandusetype(cell->standlist,irrigation==TRUE ? SETASIDE_IR : SETASIDE_RF);
+  s=findlandusetype(cell,irrigation==TRUE ? SETASIDE_IR : SETASIDE_RF);
   if(s!=NOT_FOUND)
   {
     setasidestand=getstand(cell->standlist,s);
@@ -206,7 +206,7 @@ static void landexpansion(Cell *cell,            /* cell pointer */
               n_est[pftpar[p].type]++;
             }
           mixstand->type->freestand(mixstand);
-          mixstand->type=&grassland_stand;
+          setstandtype(mixstand,&grassland_stand);
           new_agriculture(mixstand);
           break;
         case BIOMASS_TREE_PLANTATION:
@@ -218,7 +218,7 @@ static void landexpansion(Cell *cell,            /* cell pointer */
               n_est[pftpar[p].type]++;
             }
           mixstand->type->freestand(mixstand);
-          mixstand->type=&biomass_tree_stand;
+          setstandtype(mixstand,&biomass_tree_stand);
           new_agriculture(mixstand);
           mixstand->growing_time++;
           mixstand->age++;
@@ -232,7 +232,7 @@ static void landexpansion(Cell *cell,            /* cell pointer */
               n_est[pftpar[p].type]++;
             }
           mixstand->type->freestand(mixstand);
-          mixstand->type=&biomass_grass_stand;
+          setstandtype(mixstand,&biomass_grass_stand);
           new_agriculture(mixstand);
           break;
         default:
@@ -530,8 +530,8 @@ void landusechange(Cell *cell,            /**< pointer to cell */
 
   if(difffrac*difffrac2<-epsilon) /* if one increases while the other decreases */
   {
-    s=findlandusetype(cell->standlist,SETASIDE_RF);
-    s2=findlandusetype(cell->standlist,SETASIDE_IR);
+    s=findlandusetype(cell,SETASIDE_RF);
+    s2=findlandusetype(cell,SETASIDE_IR);
     if(s!=NOT_FOUND && s2!=NOT_FOUND)
     {
       stand=getstand(cell->standlist,s);
@@ -599,7 +599,7 @@ void landusechange(Cell *cell,            /**< pointer to cell */
     /* pasture */
     cultivation_type=PASTURE;
     irrigation=i;
-    s=findstand(cell->standlist,GRASSLAND,irrigation);
+    s=findstand(cell,GRASSLAND,irrigation);
     if(s!=NOT_FOUND)
     {
       stand=getstand(cell->standlist,s);
@@ -618,7 +618,7 @@ void landusechange(Cell *cell,            /**< pointer to cell */
     /* Biomass plantations */
     cultivation_type=BIOMASS_TREE_PLANTATION;
     irrigation=i;
-    s=findstand(cell->standlist,BIOMASS_TREE,irrigation);
+    s=findstand(cell,BIOMASS_TREE,irrigation);
     if(s!=NOT_FOUND)
     {
       stand=getstand(cell->standlist,s);
@@ -638,7 +638,7 @@ void landusechange(Cell *cell,            /**< pointer to cell */
 
     cultivation_type=BIOMASS_GRASS_PLANTATION;
     irrigation=i;
-    s=findstand(cell->standlist,BIOMASS_GRASS,irrigation);
+    s=findstand(cell,BIOMASS_GRASS,irrigation);
     if(s!=NOT_FOUND)
     {
       stand=getstand(cell->standlist,s);
@@ -680,7 +680,7 @@ void landusechange(Cell *cell,            /**< pointer to cell */
   /* if timber harvest not satisfied by agricultural expansion */
   if(istimber && cell->ml.image_data->timber_frac>0.001)
   {
-    s=findlandusetype(cell->standlist,NATURAL);
+    s=findlandusetype(cell,NATURAL);
     if(s!=NOT_FOUND)
     {
       stand=getstand(cell->standlist,s);
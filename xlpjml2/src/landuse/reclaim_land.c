@@ -28,6 +28,7 @@ static void remove_vegetation_copy(Soil *soil, /* soil pointer */
   Real nind;
 #ifdef IMAGE
   Real ftimber; /* fraction harvested for timber */
+  Real trad_biofuel;
   Bool tharvest=FALSE;
 
   ftimber=min(1,cell->ml.image_data->timber_frac/standfrac);
@@ -59,8 +60,10 @@ static void remove_vegetation_copy(Soil *soil, /* soil pointer */
         tharvest=TRUE;
         /* harvesting timber */
         cell->output.ftimber=ftimber;
+        trad_biofuel=cell->output.trad_biofuel;
         cell->output.timber_harvest+=timber_harvest(pft,soil,&cell->ml.image_data->timber,
-          cell->ml.image_data->timber_f,ftimber,standfrac,&nind,&cell->output.trad_biofuel);
+          cell->ml.image_data->timber_f,ftimber,standfrac,&nind,&trad_biofuel);
+        cell->output.trad_biofuel=trad_biofuel;
 #ifdef DEBUG_IMAGE
         if(ftimber>0 ||
           (cell->coord.lon-.1<-43.25 && cell->coord.lon+.1>-43.25 && cell->coord.lat-.1<-11.75 && cell->coord.lat+.1>-11.75)||
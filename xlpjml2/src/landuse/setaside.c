@@ -131,7 +131,7 @@ Bool setaside(Cell *cell,            /**< Pointer to LPJ cell */
   Real flux_estab;
   Irrigation *data;
 
-  s=findlandusetype(cell->standlist,irrig? SETASIDE_IR : SETASIDE_RF);
+  s=findlandusetype(cell,irrig? SETASIDE_IR : SETASIDE_RF);
   if(s!=NOT_FOUND)
   {
     mixsetaside(getstand(cell->standlist,s),cropstand,intercrop);
@@ -140,7 +140,7 @@ Bool setaside(Cell *cell,            /**< Pointer to LPJ cell */
   else
   {
     cropstand->type->freestand(cropstand);
-    cropstand->type= irrig? &setaside_ir_stand : &setaside_rf_stand;
+    setstandtype(cropstand,irrig? &setaside_ir_stand : &setaside_rf_stand);
     cropstand->type->newstand(cropstand);
     data=cropstand->data;
     data->irrigation= irrig? TRUE : FALSE;
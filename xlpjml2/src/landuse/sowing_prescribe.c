@@ -37,8 +37,8 @@ Real sowing_prescribe(Cell *cell,          /**< pointer to cell */
 #else
   istimber=FALSE;
 #endif
-  s=findlandusetype(cell->standlist,SETASIDE_RF);
-  s2=findlandusetype(cell->standlist,SETASIDE_IR);
+  s=findlandusetype(cell,SETASIDE_RF);
+  s2=findlandusetype(cell,SETASIDE_IR);
   if(s!=NOT_FOUND || s2!=NOT_FOUND)
   {
 
@@ -48,7 +48,7 @@ Real sowing_prescribe(Cell *cell,          /**< pointer to cell */
       earliest_sdate=(cell->coord.lat>=0) ? croppar->initdate.sdatenh : croppar->initdate.sdatesh;
 
       /*rainfed crops*/
-      s=findlandusetype(cell->standlist,SETASIDE_RF);
+      s=findlandusetype(cell,SETASIDE_RF);
       if(s!=NOT_FOUND)
       {
         setasidestand=getstand(cell->standlist,s);
@@ -56,7 +56,7 @@ Real sowing_prescribe(Cell *cell,          /**< pointer to cell */
         if(day==cell->ml.sdate_fixed[cft])
         {
           wtype = (croppar->calcmethod_sdate==TEMP_WTYP_CALC_SDATE && day>earliest_sdate) ? TRUE : FALSE;
-          if(check_lu(cell->standlist,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
+          if(check_lu(cell,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
           {
             if(!alloc_today_rf)
             {
@@ -74,7 +74,7 @@ Real sowing_prescribe(Cell *cell,          /**< pointer to cell */
           }
         }/*of rainfed CFTs*/
       }
-      s=findlandusetype(cell->standlist,SETASIDE_IR);
+      s=findlandusetype(cell,SETASIDE_IR);
       if(s!=NOT_FOUND)
       {
         setasidestand=getstand(cell->standlist,s);
@@ -84,7 +84,7 @@ Real sowing_prescribe(Cell *cell,          /**< pointer to cell */
         if(day==cell->ml.sdate_fixed[cft+ncft])
         {
           wtype = (croppar->calcmethod_sdate==TEMP_WTYP_CALC_SDATE && day>earliest_sdate) ? TRUE : FALSE;
-          if(check_lu(cell->standlist,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
+          if(check_lu(cell,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
           {
             if(!alloc_today_ir)
             {
@@ -4,6 +4,10 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
+/**     Function sows crops on set-aside stands. Only crops with today's           \n**/
+/**     month as sowing month are checked. Set-aside stands are searched           \n**/
+/**     again only after a crop has been sown.                                     \n**/
+/**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
 /** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
@@ -16,6 +20,61 @@
 #include "crop.h"
 #include "agriculture.h"
 
+static Real sowcrop(Cell *cell,            /* pointer to cell */
+                    Stand *setasidestand,  /* set-aside stand */
+                    Bool irrigation,       /* irrigated crop (TRUE/FALSE) */
+                    Bool wtyp,             /* winter type (TRUE/FALSE) */
+                    Bool *alloc_today,     /* allocation of set-aside stand done today */
+                    Bool istimber,
+                    int cft,               /* crop index */
+                    int day,               /* day (1..365) */
+                    int npft,              /* number of natural PFTs */
+                    int ncft,              /* number of crop PFTs */
+                    int year,              /* simulation year (AD) */
+                    const Config *config   /* LPJ settings */
+                   )                       /* returns establishment flux (gC/m2) */
+{
+  Real flux_estab;
+  if(!*alloc_today)
+  {
+    allocation_today(setasidestand,config->ntypes);
+    *alloc_today=TRUE;
+  }
+  flux_estab=cultivate(cell,config->pftpar+npft+cft,
+                       cell->ml.cropdates[cft].vern_date20,
+                       cell->ml.landfrac[irrigation].crop[cft],irrigation,day,wtyp,
+                       setasidestand,istimber,config->irrig_scenario,
+                       npft+ncft,cft,year);
+#ifndef DOUBLE_HARVEST
+  cell->output.sdate[cft+irrigation*ncft]=day;
+#endif
+  if(config->sdate_option==FIXED_SDATE)
+    cell->ml.sdate_fixed[cft+irrigation*ncft]=day;
+  return flux_estab;
+} /* of 'sowcrop' */
+
+static Bool istempsowing(const Cell *cell,          /* pointer to cell */
+                         const Pftcroppar *croppar, /* crop parameter */
+                         int month,                 /* month (1..12) */
+                         int dayofmonth,            /* day of month (1..31) */
+                         Bool *wtyp                 /* winter type sown */
+                        )                           /* returns TRUE if crop can be sown today */
+{
+  int m,mm;
+  m = month-1; /*m runs from 0 to 11*/
+  mm = (m-1 < 0) ? NMONTH-1 : m-1; /*mm is the month before*/
+  if (cell->climbuf.mtemp20[mm] > cell->climbuf.mtemp20[m] && croppar->calcmethod_sdate==TEMP_WTYP_CALC_SDATE)
+  {
+    /*calculate day when temperature exceeds or falls below a crop-specific temperature threshold - from former function calc_cropdates*/
+    *wtyp=TRUE; /*sow winter variety*/
+    return ((cell->climbuf.temp[NDAYS-1]<croppar->temp_fall)
+      &&(cell->climbuf.temp[NDAYS-2]>=croppar->temp_fall || dayofmonth==1)) || dayofmonth==ndaymonth[m];
+  }
+  *wtyp=FALSE; /*sow summer variety */
+  return ((cell->climbuf.temp[NDAYS-1]>croppar->temp_spring)
+    &&(cell->climbuf.temp[NDAYS-2]<=croppar->temp_spring || dayofmonth==1)) || dayofmonth==ndaymonth[m];
+} /* of 'istempsowing' */
+
 Real sowing_season(Cell *cell,            /**< pointer to cell */
                    int day,               /**< day (1..365) */
                    int npft,              /**< number of natural PFTs  */
@@ -25,272 +84,97 @@ Real sowing_season(Cell *cell,            /**< pointer to cell */
                    const Config *config   /**< LPJ settings */
                   )                       /** \return establish flux (gC/m2) */
 {
-  Bool alloc_today_rf=FALSE, alloc_today_ir=FALSE,istimber;
-  int cft,m,mm,dayofmonth,month,s,s2;
+  Bool alloc_today_rf=FALSE, alloc_today_ir=FALSE,istimber,wtyp;
+  int cft,dayofmonth,month,s,s2;
   Real flux_estab=0;
   const Pftcroppar *croppar;
-  Stand *setasidestand;
 
 #ifdef IMAGE
   istimber=(config->start_imagecoupling!=INT_MAX);
 #else
   istimber=FALSE;
 #endif
-  s=findlandusetype(cell->standlist,SETASIDE_RF);
-  s2=findlandusetype(cell->standlist,SETASIDE_IR);
-  if(s!=NOT_FOUND || s2!=NOT_FOUND)
+  cvrtdaymonth(&dayofmonth,&month,day);
+  if(cell->ml.seasonality_type==NO_SEASONALITY && dayofmonth!=1)
+    return 0; /* without seasonality crops are only sown on first day of month */
+  s=findlandusetype(cell,SETASIDE_RF);
+  s2=findlandusetype(cell,SETASIDE_IR);
+  for(cft=0;cft<ncft && (s!=NOT_FOUND || s2!=NOT_FOUND);cft++)
   {
+    /* only crops with sowing month today are candidates */
+    if(month!=cell->ml.sowing_month[cft] && month!=cell->ml.sowing_month[cft+ncft])
+      continue;
+    croppar=config->pftpar[npft+cft].data;
 
-    for(cft=0;cft<ncft;cft++)
+    if (cell->ml.seasonality_type==NO_SEASONALITY) /*no seasonality*/
     {
-      croppar=config->pftpar[npft+cft].data;
-      cvrtdaymonth(&dayofmonth,&month,day);
-
-      if (cell->ml.seasonality_type==NO_SEASONALITY) /*no seasonality*/
+      if (month==cell->ml.sowing_month[cft])
       {
-        if (month==cell->ml.sowing_month[cft] && dayofmonth==1)
+        /*rainfed CFTs*/
+        if(s!=NOT_FOUND && cell->ml.cropdates[cft].fallow<=0 &&
+           check_lu(cell,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
         {
-          /*rainfed CFTs*/
-          s=findlandusetype(cell->standlist,SETASIDE_RF);
-
-          if(s!=NOT_FOUND)
-          {
-            setasidestand=getstand(cell->standlist,s);
-            if(cell->ml.cropdates[cft].fallow<=0 &&
-              check_lu(cell->standlist,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
-            {
-              if(!alloc_today_rf)
-              {
-                allocation_today(setasidestand, config->ntypes);
-                alloc_today_rf=TRUE;
-              }
-              flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                    cell->ml.cropdates[cft].vern_date20,
-                                    cell->ml.landfrac[0].crop[cft],FALSE,day,FALSE,
-                                    setasidestand,istimber,config->irrig_scenario,
-                                    npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-              cell->output.sdate[cft]=day;
-#endif
-              if(config->sdate_option==FIXED_SDATE)
-                cell->ml.sdate_fixed[cft]=day;
-            }
-          } /*of rainfed CFTs*/
-          /*irrigated CFTs*/
-          s=findlandusetype(cell->standlist,SETASIDE_IR);
-
-          if(s!=NOT_FOUND)
-          {
-            setasidestand=getstand(cell->standlist,s);if(cell->ml.cropdates[cft].fallow_irrig<=0 &&
-              check_lu(cell->standlist,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
-            {
-              if(!alloc_today_ir)
-              {
-                allocation_today(setasidestand,config->ntypes);
-                alloc_today_ir=TRUE;
-              }
-              flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                    cell->ml.cropdates[cft].vern_date20,
-                                    cell->ml.landfrac[1].crop[cft],TRUE,day,FALSE,
-                                    setasidestand,istimber,config->irrig_scenario,
-                                    npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-              cell->output.sdate[cft+ncft]=day;
-#endif
-              if(config->sdate_option==FIXED_SDATE)
-                cell->ml.sdate_fixed[cft+ncft]=day;
-            }
-          } /*of irrigated CFTs*/
+          flux_estab+=sowcrop(cell,getstand(cell->standlist,s),FALSE,FALSE,
+                              &alloc_today_rf,istimber,cft,day,npft,ncft,year,config);
+          /* set-aside stands may have been changed by sowing */
+          s=findlandusetype(cell,SETASIDE_RF);
+          s2=findlandusetype(cell,SETASIDE_IR);
         }
-      } /*of no seasonality*/
-
-      if (cell->ml.seasonality_type==PREC || cell->ml.seasonality_type==PRECTEMP) /*precipitation-dependent rules*/
-      {
-        s=findlandusetype(cell->standlist,SETASIDE_RF);
-
-        if(s!=NOT_FOUND)
+        /*irrigated CFTs*/
+        if(s2!=NOT_FOUND && cell->ml.cropdates[cft].fallow_irrig<=0 &&
+           check_lu(cell,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
         {
-          setasidestand=getstand(cell->standlist,s);
-          if (month==cell->ml.sowing_month[cft] && (dprec > MIN_PREC || dayofmonth==ndaymonth[month-1])) /*no irrigation, first wet day*/
-          {
-            if(cell->ml.cropdates[cft].fallow<=0 &&
-              check_lu(cell->standlist,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
-            {
-              if(!alloc_today_rf)
-              {
-                allocation_today(setasidestand,config->ntypes);
-                alloc_today_rf=TRUE;
-              }
-              flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                    cell->ml.cropdates[cft].vern_date20,
-                                    cell->ml.landfrac[0].crop[cft],FALSE,day,FALSE,
-                                    setasidestand,istimber,config->irrig_scenario,
-                                    npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-              cell->output.sdate[cft]=day;
-#endif
-              if(config->sdate_option==FIXED_SDATE)
-                cell->ml.sdate_fixed[cft]=day;
-            }
-          }
+          flux_estab+=sowcrop(cell,getstand(cell->standlist,s2),TRUE,FALSE,
+                              &alloc_today_ir,istimber,cft,day,npft,ncft,year,config);
+          s=findlandusetype(cell,SETASIDE_RF);
+          s2=findlandusetype(cell,SETASIDE_IR);
         }
-        s=findlandusetype(cell->standlist,SETASIDE_IR);
-
-        if(s!=NOT_FOUND)
-        {
-          setasidestand=getstand(cell->standlist,s);
-          if (month==cell->ml.sowing_month[cft+ncft] && (dprec > MIN_PREC || dayofmonth==ndaymonth[month-1])) /*irrigation, first wet day*/ 
-          {
-            if(cell->ml.cropdates[cft].fallow_irrig<=0 &&
-              check_lu(cell->standlist,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
-            {
-              if(!alloc_today_ir)
-              {
-                allocation_today(setasidestand,config->ntypes);
-                alloc_today_ir=TRUE;
-              }
-              flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                    cell->ml.cropdates[cft].vern_date20,
-                                    cell->ml.landfrac[1].crop[cft],TRUE,day,FALSE,
-                                    setasidestand,istimber,config->irrig_scenario,
-                                    npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-              cell->output.sdate[cft+ncft]=day;
-#endif
-              if(config->sdate_option==FIXED_SDATE)
-                cell->ml.sdate_fixed[cft+ncft]=day;
-            }
-          }
-        }
-      } /*of precipitation seasonality*/
-
-      if (cell->ml.seasonality_type==TEMP || cell->ml.seasonality_type==TEMPPREC) /*temperature-dependent rule*/
+      }
+    } /*of no seasonality*/
+    else if (cell->ml.seasonality_type==PREC || cell->ml.seasonality_type==PRECTEMP) /*precipitation-dependent rules*/
+    {
+      if(s!=NOT_FOUND && month==cell->ml.sowing_month[cft] && (dprec > MIN_PREC || dayofmonth==ndaymonth[month-1]) && /*no irrigation, first wet day*/
+         cell->ml.cropdates[cft].fallow<=0 &&
+         check_lu(cell,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
       {
-        s=findlandusetype(cell->standlist,SETASIDE_RF);
-
-        if(s!=NOT_FOUND)
-        {
-          setasidestand=getstand(cell->standlist,s);
-          if (month==cell->ml.sowing_month[cft]) /*no irrigation*/
-          {
-            m = month-1; /*m runs from 0 to 11*/
-            mm = (m-1 < 0) ? NMONTH-1 : m-1; /*mm is the month before*/
-            if (cell->climbuf.mtemp20[mm] > cell->climbuf.mtemp20[m] && croppar->calcmethod_sdate==TEMP_WTYP_CALC_SDATE)
-            {
-              /*calculate day when temperature exceeds or falls below a crop-specific temperature threshold - from former function calc_cropdates*/
-              if(((cell->climbuf.temp[NDAYS-1]<croppar->temp_fall)
-                &&(cell->climbuf.temp[NDAYS-2]>=croppar->temp_fall || dayofmonth==1)) || dayofmonth==ndaymonth[m]) /*sow winter variety*/
-              {
-                if(cell->ml.cropdates[cft].fallow<=0 &&
-                  check_lu(cell->standlist,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
-                {
-                  if(!alloc_today_rf)
-                  {
-                    allocation_today(setasidestand, config->ntypes);
-                    alloc_today_rf=TRUE;
-                  }
-                  flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                        cell->ml.cropdates[cft].vern_date20,
-                                        cell->ml.landfrac[0].crop[cft],FALSE,day,TRUE,
-                                        setasidestand,istimber,config->irrig_scenario,
-                                        npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-                  cell->output.sdate[cft]=day;
-#endif
-                  if(config->sdate_option==FIXED_SDATE)
-                    cell->ml.sdate_fixed[cft]=day;
-                }
-              }
-            }
-            else if (((cell->climbuf.temp[NDAYS-1]>croppar->temp_spring)
-              &&(cell->climbuf.temp[NDAYS-2]<=croppar->temp_spring || dayofmonth==1)) || dayofmonth==ndaymonth[m]) /*sow summer variety */
-            {
-              if(cell->ml.cropdates[cft].fallow<=0 &&
-                check_lu(cell->standlist,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
-              {
-                if(!alloc_today_rf)
-                {
-                  allocation_today(setasidestand, config->ntypes);
-                  alloc_today_rf=TRUE;
-                }
-                flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                      cell->ml.cropdates[cft].vern_date20,
-                                      cell->ml.landfrac[0].crop[cft],FALSE,day,FALSE,
-                                      setasidestand,istimber,config->irrig_scenario,
-                                      npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-                cell->output.sdate[cft]=day;
-#endif
-                if(config->sdate_option==FIXED_SDATE)
-                  cell->ml.sdate_fixed[cft]=day;
-              }
-            } /*of cultivating summer variety*/
-          } /*of if month==ml.sowing_month[cft]*/
-        }
-        s=findlandusetype(cell->standlist,SETASIDE_IR);
-
-        if(s!=NOT_FOUND)
-        {
-          setasidestand=getstand(cell->standlist,s);
-
-          if (month==cell->ml.sowing_month[cft+ncft]) /*irrigation*/
-          {
-            m = month-1; /*m runs from 0 to 11*/
-            mm = (m-1 < 0) ? NMONTH-1 : m-1; /*mm is the month before*/
-            if (cell->climbuf.mtemp20[mm] > cell->climbuf.mtemp20[m] && croppar->calcmethod_sdate==TEMP_WTYP_CALC_SDATE)
-            {
-              /*calculate day when temperature exceeds or falls below a crop-specific temperature threshold - from former function calc_cropdates*/
-              if(((cell->climbuf.temp[NDAYS-1]<croppar->temp_fall)
-                &&(cell->climbuf.temp[NDAYS-2]>=croppar->temp_fall || dayofmonth==1)) || dayofmonth==ndaymonth[m]) /*sow winter variety*/
-              {
-                if(cell->ml.cropdates[cft].fallow_irrig<=0 &&
-                  check_lu(cell->standlist,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
-                {
-                  if(!alloc_today_ir)
-                  {
-                    allocation_today(setasidestand, config->ntypes);
-                    alloc_today_ir=TRUE;
-                  }
-                  flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                        cell->ml.cropdates[cft].vern_date20,
-                                        cell->ml.landfrac[1].crop[cft],TRUE,day,TRUE,
-                                        setasidestand,istimber,config->irrig_scenario,
-                                        npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-                  cell->output.sdate[cft+ncft]=day;
-#endif
-                  if(config->sdate_option==FIXED_SDATE)
-                    cell->ml.sdate_fixed[cft+ncft]=day;
-                }
-              }
-            }
-            else if (((cell->climbuf.temp[NDAYS-1]>croppar->temp_spring)
-              &&(cell->climbuf.temp[NDAYS-2]<=croppar->temp_spring || dayofmonth==1)) || dayofmonth==ndaymonth[m]) /*sow summer variety */
-            {
-              if(cell->ml.cropdates[cft].fallow_irrig<=0 &&
-                check_lu(cell->standlist,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
-              {
-                if(!alloc_today_ir)
-                {
-                  allocation_today(setasidestand, config->ntypes);
-                  alloc_today_ir=TRUE;
-                }
-                flux_estab+=cultivate(cell,config->pftpar+npft+cft,
-                                      cell->ml.cropdates[cft].vern_date20,
-                                      cell->ml.landfrac[1].crop[cft],TRUE,day,FALSE,
-                                      setasidestand,istimber,config->irrig_scenario,
-                                      npft+ncft,cft,year);
-#ifndef DOUBLE_HARVEST
-                cell->output.sdate[cft+ncft]=day;
-#endif
-                if(config->sdate_option==FIXED_SDATE)
-                  cell->ml.sdate_fixed[cft+ncft]=day;
-              }
-            } /*of cultivating summer variety*/
-          } /*of if month==ml.sowing_month[cft+ncft]*/
-        }
-      } /*of temperature seasonality or both seasonality*/
-    }  /*for(cft=...) */
-  }
+        flux_estab+=sowcrop(cell,getstand(cell->standlist,s),FALSE,FALSE,
+                            &alloc_today_rf,istimber,cft,day,npft,ncft,year,config);
+        s=findlandusetype(cell,SETASIDE_RF);
+        s2=findlandusetype(cell,SETASIDE_IR);
+      }
+      if(s2!=NOT_FOUND && month==cell->ml.sowing_month[cft+ncft] && (dprec > MIN_PREC || dayofmonth==ndaymonth[month-1]) && /*irrigation, first wet day*/
+         cell->ml.cropdates[cft].fallow_irrig<=0 &&
+         check_lu(cell,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
+      {
+        flux_estab+=sowcrop(cell,getstand(cell->standlist,s2),TRUE,FALSE,
+                            &alloc_today_ir,istimber,cft,day,npft,ncft,year,config);
+        s=findlandusetype(cell,SETASIDE_RF);
+        s2=findlandusetype(cell,SETASIDE_IR);
+      }
+    } /*of precipitation seasonality*/
+    else if (cell->ml.seasonality_type==TEMP || cell->ml.seasonality_type==TEMPPREC) /*temperature-dependent rule*/
+    {
+      if(s!=NOT_FOUND && month==cell->ml.sowing_month[cft] && /*no irrigation*/
+         istempsowing(cell,croppar,month,dayofmonth,&wtyp) &&
+         cell->ml.cropdates[cft].fallow<=0 &&
+         check_lu(cell,cell->ml.landfrac[0].crop[cft],npft+cft,FALSE))
+      {
+        flux_estab+=sowcrop(cell,getstand(cell->standlist,s),FALSE,wtyp,
+                            &alloc_today_rf,istimber,cft,day,npft,ncft,year,config);
+        s=findlandusetype(cell,SETASIDE_RF);
+        s2=findlandusetype(cell,SETASIDE_IR);
+      }
+      if(s2!=NOT_FOUND && month==cell->ml.sowing_month[cft+ncft] && /*irrigation*/
+         istempsowing(cell,croppar,month,dayofmonth,&wtyp) &&
+         cell->ml.cropdates[cft].fallow_irrig<=0 &&
+         check_lu(cell,cell->ml.landfrac[1].crop[cft],npft+cft,TRUE))
+      {
+        flux_estab+=sowcrop(cell,getstand(cell->standlist,s2),TRUE,wtyp,
+                            &alloc_today_ir,istimber,cft,day,npft,ncft,year,config);
+        s=findlandusetype(cell,SETASIDE_RF);
+        s2=findlandusetype(cell,SETASIDE_IR);
+      }
+    } /*of temperature seasonality or both seasonality*/
+  }  /*for(cft=...) */
   return flux_estab;
 } /* of 'sowing_season' */
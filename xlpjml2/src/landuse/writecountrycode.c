@@ -51,23 +51,26 @@ int writecountrycode(Outputfile *output, /**< output file array */
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,vec,MPI_SHORT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,vec,MPI_SHORT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,vec,MPI_SHORT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,vec,MPI_SHORT,output->plan);
           break;
         case CDF:
-          mpi_write_netcdf(&output->files[index].fp.cdf,vec,MPI_SHORT,config->total,
-                           NO_TIME,
-                           output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_netcdf(&output->files[index].fp.cdf,vec,MPI_SHORT,NO_TIME,
+                           output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      mpi_write_socket(output->socket,vec,MPI_SHORT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      if(config->socket_version==2)
+        mpi_add_sendbuffer(output->sendbuf,index,0,LPJ_SHORT,vec,MPI_SHORT,
+                           output->plan->size,output->plan->counts,
+                           output->plan->offsets,config->rank,config->comm);
+      else
+        mpi_write_socket(output->socket,vec,MPI_SHORT,output->plan->size,
+                         output->plan->counts,output->plan->offsets,config->rank,
+                         config->comm);
       break;
    
   } /* of 'switch' */
@@ -88,6 +91,8 @@ int writecountrycode(Outputfile *output, /**< output file array */
         write_short_netcdf(&output->files[index].fp.cdf,vec,NO_TIME,count);
         break;
     }
+  else if(output->sendbuf!=NULL)
+    add_sendbuffer(output->sendbuf,index,0,LPJ_SHORT,vec,count);
   else
     writeshort_socket(output->socket,vec,count);
 #endif
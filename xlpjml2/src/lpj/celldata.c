@@ -16,6 +16,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 
 struct celldata
@@ -37,6 +39,7 @@ struct celldata
   {
     Bool swap;
     size_t offset;
+    int firstcell;
     FILE *file;
   } runoff2ocean_map;
 };
@@ -114,6 +117,7 @@ Celldata opencelldata(Config *config /**< LPJmL configuration */
       free(celldata);
       return NULL;
     }
+    celldata->runoff2ocean_map.firstcell=header.firstcell;
   }
   else
     celldata->runoff2ocean_map.file=NULL;
@@ -154,7 +158,7 @@ Bool seekcelldata(Celldata celldata, /**< pointer to celldata */
     }
   }
   if(celldata->runoff2ocean_map.file!=NULL)
-    fseek(celldata->runoff2ocean_map.file,startgrid*sizeof(Intcoord)+celldata->runoff2ocean_map.offset,SEEK_CUR);
+    fseek(celldata->runoff2ocean_map.file,(startgrid-celldata->runoff2ocean_map.firstcell)*sizeof(Intcoord)+celldata->runoff2ocean_map.offset,SEEK_CUR);
   return FALSE;
 } /* of 'seekcelldata' */
 
@@ -206,6 +210,64 @@ Bool readcelldata(Celldata celldata, /**< pointer to celldata */
   return FALSE;
 } /* of 'readcelldata' */
 
+Bool readallcelldata(Celldata celldata,     /**< pointer to celldata */
+                     Cell grid[],           /**< cell array */
+                     unsigned int soilcode[], /**< soil codes of all cells */
+                     Config *config         /**< LPJmL configuration */
+                    )                       /** \return TRUE on error */
+{
+  /* Function reads coordinates and soil codes of all cells of this task */
+  Coord *coords;
+  int cell;
+  if(celldata->soil_fmt==CDF)
+  {
+    /* netCDF coordinates can only be read cell by cell */
+    for(cell=0;cell<config->ngridcell;cell++)
+      if(readcelldata(celldata,&grid[cell].coord,soilcode+cell,
+                      &grid[cell].discharge.runoff2ocean_coord,cell,config))
+        return TRUE;
+    return FALSE;
+  }
+  if(config->ngridcell==0)
+    return FALSE;
+  coords=newvec(Coord,config->ngridcell);
+  if(coords==NULL)
+  {
+    printallocerr("coords");
+    return TRUE;
+  }
+  if(readcoords(celldata->soil.bin.file_coord,coords,config->ngridcell,
+                &config->resolution))
+  {
+    fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cells %d-%d.\n",
+            config->coord_filename.name,config->startgrid,config->startgrid+config->ngridcell-1);
+    free(coords);
+    return TRUE;
+  }
+  for(cell=0;cell<config->ngridcell;cell++)
+    grid[cell].coord=coords[cell];
+  free(coords);
+  if(readuintvec(celldata->soil.bin.file,soilcode,config->ngridcell,
+                 celldata->soil.bin.swap,celldata->soil.bin.type))
+  {
+    fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cells %d-%d.\n",
+            config->soil_filename.name,config->startgrid,config->startgrid+config->ngridcell-1);
+    return TRUE;
+  }
+  if(celldata->runoff2ocean_map.file!=NULL)
+    for(cell=0;cell<config->ngridcell;cell++)
+    {
+      fread(&grid[cell].discharge.runoff2ocean_coord,sizeof(Intcoord),1,
+            celldata->runoff2ocean_map.file);
+      if(celldata->runoff2ocean_map.swap)
+      {
+        grid[cell].discharge.runoff2ocean_coord.lon=swapshort(grid[cell].discharge.runoff2ocean_coord.lon);
+        grid[cell].discharge.runoff2ocean_coord.lat=swapshort(grid[cell].discharge.runoff2ocean_coord.lat);
+      }
+    }
+  return FALSE;
+} /* of 'readallcelldata' */
+
 void closecelldata(Celldata celldata /**< pointer to celldata */
                   )
 {
@@ -0,0 +1,223 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                          e  n  s  e  m  b  l  e  .  c                          \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions for ensemble runs sharing input data. All members                \n**/
+/**     are simulated on the same grid with the same climate, land use             \n**/
+/**     and water use input, but may differ in LPJmL and PFT parameters            \n**/
+/**     and in the CO2 scenario                                                    \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define MEMBER_PREFIX "member%d_" /* prefix of output filenames */
+
+static Bool isequalfilename(const Filename *name1,const Filename *name2)
+{
+  if(name1->name==NULL || name2->name==NULL)
+    return name1->name==name2->name;
+  if(name1->fmt!=name2->fmt || strcmp(name1->name,name2->name))
+    return FALSE;
+  if(name1->fmt==CDF && name1->var!=NULL && name2->var!=NULL)
+    return !strcmp(name1->var,name2->var);
+  return TRUE;
+} /* of 'isequalfilename' */
+
+static char *addprefix(const char *filename,int member)
+{
+  String prefix;
+  const char *name;
+  char *s;
+  snprintf(prefix,STRING_LEN,MEMBER_PREFIX,member);
+  name=strippath(filename);
+  s=malloc(strlen(filename)+strlen(prefix)+1);
+  if(s==NULL)
+    return NULL;
+  strncpy(s,filename,name-filename);
+  strcpy(s+(name-filename),prefix);
+  return strcat(s,name);
+} /* of 'addprefix' */
+
+#define checkfilename(name,what) if(!isequalfilename(&config[0].name,&config[i].name))\
+  {\
+    if(isroot(config[0]))\
+      fprintf(stderr,"ERROR250: Input file for %s of member %d differs from member 0 in ensemble run.\n",what,i);\
+    return TRUE;\
+  }
+#define checkvalue(var,what) if(config[0].var!=config[i].var)\
+  {\
+    if(isroot(config[0]))\
+      fprintf(stderr,"ERROR250: Setting for %s of member %d differs from member 0 in ensemble run.\n",what,i);\
+    return TRUE;\
+  }
+
+Bool checkensemble(const Config config[], /**< LPJ configuration of members */
+                   int n                  /**< number of ensemble members */
+                  )                       /** \return TRUE on error */
+{
+  /*
+   * Function checks whether all members can share input data and
+   * grid decomposition
+   */
+  int i,t;
+#ifdef IMAGE
+  if(config[0].sim_id==LPJML_IMAGE)
+  {
+    if(isroot(config[0]))
+      fputs("ERROR251: IMAGE coupler not supported in ensemble run.\n",stderr);
+    return TRUE;
+  }
+#endif
+  for(i=0;i<n;i++)
+    if(ischeckpointrestart(config+i))
+    {
+      if(isroot(config[0]))
+        fprintf(stderr,"ERROR251: Checkpoint restart of member %d not supported in ensemble run.\n",i);
+      return TRUE;
+    }
+  for(i=1;i<n;i++)
+  {
+    checkvalue(startgrid,"startgrid");
+    checkvalue(ngridcell,"number of grid cells");
+    checkvalue(firstyear,"first year");
+    checkvalue(lastyear,"last year");
+    checkvalue(nspinup,"spinup years");
+    if(config[0].nspinup)
+    {
+      checkvalue(nspinyear,"spinup cycle length");
+      checkvalue(isfirstspinupyear,"first spinup year");
+      if(config[0].isfirstspinupyear)
+        checkvalue(firstspinupyear,"first spinup year");
+    }
+    checkvalue(outputyear,"first output year");
+    checkvalue(sim_id,"simulation type");
+    checkvalue(with_radiation,"radiation");
+    checkvalue(fire,"fire");
+    checkvalue(ispopulation,"population");
+    checkvalue(prescribe_burntarea,"prescribed burnt area");
+    checkvalue(prescribe_landcover,"prescribed land cover");
+    checkvalue(river_routing,"river routing");
+    checkvalue(withlanduse,"land use");
+    checkvalue(wateruse,"water use");
+    checkvalue(seed,"random seed");
+    checkvalue(ntypes,"number of PFT classes");
+    for(t=0;t<config[0].ntypes;t++)
+      checkvalue(npft[t],"number of PFTs");
+    checkfilename(temp_filename,"temperature");
+    checkfilename(prec_filename,"precipitation");
+    checkfilename(wet_filename,"wet days");
+    if(config[0].with_radiation)
+    {
+      if(config[0].with_radiation!=RADIATION_SWONLY)
+        checkfilename(lwnet_filename,"long wave radiation");
+      checkfilename(swdown_filename,"short wave radiation");
+    }
+    else
+      checkfilename(cloud_filename,"cloudiness");
+    if(config[0].fire==SPITFIRE || config[0].fire==SPITFIRE_TMAX)
+    {
+      checkfilename(wind_filename,"wind speed");
+      checkfilename(tamp_filename,"temperature amplitude");
+      checkfilename(tmax_filename,"maximum temperature");
+      checkfilename(lightning_filename,"lightning");
+      checkfilename(human_ignition_filename,"human ignition");
+    }
+    if(config[0].ispopulation)
+      checkfilename(popdens_filename,"population density");
+    if(config[0].prescribe_burntarea)
+      checkfilename(burntarea_filename,"burnt area");
+    if(config[0].prescribe_landcover!=NO_LANDCOVER)
+      checkfilename(landcover_filename,"land cover");
+    if(config[0].withlanduse!=NO_LANDUSE)
+    {
+      checkvalue(irrig_scenario,"irrigation");
+      checkvalue(sdate_option,"sowing date option");
+      checkvalue(landuse_year_const,"constant land use year");
+      checkfilename(landuse_filename,"land use");
+      if(config[0].sdate_option==PRESCRIBED_SDATE)
+        checkfilename(sdate_filename,"sowing dates");
+    }
+    if(config[0].wateruse)
+      checkfilename(wateruse_filename,"water use");
+  }
+  return FALSE;
+} /* of 'checkensemble' */
+
+Bool setensemblemember(Config *config, /**< LPJ configuration of member */
+                       int member      /**< index of ensemble member */
+                      )                /** \return TRUE on error */
+{
+  /*
+   * Function adds member prefix to output and restart filenames,
+   * restart file read is shared by all members
+   */
+  int i;
+  char *name;
+  for(i=0;i<config->n_out;i++)
+  {
+    name=addprefix(config->outputvars[i].filename.name,member);
+    if(name==NULL)
+    {
+      printallocerr("name");
+      return TRUE;
+    }
+    free(config->outputvars[i].filename.name);
+    config->outputvars[i].filename.name=name;
+  }
+  if(iswriterestart(config))
+  {
+    name=addprefix(config->write_restart_filename,member);
+    if(name==NULL)
+    {
+      printallocerr("name");
+      return TRUE;
+    }
+    free(config->write_restart_filename);
+    config->write_restart_filename=name;
+  }
+  return FALSE;
+} /* of 'setensemblemember' */
+
+void copylanduse(Cell grid[],          /**< cell array of member */
+                 const Cell src[],     /**< cell array land use was read in */
+                 int ncft,             /**< number of crop PFTs */
+                 const Config *config  /**< LPJ configuration */
+                )
+{
+  int cell,i;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    for(i=0;i<WIRRIG;i++)
+    {
+      memcpy(grid[cell].ml.landfrac[i].crop,src[cell].ml.landfrac[i].crop,sizeof(Real)*ncft);
+      memcpy(grid[cell].ml.landfrac[i].grass,src[cell].ml.landfrac[i].grass,sizeof(Real)*NGRASS);
+      grid[cell].ml.landfrac[i].biomass_grass=src[cell].ml.landfrac[i].biomass_grass;
+      grid[cell].ml.landfrac[i].biomass_tree=src[cell].ml.landfrac[i].biomass_tree;
+    }
+    memcpy(grid[cell].ml.irrig_system->crop,src[cell].ml.irrig_system->crop,sizeof(int)*ncft);
+    memcpy(grid[cell].ml.irrig_system->grass,src[cell].ml.irrig_system->grass,sizeof(int)*NGRASS);
+    grid[cell].ml.irrig_system->biomass_grass=src[cell].ml.irrig_system->biomass_grass;
+    grid[cell].ml.irrig_system->biomass_tree=src[cell].ml.irrig_system->biomass_tree;
+    if(!grid[cell].skip && config->sdate_option==PRESCRIBED_SDATE)
+      memcpy(grid[cell].ml.sdate_fixed,src[cell].ml.sdate_fixed,sizeof(int)*2*ncft);
+  }
+} /* of 'copylanduse' */
+
+void copywateruse(Cell grid[],          /**< cell array of member */
+                  const Cell src[],     /**< cell array water use was read in */
+                  const Config *config  /**< LPJ configuration */
+                 )
+{
+  int cell;
+  for(cell=0;cell<config->ngridcell;cell++)
+    grid[cell].discharge.wateruse=src[cell].discharge.wateruse;
+} /* of 'copywateruse' */
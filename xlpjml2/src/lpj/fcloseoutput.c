@@ -94,15 +94,33 @@ void fcloseoutput(Outputfile *output,  /**< Output file array */
 #ifdef USE_MPI
   if(output->method!=LPJ_MPI2)
   {
-    free(output->counts);
-    free(output->offsets);
+    freegatherplan(output->plan);
+    freegatherplan(output->plan_all);
+    for(i=0;i<output->nplan_block;i++)
+      freegatherplan(output->plan_block[i]);
+    free(output->plan_block);
     if(output->method==LPJ_SOCKET && isroot(*config) && output->socket!=NULL)
+    {
+      close_sendbuffer(output->sendbuf);
       close_socket(output->socket);
+    }
   }
 #else
   if(output->method==LPJ_SOCKET && output->socket!=NULL)
+  {
+    close_sendbuffer(output->sendbuf);
     close_socket(output->socket);
+  }
 #endif
+  if(output->daily!=NULL)
+  {
+    for(i=0;i<=D_PET-D_LAI;i++)
+      free(output->daily[i]);
+    free(output->daily);
+  }
+  free(output->stage.data);
+  free(output->gather.data);
+  freeaggregate(output);
   free(output->files);
   freecoordarray(output->index);
   freecoordarray(output->index_all);
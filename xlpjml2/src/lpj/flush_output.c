@@ -0,0 +1,25 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                f  l  u  s  h  _  o  u  t  p  u  t  .  c                        \n**/
+/**                                                                                \n**/
+/**     Function sends buffered output of time step to socket                      \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool flush_output(Outputfile *output, /**< output file array */
+                  int year,           /**< simulation year (AD) */
+                  int step            /**< day, month or SOCKET_ANNUAL/SOCKET_INIT */
+                 )                    /** \return TRUE on error */
+{
+  if(output->sendbuf==NULL)
+    return FALSE;
+  return flush_sendbuffer(output->sendbuf,year,step);
+} /* of 'flush_output' */
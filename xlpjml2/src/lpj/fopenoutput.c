@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include <signal.h>
 #include "lpj.h"
 
@@ -53,6 +55,14 @@ static Bool create(Netcdf *cdf,const char *filename,int index,
                              array,config);
 } /* of 'create' */
 
+static size_t filesize(const Outputfile *output,int i,const Config *config)
+{
+  /* size of output written in one year, aggregated output has one value per bin */
+  if(config->outputvars[i].aggregate==NO_AGGREGATE)
+    return getsize(i,config);
+  return getsize(i,config)/config->total*output->aggregate[config->outputvars[i].aggregate].nbin;
+} /* of 'filesize' */
+
 static void openfile(Outputfile *output,const Cell grid[],
                      const char *filename,int i,
                      const Config *config)
@@ -109,7 +119,7 @@ static void openfile(Outputfile *output,const Cell grid[],
             {
               fseek(output->files[config->outputvars[i].id].fp.file,
                     headersize(LPJOUTPUT_HEADER,LPJOUTPUT_VERSION)+
-                    getsize(i,config)*(config->checkpointyear-config->outputyear+1),SEEK_SET);
+                    filesize(output,i,config)*(config->checkpointyear-config->outputyear+1),SEEK_SET);
             }
             else
               fseek(output->files[config->outputvars[i].id].fp.file,
@@ -126,9 +136,11 @@ static void openfile(Outputfile *output,const Cell grid[],
             header.firstyear=config->outputyear;
             if(config->outputvars[i].id==ADISCHARGE)
               header.ncell=config->nall;
+            else if(config->outputvars[i].aggregate!=NO_AGGREGATE)
+              header.ncell=output->aggregate[config->outputvars[i].aggregate].nbin;
             else
               header.ncell=config->total;
-            header.firstcell=config->firstgrid;
+            header.firstcell=(config->outputvars[i].aggregate==NO_AGGREGATE) ? config->firstgrid : 0;
             header.cellsize_lon=(float)config->resolution.lon;
             header.cellsize_lat=(float)config->resolution.lat;
             header.scalar=1;
@@ -168,7 +180,7 @@ static void openfile(Outputfile *output,const Cell grid[],
             if(config->checkpointyear>=config->outputyear)
             {
               fseek(output->files[config->outputvars[i].id].fp.file,
-                    getsize(i,config)*(config->checkpointyear-config->outputyear+1),SEEK_SET);
+                    filesize(output,i,config)*(config->checkpointyear-config->outputyear+1),SEEK_SET);
             }
           }
         }
@@ -197,7 +209,7 @@ Outputfile *fopenoutput(const Cell grid[], /**< LPJ grid */
 {
   int i;
 #ifdef USE_MPI
-  int count;
+  int *counts,*offsets;
 #endif
   Bool isopen;
   char *filename;
@@ -209,24 +221,38 @@ Outputfile *fopenoutput(const Cell grid[], /**< LPJ grid */
   check(output->files);
   output->n=n;
   output->index=output->index_all=NULL; 
+  output->socket=NULL;
+  output->sendbuf=NULL;
   for(i=0;i<n;i++)
+  {
     output->files[i].isopen=FALSE;
+    output->files[i].aggregate=NO_AGGREGATE;
+  }
   output->withdaily=FALSE;
+  output->daily=NULL;
+  output->daily_n=0;
+  output->stage.data=output->gather.data=NULL;
+  output->stage.size=output->gather.size=0;
+  output->aggregate=NULL;
+  output->area=NULL;
 #ifdef USE_MPI
+  output->plan_block=NULL;
+  output->nplan_block=0;
   if(output->method!=LPJ_MPI2)
   {
-    output->counts=newvec(int,config->ntask);
-    check(output->counts);
-    output->offsets=newvec(int,config->ntask);
-    check(output->offsets);
-    count=config->count;
-    MPI_Allgather(&count,1,MPI_INT,output->counts,1,MPI_INT,
-                  config->comm);
-    /* calculate array offsets */
-    output->offsets[0]=0;
-    for(i=1;i<config->ntask;i++)
-      output->offsets[i]=output->offsets[i-1]+output->counts[i-1];
+    /* gather plans are reused for all output steps */
+    output->plan=newgatherplan(config->count,config->comm);
+    counts=newvec(int,config->ntask);
+    check(counts);
+    offsets=newvec(int,config->ntask);
+    check(offsets);
+    getcounts(counts,offsets,config->nall,1,config->ntask);
+    output->plan_all=newgatherplan(counts[config->rank],config->comm);
+    free(counts);
+    free(offsets);
   }
+  else
+    output->plan=output->plan_all=NULL;
 #endif
   if(output->method==LPJ_SOCKET)
   {
@@ -244,8 +270,25 @@ Outputfile *fopenoutput(const Cell grid[], /**< LPJ grid */
         signal(SIGPIPE,handler);
 #endif
         isopen=TRUE;
-        write_socket(output->socket,"LPJ",3);
-        writeint_socket(output->socket,&config->total,1);
+        if(config->socket_version==2)
+        {
+          write_socket(output->socket,SOCKET_MAGIC2,3);
+          writeint_socket(output->socket,&config->total,1);
+          output->sendbuf=open_sendbuffer(output->socket,DEFAULT_NFRAME,
+                                          config->socket_rle);
+          if(output->sendbuf==NULL)
+          {
+            fputs("ERROR167: Cannot create send buffer for socket.\n",stderr);
+            close_socket(output->socket);
+            output->socket=NULL;
+            isopen=FALSE;
+          }
+        }
+        else
+        {
+          write_socket(output->socket,"LPJ",3);
+          writeint_socket(output->socket,&config->total,1);
+        }
       }
     }
 #ifdef USE_MPI
@@ -254,14 +297,19 @@ Outputfile *fopenoutput(const Cell grid[], /**< LPJ grid */
     if(!isopen)
     {
 #ifdef USE_MPI
-      output->counts=output->offsets=NULL;
+      freegatherplan(output->plan);
+      freegatherplan(output->plan_all);
+      output->plan=output->plan_all=NULL;
 #endif
       return output; 
     }
   }
   outputnames(output,config);
+  if(iserror(initaggregate(output,grid,config),config))
+    fail(INIT_INPUT_ERR,FALSE,"Cannot initialize aggregated output");
   for(i=0;i<config->n_out;i++)
   {
+    output->files[config->outputvars[i].id].aggregate=config->outputvars[i].aggregate;
     if(hassuffix(config->outputvars[i].filename.name,".gz"))
     { 
       output->files[config->outputvars[i].id].compress=TRUE;
@@ -328,6 +376,14 @@ Outputfile *fopenoutput(const Cell grid[], /**< LPJ grid */
     if(output->files[config->outputvars[i].id].isopen && isdailyoutput(config->outputvars[i].id))
       output->withdaily=TRUE;
   }
+  if(config->daily_buffer!=DAILY_NOBUFFER && output->method!=LPJ_SOCKET)
+  {
+    /* buffers are allocated at first write of daily output */
+    output->daily=newvec(float *,D_PET-D_LAI+1);
+    check(output->daily);
+    for(i=0;i<=D_PET-D_LAI;i++)
+      output->daily[i]=NULL;
+  }
   return output;
 } /* of 'fopenoutput' */
 
@@ -71,6 +71,8 @@ static size_t isnetcdfinput(const Config *config)
     width=max(width,strlen(config->popdens_filename.var));
   if(config->grassfix_filename.name!=NULL && config->grassfix_filename.fmt==CDF)
     width=max(width,strlen(config->grassfix_filename.var));
+  if(config->basin_filename.name!=NULL && config->basin_filename.fmt==CDF)
+    width=max(width,strlen(config->basin_filename.var));
   if(config->withlanduse!=NO_LANDUSE)
   {
     if(config->countrycode_filename.fmt==CDF)
@@ -133,6 +135,7 @@ static void printoutname(FILE *file,const char *filename,Bool isoneyear,
 } /* of printoutname' */
 
 static char *fmt[]={"raw","clm","clm2","txt","fms","meta","cdf"};
+static char *aggregate[]={"","country","region","basin"};
 
 static void printinputfile(FILE *file,const char *descr,const Filename *filename,
                            int width)
@@ -318,6 +321,8 @@ void fprintconfig(FILE *file,           /**< File pointer to text output file */
     printinputfile(file,"landcover",&config->landcover_filename,width);
   if(config->grassfix_filename.name!=NULL)
     printinputfile(file,"Grassfix",&config->grassfix_filename,width);
+  if(config->basin_filename.name!=NULL)
+    printinputfile(file,"basins",&config->basin_filename,width);
   if(config->withlanduse!=NO_LANDUSE)
   {
     printinputfile(file,"countries",&config->countrycode_filename,width);
@@ -378,6 +383,35 @@ void fprintconfig(FILE *file,           /**< File pointer to text output file */
 #endif
   if(config->wet_filename.name!=NULL)
     fprintf(file,"Random seed: %d\n",config->seed);
+  if(config->infil_solver==INFIL_ADAPTIVE)
+    fputs("Adaptive infiltration solver with step size control.\n",file);
+  else if(config->infil_solver==INFIL_VERIFY)
+    fputs("Infiltration solvers verified against each other.\n",file);
+  if(config->async_restart && iswriterestart(config))
+#ifdef _WIN32
+    fputs("Restart file written in the background not supported, written directly.\n",file);
+#else
+    fputs("Restart file written in the background.\n",file);
+#endif
+  if(config->daily_buffer==DAILY_MONTH)
+    fputs("Daily output written at end of each month.\n",file);
+  else if(config->daily_buffer==DAILY_YEAR)
+    fputs("Daily output written at end of each year.\n",file);
+  if(config->cellsel==CELLSEL_LIST)
+    fprintf(file,"Cell selection: %d cell(s) from list\n",config->cellsel_n);
+  else if(config->cellsel==CELLSEL_COUNTRY)
+    fprintf(file,"Cell selection: %d country code(s)\n",config->cellsel_n);
+  else if(config->cellsel==CELLSEL_BOX)
+    fprintf(file,"Cell selection: box %g,%g,%g,%g\n",config->cellsel_box[0],
+            config->cellsel_box[1],config->cellsel_box[2],config->cellsel_box[3]);
+  if(config->climate_buffer>1)
+    fprintf(file,"Years of climate data read at once: %d\n",config->climate_buffer);
+  if(config->nthreads>1)
+    fprintf(file,"Threads for grid initialization and annual phases: %d\n",config->nthreads);
+  if(config->dryrun)
+    fputs("Dry run, simulation is not started.\n",file);
+  if(config->memdump_filename!=NULL)
+    fprintf(file,"Memory report written to '%s'.\n",config->memdump_filename);
   if(config->n_out)
   {
     width=strlen("Variable");
@@ -397,7 +431,11 @@ void fprintconfig(FILE *file,           /**< File pointer to text output file */
             bigendian() ? "big endian" : "little endian",
             method[config->outputmethod]);
     if(config->outputmethod==LPJ_SOCKET)
+    {
       fprintf(file," to %s using port %d",config->hostname,config->port);
+      if(config->socket_version==2)
+        fprintf(file,", framed protocol%s",config->socket_rle ? " with compression" : "");
+    }
     fputc('\n',file);
     isnetcdf=FALSE;
     for(i=0;i<config->n_out;i++)
@@ -432,6 +470,8 @@ void fprintconfig(FILE *file,           /**< File pointer to text output file */
               width_unit,strlen(config->outnames[config->outputvars[i].id].unit)==0 ? "-" : config->outnames[config->outputvars[i].id].unit,
               typenames[getoutputtype(config->outputvars[i].id)]);
       printoutname(file,config->outputvars[i].filename.name,config->outputvars[i].oneyear,config);
+      if(config->outputvars[i].aggregate!=NO_AGGREGATE)
+        fprintf(file," (sum by %s)",aggregate[config->outputvars[i].aggregate]);
       putc('\n',file);
     }
     frepeatch(file,'-',width);
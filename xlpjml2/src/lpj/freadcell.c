@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 
 #define checkptr(ptr) if(ptr==NULL) { printallocerr(#ptr); return TRUE;}
@@ -70,6 +72,7 @@ Bool freadcell(FILE *file,             /**< File pointer to binary file */
                                    standtype,nstand,swap);
     if(cell->standlist==NULL)
       return TRUE;
+    updatestandindex(cell);
     freadreal1(&cell->ml.cropfrac_rf,swap,file);
     freadreal1(&cell->ml.cropfrac_ir,swap,file);
     freadclimbuf(file,&cell->climbuf,swap);
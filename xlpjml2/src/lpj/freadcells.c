@@ -0,0 +1,195 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                       f  r  e  a  d  c  e  l  l  s  .  c                       \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads cell data of all grid cells from restart file.              \n**/
+/**     File is memory mapped and cells are decoded in parallel.                   \n**/
+/**     Each cell is read from a stream limited to its byte range                  \n**/
+/**     given by the index vector of the restart file                              \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_GRID
+
+#include "lpj.h"
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+  const char *data;             /* mapped data of first cell */
+  const long long *index;       /* file offsets of cells */
+  Cell *grid;                   /* cell grid */
+  const unsigned int *soilcodes; /* soil codes of cells */
+  int first,last;               /* range of cells read */
+  int npft,ncft;                /* number of natural and crop PFTs */
+  const Standtype *standtype;   /* array of stand types */
+  int nstand;                   /* number of stand types */
+  Bool swap;                    /* byte order has to be changed */
+  const Config *config;         /* LPJ configuration */
+  int err;                      /* index of first cell not read or NOT_FOUND */
+} Restartdata;
+
+#ifndef _WIN32
+
+static void *readrange(void *arg)
+{
+  Restartdata *data;
+  FILE *file;
+  long size;
+  Bool rc;
+  int i;
+  data=arg;
+  data->err=NOT_FOUND;
+  for(i=data->first;i<data->last;i++)
+  {
+    size=(long)(data->index[i+1]-data->index[i]);
+    /* stream ends at end of cell, reading beyond fails */
+    file=fmemopen((void *)(data->data+data->index[i]-data->index[0]),size,"rb");
+    if(file==NULL)
+    {
+      data->err=i;
+      break;
+    }
+    rc=freadcell(file,data->grid+i,data->npft,data->ncft,
+                 data->config->soilpar+data->soilcodes[i]-1,
+                 data->standtype,data->nstand,data->swap,data->config);
+    /* all data of cell must have been read */
+    if(!rc && ftell(file)!=size)
+      rc=TRUE;
+    fclose(file);
+    if(rc)
+    {
+      data->err=i;
+      break;
+    }
+  }
+  return NULL;
+} /* of 'readrange' */
+
+#endif
+
+Bool freadcells(FILE *file,              /**< restart file positioned at first cell */
+                const long long index[], /**< file offsets of cells and end of last cell */
+                Cell grid[],             /**< cell grid */
+                const unsigned int soilcodes[], /**< soil codes of cells */
+                int npft,                /**< number of natural PFTs */
+                int ncft,                /**< number of crop PFTs */
+                const Standtype standtype[], /**< array of stand types */
+                int nstand,              /**< number of stand types */
+                Bool swap,               /**< byte order has to be changed */
+                const char *filename,    /**< filename of restart file */
+                const Config *config     /**< LPJ configuration */
+               )                         /** \return TRUE on error */
+{
+  int i,err;
+  long long filesize;
+#ifndef _WIN32
+  Restartdata *data;
+  int t,nthreads;
+  char *map;
+  long long start;
+  size_t len;
+  pthread_t *threads;
+  int nstarted;
+#endif
+  if(config->ngridcell<1)
+    return FALSE;
+  /* check that byte ranges of cells are inside file */
+  filesize=getfilesize(filename);
+  for(i=0;i<config->ngridcell;i++)
+    if(index[i]>=index[i+1] || index[i+1]>filesize)
+    {
+      fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
+              filename,i+config->startgrid);
+      return TRUE;
+    }
+  err=NOT_FOUND;
+#ifndef _WIN32
+  /* map byte range of cells, start of mapping must be page aligned */
+  start=index[0]-index[0]%sysconf(_SC_PAGESIZE);
+  len=(size_t)(index[config->ngridcell]-start);
+  map=mmap(NULL,len,PROT_READ,MAP_PRIVATE,fileno(file),start);
+  if(map!=MAP_FAILED)
+  {
+    nthreads=min(config->nthreads,config->ngridcell);
+    if(nthreads<1)
+      nthreads=1;
+    data=newvec(Restartdata,nthreads);
+    if(data==NULL)
+    {
+      printallocerr("data");
+      munmap(map,len);
+      return TRUE;
+    }
+    for(t=0;t<nthreads;t++)
+    {
+      data[t].data=map+index[0]-start;
+      data[t].index=index;
+      data[t].grid=grid;
+      data[t].soilcodes=soilcodes;
+      data[t].first=(int)((long long)config->ngridcell*t/nthreads);
+      data[t].last=(int)((long long)config->ngridcell*(t+1)/nthreads);
+      data[t].npft=npft;
+      data[t].ncft=ncft;
+      data[t].standtype=standtype;
+      data[t].nstand=nstand;
+      data[t].swap=swap;
+      data[t].config=config;
+    }
+    threads=NULL;
+    nstarted=1;
+    if(nthreads>1)
+    {
+      threads=newvec(pthread_t,nthreads-1);
+      if(threads!=NULL)
+        for(;nstarted<nthreads;nstarted++)
+          if(pthread_create(threads+nstarted-1,NULL,readrange,data+nstarted))
+            break;
+    }
+    /* ranges of threads that could not be created are read here */
+    for(t=nstarted;t<nthreads;t++)
+      readrange(data+t);
+    readrange(data);
+    for(t=1;t<nstarted;t++)
+      pthread_join(threads[t-1],NULL);
+    free(threads);
+    for(t=0;t<nthreads;t++)
+      if(data[t].err!=NOT_FOUND)
+      {
+        err=data[t].err;
+        break;
+      }
+    free(data);
+    munmap(map,len);
+  }
+  else
+#endif
+  {
+    /* read cells sequentially from file */
+    for(i=0;i<config->ngridcell;i++)
+      if(freadcell(file,grid+i,npft,ncft,config->soilpar+soilcodes[i]-1,
+                   standtype,nstand,swap,config))
+      {
+        err=i;
+        break;
+      }
+  }
+  if(err!=NOT_FOUND)
+  {
+    fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
+            filename,err+config->startgrid);
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'freadcells' */
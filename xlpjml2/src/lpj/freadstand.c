@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STAND
+
 #include "lpj.h"
 
 Stand *freadstand(FILE *file, /**< File pointer to binary file */
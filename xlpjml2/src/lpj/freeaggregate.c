@@ -0,0 +1,34 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                  f  r  e  e  a  g  g  r  e  g  a  t  e  .  c                   \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function deallocates bins of aggregated output                             \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void freeaggregate(Outputfile *output /**< output data */
+                  )
+{
+  int i;
+  if(output->aggregate!=NULL)
+  {
+    for(i=0;i<NAGGREGATE;i++)
+    {
+      free(output->aggregate[i].bin);
+      free(output->aggregate[i].sum);
+      free(output->aggregate[i].sum_all);
+    }
+    free(output->aggregate);
+  }
+  free(output->area);
+} /* of 'freeaggregate' */
@@ -33,6 +33,9 @@ void freeconfig(Config *config /**< LPJmL configuration */
   free(config->inputdir);
   free(config->restartdir);
   free(config->arglist);
+  free(config->cellsel_list);
+  free(config->cellsel_cells);
+  free(config->memdump_filename);
   free(config->sim_name);
   if(config->river_routing)
   {
@@ -83,6 +86,8 @@ void freeconfig(Config *config /**< LPJmL configuration */
     freefilename(config->popdens_filename);
   if(config->grassfix_filename.name!=NULL)
     freefilename(config->grassfix_filename);
+  if(config->basin_filename.name!=NULL)
+    freefilename(config->basin_filename);
   if(config->fire==SPITFIRE || config->fire==SPITFIRE_TMAX)
   {
     freefilename(config->wind_filename);
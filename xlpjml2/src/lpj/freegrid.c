@@ -72,5 +72,7 @@ void freegrid(Cell grid[],         /**< cell grid */
 #endif
     }
   } /* of 'for(cell=...)' */
+  free(config->activecell);
+  free(config->cellorder);
   free(grid);
 } /* of 'freegrid' */
@@ -17,5 +17,5 @@
 void freepft(Pft *pft /**< Pointer to pft being freed */
             ) 
 {
-  pft->par->free(pft); /* call type-specific free function */
+  (*pft->par->free)(pft); /* call type-specific free function */
 } /* of 'freepft' */
@@ -350,6 +350,28 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   {
     fscanbool2(file,&config->check_climate,"check_climate");
   }
+  if(iskeydefined(file,"climate_buffer"))
+  {
+    fscanint2(file,&config->climate_buffer,"climate_buffer");
+  }
+  if(iskeydefined(file,"infil_solver"))
+  {
+    fscanint2(file,&config->infil_solver,"infil_solver");
+    if(config->infil_solver<INFIL_SLUG || config->infil_solver>INFIL_VERIFY)
+    {
+      if(verbose)
+        fprintf(stderr,"ERROR253: Invalid infiltration solver %d.\n",
+                config->infil_solver);
+      return TRUE;
+    }
+  }
+  if(config->climate_buffer<1)
+  {
+    if(verbose)
+      fprintf(stderr,"ERROR252: Number of years %d in climate buffer must be greater than zero.\n",
+              config->climate_buffer);
+    return TRUE;
+  }
   if(iskeydefined(file,"inpath"))
   {
     if(fscanstring(file,name,"inpath",FALSE,verbose))
@@ -387,6 +409,12 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   {
     config->grassfix_filename.name = NULL;
   }
+  if(iskeydefined(&input,"basin"))
+  {
+    scanclimatefilename(&input,&config->basin_filename,config->inputdir,FALSE,"basin");
+  }
+  else
+    config->basin_filename.name=NULL;
   if(config->river_routing)
   {
     scanclimatefilename(&input,&config->lakes_filename,config->inputdir,FALSE,"lakes");
@@ -554,6 +582,9 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
               endgrid,config->startgrid);
     return TRUE;
   }
+  /* restrict grid range to bounding range of selected cells */
+  if(getcellselrange(&config->startgrid,&endgrid,config))
+    return TRUE;
   config->nall=endgrid-config->startgrid+1;
   config->firstgrid=config->startgrid;
   if(config->nall<config->ntask)
@@ -29,6 +29,52 @@ static Bool isopenoutput(int id,const Outputvar output[],int n)
   return FALSE; /* not found */
 } /* of 'isopenoutput' */
 
+static Bool fscanaggregate(LPJfile *file,Outputvar *var,const Config *config,
+                           Verbosity verbosity)
+{
+  /* reads optional aggregation of output, returns TRUE if setting is invalid */
+  var->aggregate=NO_AGGREGATE;
+  if(!iskeydefined(file,"aggregate"))
+    return FALSE;
+  if(fscanint(file,&var->aggregate,"aggregate",FALSE,verbosity))
+    return TRUE;
+  if(var->aggregate<NO_AGGREGATE || var->aggregate>=NAGGREGATE)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR259: Invalid value %d for aggregation of output '%s' in line %d of '%s'.\n",
+              var->aggregate,config->outnames[var->id].name,getlinecount(),getfilename());
+    return TRUE;
+  }
+  if(var->aggregate==NO_AGGREGATE)
+    return FALSE;
+  /* only scalar monthly and annual outputs written by writemonth() and writeannual() can be aggregated */
+  if(isdailyoutput(var->id) || var->id==ADISCHARGE || getoutputtype(var->id)!=LPJ_FLOAT ||
+     outputsize(var->id,config->npft[GRASS]+config->npft[TREE],config->nbiomass,config->npft[CROP])>1)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR260: Aggregation not supported for output '%s' in line %d of '%s'.\n",
+              config->outnames[var->id].name,getlinecount(),getfilename());
+    return TRUE;
+  }
+  if(var->oneyear || var->filename.fmt==CDF || config->outputmethod==LPJ_SOCKET || config->outputmethod==LPJ_MPI2)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR260: Aggregated output '%s' in line %d of '%s' requires raw, clm or text file written by task 0.\n",
+              config->outnames[var->id].name,getlinecount(),getfilename());
+    return TRUE;
+  }
+  if((var->aggregate==AGGREGATE_BASIN && config->basin_filename.name==NULL) ||
+     (var->aggregate!=AGGREGATE_BASIN && config->countrypar==NULL))
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR261: Aggregation of output '%s' in line %d of '%s' requires %s.\n",
+              config->outnames[var->id].name,getlinecount(),getfilename(),
+              (var->aggregate==AGGREGATE_BASIN) ? "basin input file" : "land use");
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'fscanaggregate' */
+
 Bool fscanoutput(LPJfile *file,     /**< pointer to LPJ file */
                  Config *config,    /**< LPJ configuration */
                  int nout_max       /**< maximum number of output files */
@@ -122,7 +168,7 @@ Bool fscanoutput(LPJfile *file,     /**< pointer to LPJ file */
           if(verbosity)
             fprintf(stderr,"ERRROR225: One year output not allowed for grid, country or region in line %d of '%s'.\n",getlinecount(),getfilename());
         }
-        else
+        else if(!fscanaggregate(&item,config->outputvars+count,config,verbosity))
         {
           if(isdailyoutput(flag))
             isdaily=TRUE;
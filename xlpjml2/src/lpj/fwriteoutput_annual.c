@@ -12,16 +12,16 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include "lpj.h"
 #include "grass.h"
 #include "tree.h"
 
 #define writeoutputvar(index,name) if(isopen(output,index))\
   {\
-    count=0;\
-    for(cell=0;cell<config->ngridcell;cell++)\
-      if(!grid[cell].skip)\
-        vec[count++]=(float)(grid[cell].output.name);\
+    foreachactivecell(count,cell,config)\
+      vec[count]=(float)(grid[cell].output.name);\
     writeannual(output,index,vec,year,config);\
   }
 
@@ -32,6 +32,11 @@ static void writeannual(Outputfile *output,int index,float data[],int year,
 #ifdef USE_MPI
   MPI_Status status;
 #endif
+  if(output->files[index].aggregate!=NO_AGGREGATE)
+  {
+    writeaggregate(output,index,data,config);
+    return;
+  }
   for(i=0;i<config->count;i++)
     data[i]=(float)(config->outnames[index].scale*data[i]+config->outnames[index].offset);
 #ifdef USE_MPI
@@ -46,25 +51,20 @@ static void writeannual(Outputfile *output,int index,float data[],int year,
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case CDF:
-          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,config->total,
+          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,
                            output->files[index].oneyear ? NO_TIME : year-config->outputyear,
-                           output->counts,output->offsets,config->rank,config->comm);
+                           output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data,MPI_FLOAT,output->plan,config);
       break;
   } /* of switch */
 #else
@@ -87,10 +87,7 @@ static void writeannual(Outputfile *output,int index,float data[],int year,
         break;
     }
   else
-  {
-    writeint_socket(output->socket,&index,1);
-    writefloat_socket(output->socket,data,config->count);
-  }
+    writeoutput_socket(output,index,0,LPJ_FLOAT,data,config->count);
 #endif
 } /* of 'writeannual' */
 
@@ -110,25 +107,20 @@ static void writeshortannual(Outputfile *output,int index,short data[],int year,
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_SHORT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_SHORT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_SHORT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_SHORT,output->plan);
           break;
         case CDF:
-          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_SHORT,config->total,
+          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_SHORT,
                            output->files[index].oneyear ? NO_TIME : year-config->outputyear,
-                           output->counts,output->offsets,config->rank,config->comm);
+                           output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_SHORT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      mpi_writeoutput_socket(output,index,0,LPJ_SHORT,data,MPI_SHORT,output->plan,config);
       break;
   } /* of switch */
 #else
@@ -151,10 +143,7 @@ static void writeshortannual(Outputfile *output,int index,short data[],int year,
         break;
     }
   else
-  {
-    writeint_socket(output->socket,&index,1);
-    writeshort_socket(output->socket,data,config->count);
-  }
+    writeoutput_socket(output,index,0,LPJ_SHORT,data,config->count);
 #endif
 } /* of 'writeshortannual' */
 
@@ -163,7 +152,6 @@ static void writeannualall(Outputfile *output,int index,float data[],int year,
 {
   int i;
 #ifdef USE_MPI
-  int *counts,*offsets;
   MPI_Status status;
 #endif
   for(i=0;i<config->ngridcell;i++)
@@ -177,42 +165,24 @@ static void writeannualall(Outputfile *output,int index,float data[],int year,
                         MPI_FLOAT,&status);
       break;
     case LPJ_GATHER:
-      counts=newvec(int,config->ntask);
-      check(counts);
-      offsets=newvec(int,config->ntask);
-      check(offsets);
-      getcounts(counts,offsets,config->nall,1,config->ntask);
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->nall,counts,
-                    offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,output->plan_all);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,config->nall,counts,
-                        offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,output->plan_all);
           break;
         case CDF:
-          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,config->nall,
+          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,
                            output->files[index].oneyear ? NO_TIME : year-config->outputyear,
-                           counts,offsets,config->rank,config->comm);
+                           output->plan_all);
           break;
       }
-      free(counts);
-      free(offsets);
       break;
     case LPJ_SOCKET:
-      counts=newvec(int,config->ntask);
-      check(counts);
-      offsets=newvec(int,config->ntask);
-      check(offsets);
-      getcounts(counts,offsets,config->nall,1,config->ntask);
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->nall,counts,
-                       offsets,config->rank,config->comm);
-      free(counts);
-      free(offsets);
+      mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data,MPI_FLOAT,output->plan_all,
+                             config);
       break;
   } /* of switch */
 #else
@@ -234,10 +204,7 @@ static void writeannualall(Outputfile *output,int index,float data[],int year,
         break;
     }
   else
-  {
-    writeint_socket(output->socket,&index,1);
-    writefloat_socket(output->socket,data,config->ngridcell);
-  }
+    writeoutput_socket(output,index,0,LPJ_FLOAT,data,config->ngridcell);
 #endif
 } /* of 'writeannualall' */
 
@@ -403,10 +370,8 @@ void fwriteoutput_annual(Outputfile *output,  /**< output file array */
   }
   if(isopen(output,APREC))
   {
-    count=0;
-    for(cell=0;cell<config->ngridcell;cell++)
-      if(!grid[cell].skip)
-        vec[count++]=(float)grid[cell].balance.aprec;
+    foreachactivecell(count,cell,config)
+      vec[count]=(float)grid[cell].balance.aprec;
     writeannual(output,APREC,vec,year,config);
   }
   writeoutputvar(INPUT_LAKE,input_lake*1e-9);
@@ -427,10 +392,8 @@ void fwriteoutput_annual(Outputfile *output,  /**< output file array */
   writeoutputvar(PRODUCT_POOL_SLOW,product_pool_slow);
   if(isopen(output,AFRAC_WD_UNSUST))
   {
-    count=0;
-    for(cell=0;cell<config->ngridcell;cell++)
-      if(!grid[cell].skip)
-         vec[count++]=(float)(grid[cell].output.awd_unsustainable/((grid[cell].output.airrig+
+    foreachactivecell(count,cell,config)
+       vec[count]=(float)(grid[cell].output.awd_unsustainable/((grid[cell].output.airrig+
             grid[cell].output.aconv_loss_evap + grid[cell].output.aconv_loss_drain)*grid[cell].coord.area));
     writeannual(output,AFRAC_WD_UNSUST,vec,year,config);
   }
@@ -12,8 +12,12 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include "lpj.h"
 
+#define MAXDAYMONTH 31 /* maximum number of days in month */
+
 static void writeday(Outputfile *output,int index,float *data,int year,int day,
                      const Config *config)
 {
@@ -35,33 +39,25 @@ static void writeday(Outputfile *output,int index,float *data,int year,int day,
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case CDF:
-          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,config->total,
+          mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,
                            output->files[index].oneyear ? day : (year-config->outputyear)*NDAYYEAR+day,
-                           output->counts,output->offsets,config->rank,config->comm);
+                           output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data,MPI_FLOAT,output->plan,config);
       break;
   } /* of switch */
 #else
   if(output->method==LPJ_SOCKET)
-  {
-    writeint_socket(output->socket,&index,1);
-    writefloat_socket(output->socket,data,config->count);
-  }
+    writeoutput_socket(output,index,0,LPJ_FLOAT,data,config->count);
   else
     switch(output->files[index].fmt)
     {
@@ -83,6 +79,134 @@ static void writeday(Outputfile *output,int index,float *data,int year,int day,
 #endif
 } /* of 'writeday' */
 
+static void writeblock(Outputfile *output,int index,float *data,int year,
+                       int first,int n,const Config *config)
+{
+  int i,day;
+#ifdef USE_MPI
+  MPI_Status status;
+  Gatherplan *plan;
+  int task;
+  float *vec,*dst;
+  switch(output->method)
+  {
+    case LPJ_MPI2:
+      for(day=0;day<n;day++)
+        MPI_File_write_at(output->files[index].fp.mpi_file,
+                          ((long)(year-config->outputyear)*NDAYYEAR+first+day)*config->total+config->offset,
+                          data+day*config->count,config->count,MPI_FLOAT,&status);
+      break;
+    case LPJ_GATHER:
+      /* all days of block are gathered with one collective call */
+      plan=getgatherplan(output,n,config);
+      vec=mpi_gather(plan,data,MPI_FLOAT);
+      if(isroot(*config))
+      {
+        /* reorder data from task to day order */
+        dst=getoutputbuffer(&output->gather,sizeof(float)*config->total*n);
+        for(task=0;task<config->ntask;task++)
+          for(day=0;day<n;day++)
+            memcpy(dst+day*config->total+output->plan->offsets[task],
+                   vec+plan->offsets[task]+day*output->plan->counts[task],
+                   sizeof(float)*output->plan->counts[task]);
+        switch(output->files[index].fmt)
+        {
+          case RAW: case CLM:
+            if(fwrite(dst,sizeof(float),config->total*n,output->files[index].fp.file)!=config->total*n)
+              fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
+            break;
+          case TXT:
+            for(day=0;day<n;day++)
+            {
+              for(i=0;i<config->total-1;i++)
+                fprintf(output->files[index].fp.file,"%g ",dst[day*config->total+i]);
+              fprintf(output->files[index].fp.file,"%g\n",dst[day*config->total+config->total-1]);
+            }
+            break;
+          case CDF:
+            write_float_block_netcdf(&output->files[index].fp.cdf,dst,
+                                     output->files[index].oneyear ? first : (year-config->outputyear)*NDAYYEAR+first,
+                                     n,config->total);
+            break;
+        }
+      }
+      break;
+    default:
+      break;
+  } /* of switch */
+#else
+  switch(output->files[index].fmt)
+  {
+    case RAW: case CLM:
+      if(fwrite(data,sizeof(float),config->count*n,output->files[index].fp.file)!=config->count*n)
+        fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
+      break;
+    case TXT:
+      for(day=0;day<n;day++)
+      {
+        for(i=0;i<config->count-1;i++)
+          fprintf(output->files[index].fp.file,"%g ",data[day*config->count+i]);
+        fprintf(output->files[index].fp.file,"%g\n",data[day*config->count+config->count-1]);
+      }
+      break;
+    case CDF:
+      write_float_block_netcdf(&output->files[index].fp.cdf,data,
+                               output->files[index].oneyear ? first : (year-config->outputyear)*NDAYYEAR+first,
+                               n,config->count);
+      break;
+  }
+#endif
+} /* of 'writeblock' */
+
+static Bool isblockend(int day,int block)
+{
+  int month,last;
+  if(block==DAILY_YEAR)
+    return day==NDAYYEAR-1;
+  last=-1;
+  for(month=0;month<NMONTH;month++)
+  {
+    last+=ndaymonth[month];
+    if(day==last)
+      return TRUE;
+  }
+  return FALSE;
+} /* of 'isblockend' */
+
+static void bufferday(Outputfile *output,const Cell grid[],int day,int year,
+                      const Config *config)
+{
+  int count,cell,i,index;
+  float *fvec;
+  if(output->daily_n==0)
+    output->daily_first=day;
+  index=0;
+  for(i=D_LAI;i<=D_PET;i++)
+  {
+    if(isopen(output,i))
+    {
+      if(output->daily[i-D_LAI]==NULL)
+      {
+        output->daily[i-D_LAI]=newvec(float,config->count*((config->daily_buffer==DAILY_YEAR) ? NDAYYEAR : MAXDAYMONTH));
+        check(output->daily[i-D_LAI]);
+      }
+      fvec=output->daily[i-D_LAI]+output->daily_n*config->count;
+      foreachactivecell(count,cell,config)
+        fvec[count]=config->outnames[i].scale*(float)((const Storereal *)(&grid[cell].output.daily))[index]+config->outnames[i].offset;
+    }
+    index++;
+  }
+  output->daily_n++;
+  if(isblockend(day,config->daily_buffer))
+  {
+    for(i=D_LAI;i<=D_PET;i++)
+      if(isopen(output,i))
+        writeblock(output,i,output->daily[i-D_LAI],year,output->daily_first,
+                   output->daily_n,config);
+    output->daily_n=0;
+  }
+} /* of 'bufferday' */
+
 void fwriteoutput_daily(Outputfile *output, /**< Output data */
                         const Cell grid[],  /**< LPJ cell array */
                         int day,            /**< day of year (0..364) */
@@ -93,6 +217,12 @@ void fwriteoutput_daily(Outputfile *output, /**< Output data */
   
   int count,cell,i,index;
   float *fvec;
+  if(output->daily!=NULL)
+  {
+    /* daily output is written at end of month or year */
+    bufferday(output,grid,day,year,config);
+    return;
+  }
   fvec=newvec(float,config->count);
   check(fvec);
   index=0;
@@ -100,11 +230,9 @@ void fwriteoutput_daily(Outputfile *output, /**< Output data */
   {
     if(isopen(output,i))
     {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-       if(!grid[cell].skip) 
-         fvec[count++]=(float)((Real *)(&grid[cell].output.daily))[index];
-       writeday(output,i,fvec,year,day,config);
+      foreachactivecell(count,cell,config)
+        fvec[count]=(float)((const Storereal *)(&grid[cell].output.daily))[index];
+      writeday(output,i,fvec,year,day,config);
     }
     index++;
   }
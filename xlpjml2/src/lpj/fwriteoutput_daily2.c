@@ -41,24 +41,20 @@ static void writeday(Outputfile *output,int index,float *data,int year,
           case RAW: case CLM:
             for(day=0;day<NDAYYEAR;day++)
               mpi_write(output->files[index].fp.file,data+config->count*day,MPI_FLOAT,
-                        config->total,output->counts,output->offsets,config->rank,
-                        config->comm);
+                        output->plan);
             break;
           case TXT:
             for(day=0;day<NDAYYEAR;day++)
               mpi_write_txt(output->files[index].fp.file,data+config->count*day,MPI_FLOAT,
-                            config->total,output->counts,output->offsets,config->rank,
-                            config->comm);
+                            output->plan);
             break;
           case CDF:
              for(day=0;day<NDAYYEAR;day++)
                 mpi_write_netcdf(&output->files[index].fp.cdf,
                                  data+config->count*day,
                                  MPI_FLOAT,
-                                 config->total,
                                  output->files[index].oneyear ? day : (year-config->firstyear)*NDAYYEAR+day,
-                                 output->counts,output->offsets,config->rank,
-                                 config->comm);
+                                 output->plan);
 
             break;
         }
@@ -66,21 +62,15 @@ static void writeday(Outputfile *output,int index,float *data,int year,
       case LPJ_SOCKET:
         for(day=0;day<NDAYYEAR;day++)
         {
-          if(isroot(*config))
-            writeint_socket(output->socket,&index,1);
-          mpi_write_socket(output->socket,data+config->count*day,MPI_FLOAT,
-                           config->total,output->counts,output->offsets,
-                           config->rank,config->comm);
+          mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data+config->count*day,
+                                 MPI_FLOAT,output->plan,config);
         }
         break;
     } /* of switch */
 #else
     if(output->method==LPJ_SOCKET)
       for(day=0;day<NDAYYEAR;day++)
-      {
-        writeint_socket(output->socket,&index,1);
-        writefloat_socket(output->socket,data+config->count*day,config->count);
-      }
+        writeoutput_socket(output,index,0,LPJ_FLOAT,data+config->count*day,config->count);
     else
       switch(output->files[index].fmt)
       {
@@ -14,17 +14,43 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include "lpj.h"
 
 #define writeoutputvar(index,name) if(isopen(output,index))\
   {\
-    count=0;\
-    for(cell=0;cell<config->ngridcell;cell++)\
-      if(!grid[cell].skip)\
-        fvec[count++]=(float)grid[cell].output.name;\
+    foreachactivecell(count,cell,config)\
+      fvec[count]=(float)grid[cell].output.name;\
     writemonth(output,index,fvec,year,month,config);\
   }
 
+/* Soil layers are written with one call, socket output is sent layer by layer */
+
+#define writeoutputlayers(index,name) if(isopen(output,index))\
+  {\
+    if(output->method==LPJ_SOCKET)\
+      for(l=0;l<NSOILLAYER;l++)\
+      {\
+        foreachactivecell(count,cell,config)\
+          fvec[count]=(float)grid[cell].output.name[l];\
+        writemonth2(output,index,fvec,year,month,l,NSOILLAYER,config);\
+      }\
+    else\
+    {\
+      vec=getoutputbuffer(&output->stage,sizeof(float)*config->count*NSOILLAYER);\
+      for(l=0;l<NSOILLAYER;l++)\
+      {\
+        foreachactivecell(count,cell,config)\
+          vec[config->count*l+count]=(float)grid[cell].output.name[l];\
+      }\
+      writelayers(output,index,vec,LPJ_FLOAT,NSOILLAYER,\
+                  (year-config->outputyear)*NMONTH+month,\
+                  output->files[index].oneyear ? month : (year-config->outputyear)*12+month,\
+                  config);\
+    }\
+  }
+
 static void writemonth(Outputfile *output,int index,float *data,int year,
                        int month,
                        const Config *config)
@@ -33,6 +59,11 @@ static void writemonth(Outputfile *output,int index,float *data,int year,
 #ifdef USE_MPI
   MPI_Status status;
 #endif
+  if(output->files[index].aggregate!=NO_AGGREGATE)
+  {
+    writeaggregate(output,index,data,config);
+    return;
+  }
   for(i=0;i<config->count;i++)
     data[i]=config->outnames[index].scale*data[i]+config->outnames[index].offset;
 #ifdef USE_MPI
@@ -47,35 +78,25 @@ static void writemonth(Outputfile *output,int index,float *data,int year,
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case CDF:
           mpi_write_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,
-                           config->total,
                            output->files[index].oneyear ? month : (year-config->outputyear)*12+month,
-                           output->counts,output->offsets,config->rank,
-                           config->comm);
+                           output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data,MPI_FLOAT,output->plan,config);
       break;
   } /* of switch */
 #else
   if(output->method==LPJ_SOCKET)
-  {
-    writeint_socket(output->socket,&index,1);
-    writefloat_socket(output->socket,data,config->count);
-  }
+    writeoutput_socket(output,index,0,LPJ_FLOAT,data,config->count);
   else
     switch(output->files[index].fmt)
     {
@@ -118,36 +139,26 @@ static void writemonth2(Outputfile *output,int index,float *data,int year,
       switch(output->files[index].fmt)
       {
         case RAW: case CLM:
-          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
+          mpi_write(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case TXT:
-          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
+          mpi_write_txt(output->files[index].fp.file,data,MPI_FLOAT,output->plan);
           break;
         case CDF:
           mpi_write_pft_netcdf(&output->files[index].fp.cdf,data,MPI_FLOAT,
-                               config->total,
                                output->files[index].oneyear ? month : (year-config->outputyear)*12+month,
                                layer,
-                               output->counts,output->offsets,config->rank,
-                               config->comm);
+                               output->plan);
           break;
       }
       break;
     case LPJ_SOCKET:
-      if(isroot(*config))
-        writeint_socket(output->socket,&index,1);
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
+      mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data,MPI_FLOAT,output->plan,config);
       break;
   } /* of switch */
 #else
   if(output->method==LPJ_SOCKET)
-  {
-    writeint_socket(output->socket,&index,1);
-    writefloat_socket(output->socket,data,config->count);
-  }
+    writeoutput_socket(output,index,0,LPJ_FLOAT,data,config->count);
   else
     switch(output->files[index].fmt)
     {
@@ -179,7 +190,7 @@ void fwriteoutput_monthly(Outputfile *output, /**< Output data */
 {
 
   int l,count,cell;
-  float *fvec;
+  float *fvec,*vec;
   fvec=newvec(float,config->count);
   check(fvec);
   writeoutputvar(MNPP,mnpp);
@@ -195,15 +206,7 @@ void fwriteoutput_monthly(Outputfile *output, /**< Output data */
   writeoutputvar(MINTERC,minterc);
   writeoutputvar(MINTERC_B,minterc_b);
   writeoutputvar(MPET,mpet);
-  if(isopen(output,MSWC))
-    for(l=0;l<NSOILLAYER;l++)
-    {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.mswc[l];
-      writemonth2(output,MSWC,fvec,year,month,l,NSOILLAYER,config);
-    }
+  writeoutputlayers(MSWC,mswc);
   writeoutputvar(MSWC1,mswc[0]);
   writeoutputvar(MSWC2,mswc[1]);
   writeoutputvar(MSWC3,mswc[2]);
@@ -229,15 +232,7 @@ void fwriteoutput_monthly(Outputfile *output, /**< Output data */
   writeoutputvar(MPREC_IMAGE,mprec_image);
   writeoutputvar(MSUN_IMAGE,msun_image);
   writeoutputvar(MWET_IMAGE,mwet_image);
-  if(isopen(output,MSOILTEMP))
-    for(l=0;l<NSOILLAYER;l++)
-    {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.msoiltemp[l];
-      writemonth2(output,MSOILTEMP,fvec,year,month,l,NSOILLAYER,config);
-    }
+  writeoutputlayers(MSOILTEMP,msoiltemp);
   writeoutputvar(MSOILTEMP1,msoiltemp[0]);
   writeoutputvar(MSOILTEMP2,msoiltemp[1]);
   writeoutputvar(MSOILTEMP3,msoiltemp[2]);
@@ -41,45 +41,35 @@ static void writemonth(Outputfile *output,int index,float *data,int year,
           case RAW: case CLM:
             for(month=0;month<NMONTH;month++)
               mpi_write(output->files[index].fp.file,data+config->count*month,
-                        MPI_FLOAT,config->total,output->counts,
-                        output->offsets,config->rank,config->comm);
+                        MPI_FLOAT,output->plan);
              break;
           case TXT:
             for(month=0;month<NMONTH;month++)
               mpi_write_txt(output->files[index].fp.file,data+config->count*month,
-                            MPI_FLOAT,config->total,output->counts,
-                            output->offsets,config->rank,config->comm);
+                            MPI_FLOAT,output->plan);
             break;
           case CDF:
             for(month=0;month<NMONTH;month++)
               mpi_write_netcdf(&output->files[index].fp.cdf,
                                data+config->count*month,
                                MPI_FLOAT,
-                               config->total,
                                output->files[index].oneyear ? month : (year-config->firstyear)*12+month,
-                               output->counts,output->offsets,config->rank,
-                               config->comm);
+                               output->plan);
              break;
         }
         break;
       case LPJ_SOCKET:
         for(month=0;month<NMONTH;month++)
         {
-          if(isroot(*config))
-            writeint_socket(output->socket,&index,1);
-          mpi_write_socket(output->socket,data+config->count*month,MPI_FLOAT,
-                           config->total,output->counts,output->offsets,
-                           config->rank,config->comm);
+          mpi_writeoutput_socket(output,index,0,LPJ_FLOAT,data+config->count*month,
+                                 MPI_FLOAT,output->plan,config);
         }
         break;
     } /* of switch */
 #else
     if(output->method==LPJ_SOCKET)
       for(month=0;month<NMONTH;month++)
-      {
-        writeint_socket(output->socket,&index,1);
-        writefloat_socket(output->socket,data+config->count*month,config->count);
-      }
+        writeoutput_socket(output,index,0,LPJ_FLOAT,data+config->count*month,config->count);
     else
       switch(output->files[index].fmt)
       {
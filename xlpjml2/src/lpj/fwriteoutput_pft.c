@@ -16,168 +16,32 @@
 
 #include "lpj.h"
 
+/* All layers of a variable are stored in one buffer and written at once */
+
 #define writeoutputvar(index,name,n) if(isopen(output,index))\
   {\
-    outindex(output,index,config->rank);\
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*(n));\
     for(i=0;i<n;i++)\
     {\
-      count=0;\
-      for(cell=0;cell<config->ngridcell;cell++)\
-        if(!grid[cell].skip)\
-          fvec[count++]=(float)grid[cell].output.name[i];\
-      writepft(output,index,fvec,n,year,i,config);\
+      foreachactivecell(count,cell,config)\
+        fvec[config->count*i+count]=(float)grid[cell].output.name[i];\
     }\
+    writelayers(output,index,fvec,LPJ_FLOAT,n,year-config->outputyear,\
+                output->files[index].oneyear ? NO_TIME : year-config->outputyear,config);\
   }
 
 #define writeoutputshortvar(index,name,n) if(isopen(output,index))\
   {\
-    outindex(output,index,config->rank);\
-    vec=newvec(short,config->count);\
-    check(vec);\
+    vec=getoutputbuffer(&output->stage,sizeof(short)*config->count*(n));\
     for(i=0;i<n;i++)\
     {\
-      count=0;\
-      for(cell=0;cell<config->ngridcell;cell++)\
-        if(!grid[cell].skip)\
-          vec[count++]=(short)grid[cell].output.name[i];\
-      writeshortpft(output,index,vec,n,year,i,config);\
+      foreachactivecell(count,cell,config)\
+        vec[config->count*i+count]=(short)grid[cell].output.name[i];\
     }\
-    free(vec);\
+    writelayers(output,index,vec,LPJ_SHORT,n,year-config->outputyear,\
+                year-config->outputyear,config);\
   }
 
-static void outindex(Outputfile *output,int index,int rank)
-{
-  if(output->method==LPJ_SOCKET && rank==0)
-    writeint_socket(output->socket,&index,1);
-} /* of 'outindex' */
-
-static void writepft(Outputfile *output,int n,float *data,int size,int year,
-                     int index,
-                     const Config *config)
-{
-  int i;
-#ifdef USE_MPI
-  MPI_Status status;
-#endif
-  for(i=0;i<config->count;i++)
-    data[i]=config->outnames[n].scale*data[i]+config->outnames[n].offset;
-#ifdef USE_MPI
-  switch(output->method)
-  {
-    case LPJ_MPI2:
-      MPI_File_write_at(output->files[n].fp.mpi_file,
-                        ((year-config->outputyear)*size+index)*config->total+config->offset,
-                        data,config->count,MPI_FLOAT,&status);
-      break;
-    case LPJ_GATHER:
-      switch(output->files[n].fmt)
-      {
-        case RAW: case CLM:
-          mpi_write(output->files[n].fp.file,data,MPI_FLOAT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
-          break;
-        case TXT:
-          mpi_write_txt(output->files[n].fp.file,data,MPI_FLOAT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
-          break;
-        case CDF:
-          mpi_write_pft_netcdf(&output->files[n].fp.cdf,data,MPI_FLOAT,config->total,
-                               output->files[n].oneyear ? NO_TIME : year-config->outputyear,
-                               index,
-                               output->counts,output->offsets,config->rank,config->comm);
-          break;
-      }
-      break;
-    case LPJ_SOCKET:
-      mpi_write_socket(output->socket,data,MPI_FLOAT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
-      break;
-  } /* of switch */
-#else
-  if(output->method==LPJ_FILES)
-    switch(output->files[n].fmt)
-    {
-      case RAW: case CLM:
-        if(fwrite(data,sizeof(float),config->count,output->files[n].fp.file)!=config->count)
-          fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
-        break;
-      case TXT:
-        for(i=0;i<config->count-1;i++)
-          fprintf(output->files[n].fp.file,"%g ",data[i]);
-        fprintf(output->files[n].fp.file,"%g\n",data[config->count-1]);
-        break;
-      case CDF:
-        write_pft_float_netcdf(&output->files[n].fp.cdf,data,
-                               output->files[n].oneyear ? NO_TIME : year-config->outputyear,
-                               index,config->count);
-        break;
-    }
-  else
-    writefloat_socket(output->socket,data,config->count);
-#endif
-} /* of *writepft' */
-
-static void writeshortpft(Outputfile *output,int n,short *data,int size,
-                          int year,
-                          int index,
-                          const Config *config)
-{
-#ifdef USE_MPI
-  MPI_Status status;
-  switch(output->method)
-  {
-    case LPJ_MPI2:
-      MPI_File_write_at(output->files[n].fp.mpi_file,
-                        ((year-config->outputyear)*size+index)*config->total+config->offset,
-                        data,config->count,MPI_SHORT,&status);
-      break;
-    case LPJ_GATHER:
-      switch(output->files[n].fmt)
-      {
-        case RAW: case CLM:
-          mpi_write(output->files[n].fp.file,data,MPI_SHORT,config->total,
-                    output->counts,output->offsets,config->rank,config->comm);
-          break;
-        case TXT:
-          mpi_write_txt(output->files[n].fp.file,data,MPI_SHORT,config->total,
-                        output->counts,output->offsets,config->rank,config->comm);
-          break;
-        case CDF:
-          mpi_write_pft_netcdf(&output->files[n].fp.cdf,data,MPI_SHORT,config->total,
-                               year-config->outputyear,index,
-                               output->counts,output->offsets,config->rank,config->comm);
-          break;
-      }
-      break;
-    case LPJ_SOCKET:
-      mpi_write_socket(output->socket,data,MPI_SHORT,config->total,
-                       output->counts,output->offsets,config->rank,config->comm);
-      break;
-  } /* of switch */
-   
-#else
-  int i;
-  if(output->method==LPJ_FILES)
-    switch(output->files[n].fmt)
-    {
-      case RAW: case CLM:
-        fwrite(data,sizeof(short),config->count,output->files[n].fp.file);
-        break;
-      case TXT:
-        for(i=0;i<config->count-1;i++)
-          fprintf(output->files[n].fp.file,"%d ",data[i]);
-        fprintf(output->files[n].fp.file,"%d\n",data[config->count-1]);
-        break;
-      case CDF:
-        write_pft_short_netcdf(&output->files[n].fp.cdf,data,
-                               year-config->outputyear,index,config->count);
-        break;
-    }
-  else
-    writeshort_socket(output->socket,data,config->count);
-#endif
-} /* of 'writeshortpft' */
-
 void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
                       Cell grid[],         /**< cell array */
                       int npft,            /**< number of natural PFTs */
@@ -192,12 +56,10 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
   Stand* stand;
   writeoutputshortvar(SDATE,sdate,2*ncft);
   writeoutputshortvar(HDATE,hdate,2*ncft);
-  fvec=newvec(float,config->count);
-  check(fvec);
   writeoutputvar(PFT_NPP,pft_npp,(npft-config->nbiomass)+(ncft+NGRASS+NBIOMASSTYPE)*2);
   if(isopen(output,PFT_GCGP))
   {
-    outindex(output,PFT_GCGP,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*((npft-config->nbiomass)+(ncft+NGRASS+NBIOMASSTYPE)*2));
     for(i=0;i<(npft-config->nbiomass)+(ncft+NGRASS+NBIOMASSTYPE)*2;i++)
     {
       count=0;
@@ -208,34 +70,36 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
             grid[cell].output.pft_gcgp[i]/=grid[cell].output.gcgp_count[i];
           else
             grid[cell].output.pft_gcgp[i]=-9;
-          fvec[count++]=(float)grid[cell].output.pft_gcgp[i];
+          fvec[config->count*i+count++]=(float)grid[cell].output.pft_gcgp[i];
         }
-      writepft(output,PFT_GCGP,fvec,(npft-config->nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE),year,i,config);
     }
+    writelayers(output,PFT_GCGP,fvec,LPJ_FLOAT,(npft-config->nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE),
+                year-config->outputyear,
+                output->files[PFT_GCGP].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   if(isopen(output,PFT_HARVEST))
   {
-    outindex(output,PFT_HARVEST,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*(ncft+NGRASS+NBIOMASSTYPE)*2);
     for(i=0;i<(ncft+NGRASS+NBIOMASSTYPE)*2;i++)
     {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.pft_harvest[i].harvest;
-      writepft(output,PFT_HARVEST,fvec,2*(ncft+NGRASS+NBIOMASSTYPE),year,i,config);
+      foreachactivecell(count,cell,config)
+        fvec[config->count*i+count]=(float)grid[cell].output.pft_harvest[i].harvest;
     }
+    writelayers(output,PFT_HARVEST,fvec,LPJ_FLOAT,2*(ncft+NGRASS+NBIOMASSTYPE),
+                year-config->outputyear,
+                output->files[PFT_HARVEST].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   if(isopen(output,PFT_RHARVEST))
   {
-    outindex(output,PFT_RHARVEST,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*(ncft+NGRASS+NBIOMASSTYPE)*2);
     for(i=0;i<(ncft+NGRASS+NBIOMASSTYPE)*2;i++)
     {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.pft_harvest[i].residual;
-      writepft(output,PFT_RHARVEST,fvec,2*(ncft+NGRASS+NBIOMASSTYPE),year,i,config);
+      foreachactivecell(count,cell,config)
+        fvec[config->count*i+count]=(float)grid[cell].output.pft_harvest[i].residual;
     }
+    writelayers(output,PFT_RHARVEST,fvec,LPJ_FLOAT,2*(ncft+NGRASS+NBIOMASSTYPE),
+                year-config->outputyear,
+                output->files[PFT_RHARVEST].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   writeoutputvar(CFT_CONSUMP_WATER_G,cft_consump_water_g,2*(ncft+NGRASS+NBIOMASSTYPE));
   writeoutputvar(CFT_CONSUMP_WATER_B,cft_consump_water_b,2*(ncft+NGRASS+NBIOMASSTYPE));
@@ -243,7 +107,7 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
   writeoutputvar(FPC,fpc,npft-config->nbiomass+1);
   if(isopen(output,SOILC_LAYER))
   {
-    outindex(output,SOILC_LAYER,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*BOTTOMLAYER);
     forrootsoillayer(i)
     {
       count=0;
@@ -251,19 +115,20 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
       {
         if(!grid[cell].skip)
         {
-          fvec[count]=0;
+          fvec[config->count*i+count]=0;
           foreachstand(stand,s,grid[cell].standlist)
           {
             if(i==0)
               for(p=0;p<stand->soil.litter.n;p++)
-                fvec[count]+=(float)(stand->soil.litter.bg[p]*stand->frac);
-            fvec[count]+=(float)((stand->soil.cpool[i].slow+stand->soil.cpool[i].fast)*stand->frac);
+                fvec[config->count*i+count]+=(float)(stand->soil.litter.bg[p]*stand->frac);
+            fvec[config->count*i+count]+=(float)((stand->soil.cpool[i].slow+stand->soil.cpool[i].fast)*stand->frac);
           }   
           count++;
         }
       }
-      writepft(output,SOILC_LAYER,fvec,BOTTOMLAYER,year,i,config);
     }
+    writelayers(output,SOILC_LAYER,fvec,LPJ_FLOAT,BOTTOMLAYER,year-config->outputyear,
+                output->files[SOILC_LAYER].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   writeoutputvar(CFT_PET,cft_pet,2*(ncft+NGRASS));
   writeoutputvar(CFT_TRANSP,cft_transp,2*(ncft+NGRASS+NBIOMASSTYPE));
@@ -288,27 +153,27 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
 #ifdef DOUBLE_HARVEST
   if(isopen(output,PFT_HARVEST2))
   {
-    outindex(output,PFT_HARVEST2,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*(ncft+NGRASS+NBIOMASSTYPE)*2);
     for(i=0;i<(ncft+NGRASS+NBIOMASSTYPE)*2;i++)
     {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.pft_harvest2[i].harvest;
-      writepft(output,PFT_HARVEST2,fvec,2*(ncft+NGRASS+NBIOMASSTYPE),year,i,config);
+      foreachactivecell(count,cell,config)
+        fvec[config->count*i+count]=(float)grid[cell].output.pft_harvest2[i].harvest;
     }
+    writelayers(output,PFT_HARVEST2,fvec,LPJ_FLOAT,2*(ncft+NGRASS+NBIOMASSTYPE),
+                year-config->outputyear,
+                output->files[PFT_HARVEST2].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   if(isopen(output,PFT_RHARVEST2))
   {
-    outindex(output,PFT_RHARVEST2,config->rank);
+    fvec=getoutputbuffer(&output->stage,sizeof(float)*config->count*(ncft+NGRASS+NBIOMASSTYPE)*2);
     for(i=0;i<(ncft+NGRASS+NBIOMASSTYPE)*2;i++)
     {
-      count=0;
-      for(cell=0;cell<config->ngridcell;cell++)
-        if(!grid[cell].skip)
-          fvec[count++]=(float)grid[cell].output.pft_harvest2[i].residual;
-      writepft(output,PFT_RHARVEST2,fvec,2*(ncft+NGRASS+NBIOMASSTYPE),year,i,config);
+      foreachactivecell(count,cell,config)
+        fvec[config->count*i+count]=(float)grid[cell].output.pft_harvest2[i].residual;
     }
+    writelayers(output,PFT_RHARVEST2,fvec,LPJ_FLOAT,2*(ncft+NGRASS+NBIOMASSTYPE),
+                year-config->outputyear,
+                output->files[PFT_RHARVEST2].oneyear ? NO_TIME : year-config->outputyear,config);
   }
   writeoutputvar(GROWING_PERIOD2,growing_period2,2*(ncft+NGRASS));
   writeoutputvar(CFT_PET2,cft_pet2,2*(ncft+NGRASS));
@@ -327,7 +192,6 @@ void fwriteoutput_pft(Outputfile *output,  /**< Output file array */
   writeoutputshortvar(SYEAR,syear,2*ncft);
   writeoutputshortvar(SYEAR2,syear2,2*ncft);
 #endif
-  free(fvec);
 } /* of 'fwriteoutput_pft' */
 
 /*
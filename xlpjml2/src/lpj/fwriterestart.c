@@ -21,6 +21,7 @@
 #endif
 
 #define MSGTAG 101 /* MPI message tag */
+#define RESTART_BUFSIZE 1048576 /* size of file buffer, many small records are written */
 
 Bool fwriterestart(const Cell grid[],   /**< cell array               */
                    int npft,            /**< number of natural PFTs   */
@@ -34,6 +35,7 @@ Bool fwriterestart(const Cell grid[],   /**< cell array               */
   MPI_Status status;
   Bool iserror;
 #endif
+  Bool rc;
   FILE *file;
   long long *index;
   Header header;
@@ -66,6 +68,7 @@ Bool fwriterestart(const Cell grid[],   /**< cell array               */
 #endif
     return TRUE;
   }
+  setvbuf(file,NULL,_IOFBF,RESTART_BUFSIZE);
   if(isroot(*config))
   {
     /* set header data */
@@ -109,19 +112,25 @@ Bool fwriterestart(const Cell grid[],   /**< cell array               */
   /* seek just after header + config->startgrid-config->firstgrid  */
   fseek(file,headersize(RESTART_HEADER,RESTART_VERSION)+sizeof(Restartheader)+sizeof(long long)*(config->startgrid-config->firstgrid),SEEK_SET);
   /* write position vector */
-  fwrite(index,sizeof(long long),config->ngridcell,file);
+  rc=fwrite(index,sizeof(long long),config->ngridcell,file)!=config->ngridcell;
+  free(index);
+  if(fflush(file))
+    rc=TRUE;
 #ifndef _WIN32
-  if(config->ntask>1)
-    /* wait until all data are completely written */
-    fsync(fileno(file));
+  /* wait until all data are completely written */
+  if(!rc && config->ntask>1 && fsync(fileno(file)))
+    rc=TRUE;
 #endif
-  fclose(file);
-  free(index);
+  if(fclose(file))
+    rc=TRUE;
+  if(rc)
+    fprintf(stderr,"ERROR153: Cannot write data in restart file '%s': %s\n",
+            filename,strerror(errno));
 #ifdef USE_MPI
-  iserror=FALSE;
+  iserror=rc;
   if(config->rank<config->ntask-1)
     /* send message to next task to write further data */
     MPI_Send(&iserror,1,MPI_INT,config->rank+1,MSGTAG,config->comm);
 #endif
-  return FALSE;
+  return rc;
 } /* of 'fwriterestart' */
@@ -0,0 +1,220 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**         f  w  r  i  t  e  r  e  s  t  a  r  t  _  a  s  y  n  c  .  c          \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes restart file in the background. Cell data are              \n**/
+/**     serialized into memory by the calling thread and written by a              \n**/
+/**     writer thread while the simulation continues. Function waitrestart         \n**/
+/**     joins the writer thread. With MPI each task writes its cell data at        \n**/
+/**     an offset computed by a prefix sum of the data sizes, so no MPI            \n**/
+/**     calls are made by the writer thread. On Windows the restart file is        \n**/
+/**     written directly.                                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+
+typedef struct
+{
+  pthread_t thread;
+  char *filename;              /* filename of restart file */
+  Bool isroot;                 /* header is written by root task */
+  Header header;               /* header of restart file */
+  Restartheader restartheader; /* restart header */
+  long long *index;            /* index vector of cells of task */
+  int ngridcell;               /* number of cells of task */
+  long long pos_index;         /* position of index vector of task in file */
+  char *data;                  /* serialized cell data */
+  size_t size;                 /* size of serialized cell data (bytes) */
+  long long pos_data;          /* position of cell data of task in file */
+  Bool rc;                     /* error code of writer, TRUE on error */
+} Restartwriter;
+
+static Restartwriter writer;
+static Bool isrunning=FALSE; /* writer thread running (TRUE/FALSE) */
+
+static void freewriter(void)
+{
+  free(writer.filename);
+  free(writer.index);
+  free(writer.data);
+} /* of 'freewriter' */
+
+static void *writerestart(void *arg)
+{
+  Restartwriter *writer;
+  FILE *file;
+  Bool rc;
+  writer=arg;
+  /* file has already been created by the root task */
+  file=fopen(writer->filename,"r+b");
+  if(file==NULL)
+  {
+    printfopenerr(writer->filename);
+    writer->rc=TRUE;
+    return NULL;
+  }
+  rc=FALSE;
+  if(writer->isroot)
+  {
+    if(fwriteheader(file,&writer->header,RESTART_HEADER,RESTART_VERSION) ||
+       fwrite(&writer->restartheader,sizeof(Restartheader),1,file)!=1)
+      rc=TRUE;
+  }
+  if(fseek(file,writer->pos_index,SEEK_SET) ||
+     fwrite(writer->index,sizeof(long long),writer->ngridcell,file)!=writer->ngridcell)
+    rc=TRUE;
+  if(fseek(file,writer->pos_data,SEEK_SET) ||
+     fwrite(writer->data,1,writer->size,file)!=writer->size)
+    rc=TRUE;
+  /* wait until all data are completely written */
+  if(fflush(file) || fsync(fileno(file)))
+    rc=TRUE;
+  if(fclose(file))
+    rc=TRUE;
+  if(rc)
+    fprintf(stderr,"ERROR153: Cannot write data in restart file '%s': %s\n",
+            writer->filename,strerror(errno));
+  writer->rc=rc;
+  return NULL;
+} /* of 'writerestart' */
+
+#endif
+
+Bool waitrestart(void) /** \return TRUE on error */
+{
+#ifndef _WIN32
+  if(isrunning)
+  {
+    /* wait until writer thread has finished */
+    pthread_join(writer.thread,NULL);
+    isrunning=FALSE;
+    freewriter();
+    if(writer.rc)
+    {
+      fputs("ERROR254: Writing restart file in background failed.\n",stderr);
+      return TRUE;
+    }
+  }
+#endif
+  return FALSE;
+} /* of 'waitrestart' */
+
+Bool fwriterestart_async(const Cell grid[],   /**< cell array               */
+                         int npft,            /**< number of natural PFTs   */
+                         int ncft,            /**< number of crop PFTs      */
+                         int year,            /**< year                     */
+                         const char *filename,/**< filename of restart file */
+                         const Config *config /**< LPJ configuration        */
+                        )                     /** \return TRUE on error     */
+{
+#ifndef _WIN32
+  FILE *file;
+  Bool rc;
+  int cell;
+#ifdef USE_MPI
+  long long size,offset;
+#endif
+  if(!config->async_restart)
+    return fwriterestart(grid,npft,ncft,year,filename,config);
+  /* only one restart file is written in the background */
+  if(waitrestart())
+    return TRUE;
+  /* serialize cell data into memory, index vector holds positions
+   * relative to the start of the cell data of the task */
+  writer.data=NULL;
+  writer.size=0;
+  writer.ngridcell=config->ngridcell;
+  writer.index=newvec(long long,config->ngridcell);
+  writer.filename=strdup(filename);
+  file=open_memstream(&writer.data,&writer.size);
+  rc=writer.index==NULL || writer.filename==NULL || file==NULL;
+  if(file!=NULL)
+  {
+    if(!rc && fwritecell(file,writer.index,grid,config->ngridcell,ncft,npft,
+                         config->sdate_option,config->river_routing)!=config->ngridcell)
+      rc=TRUE;
+    if(fclose(file))
+      rc=TRUE;
+  }
+  if(iserror(rc,config))
+  {
+    /* not enough memory, restart file is written directly */
+    freewriter();
+    return fwriterestart(grid,npft,ncft,year,filename,config);
+  }
+  /* create file before any writer thread opens it */
+  if(isroot(*config))
+  {
+    file=fopen(filename,"wb");
+    if(file==NULL)
+    {
+      printfcreateerr(filename);
+      rc=TRUE;
+    }
+    else if(fclose(file))
+      rc=TRUE;
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+#endif
+  if(rc)
+  {
+    freewriter();
+    return TRUE;
+  }
+  writer.isroot=isroot(*config);
+  if(writer.isroot)
+  {
+    /* set header data */
+    writer.header.order=CELLYEAR;
+    writer.header.firstyear=year;
+    writer.header.nyear=1;
+    writer.header.firstcell=config->startgrid;
+    writer.header.ncell=config->nall;
+    writer.header.nbands=npft+ncft;
+    writer.header.scalar=1;
+    writer.header.cellsize_lat=(float)config->resolution.lat;
+    writer.header.cellsize_lon=(float)config->resolution.lon;
+    writer.header.datatype=(sizeof(Real)==sizeof(float)) ? LPJ_FLOAT : LPJ_DOUBLE;
+    writer.restartheader.landuse=(config->withlanduse!=NO_LANDUSE);
+    writer.restartheader.sdate_option=config->sdate_option;
+    writer.restartheader.river_routing=config->river_routing;
+  }
+  /* cell data start after header and index vector of all cells */
+  writer.pos_index=headersize(RESTART_HEADER,RESTART_VERSION)+sizeof(Restartheader);
+  writer.pos_data=writer.pos_index+sizeof(long long)*config->nall;
+  writer.pos_index+=sizeof(long long)*(config->startgrid-config->firstgrid);
+#ifdef USE_MPI
+  /* cell data of tasks are stored in order of ranks */
+  size=writer.size;
+  MPI_Exscan(&size,&offset,1,MPI_LONG_LONG,MPI_SUM,config->comm);
+  if(!isroot(*config))
+    writer.pos_data+=offset;
+#endif
+  for(cell=0;cell<config->ngridcell;cell++)
+    writer.index[cell]+=writer.pos_data;
+  if(pthread_create(&writer.thread,NULL,writerestart,&writer))
+  {
+    /* thread cannot be created, data are written directly */
+    writerestart(&writer);
+    freewriter();
+    return writer.rc;
+  }
+  isrunning=TRUE;
+  return FALSE;
+#else
+  return fwriterestart(grid,npft,ncft,year,filename,config);
+#endif
+} /* of 'fwriterestart_async' */
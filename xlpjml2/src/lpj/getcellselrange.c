@@ -0,0 +1,244 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**           g  e  t  c  e  l  l  s  e  l  r  a  n  g  e  .  c                    \n**/
+/**                                                                                \n**/
+/**     Function restricts grid range to the bounding range of the selected        \n**/
+/**     cells. Indices of cell list are checked against the grid range. For        \n**/
+/**     country and box selection coordinates and country codes of all             \n**/
+/**     cells are scanned by the root task and the sorted indices of the           \n**/
+/**     selected cells are broadcast to all tasks for the river routing            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+typedef struct
+{
+  Coordfile file;      /* binary coordinate file */
+  Coord_netcdf cdf;    /* netCDF soil code file with coordinates */
+  Coord resolution;    /* resolution of grid */
+} Coordinput;
+
+static Bool opencoordinput(Coordinput *input,int startgrid,const Config *config)
+{
+  float lon,lat;
+  if(config->soil_filename.fmt==CDF)
+  {
+    input->cdf=opencoord_netcdf(config->soil_filename.name,
+                                config->soil_filename.var,isroot(*config));
+    if(input->cdf==NULL)
+      return TRUE;
+    getresolution_netcdf(input->cdf,&input->resolution);
+    if(seekcoord_netcdf(input->cdf,startgrid))
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR109: Cannot seek in coordinate file to position %d.\n",
+                startgrid);
+      closecoord_netcdf(input->cdf);
+      return TRUE;
+    }
+  }
+  else
+  {
+    input->file=opencoord(&config->coord_filename,isroot(*config));
+    if(input->file==NULL)
+      return TRUE;
+    getcellsizecoord(&lon,&lat,input->file);
+    input->resolution.lon=lon;
+    input->resolution.lat=lat;
+    if(seekcoord(input->file,startgrid))
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR109: Cannot seek in coordinate file to position %d.\n",
+                startgrid);
+      closecoord(input->file);
+      return TRUE;
+    }
+  }
+  return FALSE;
+} /* of 'opencoordinput' */
+
+static Bool readcoordinput(Coordinput *input,Coord *coord,int cell,
+                           const Config *config)
+{
+  unsigned int soilcode;
+  if((config->soil_filename.fmt==CDF) ?
+     readcoord_netcdf(input->cdf,coord,&input->resolution,&soilcode) :
+     readcoord(input->file,coord,&input->resolution))
+  {
+    if(isroot(*config))
+      fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
+              (config->soil_filename.fmt==CDF) ? config->soil_filename.name :
+              config->coord_filename.name,cell);
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'readcoordinput' */
+
+static void closecoordinput(Coordinput *input,const Config *config)
+{
+  if(config->soil_filename.fmt==CDF)
+    closecoord_netcdf(input->cdf);
+  else
+    closecoord(input->file);
+} /* of 'closecoordinput' */
+
+static Bool scancells(int startgrid,int endgrid,Config *config)
+{
+  Coordinput coords;
+  Coord coord;
+  Infile countrycode={NULL}; /* only opened for country selection */
+  Code code;
+  Bool swap,withcoord,rc;
+  Type type;
+  long offset;
+  int cell,data,country;
+  if(config->cellsel==CELLSEL_COUNTRY && config->countrycode_filename.name==NULL)
+  {
+    if(isroot(*config))
+      fputs("ERROR258: Country selection requires country codes, land use must be enabled.\n",stderr);
+    return TRUE;
+  }
+  /* coordinates are needed for box selection and country codes in netCDF files */
+  withcoord=config->cellsel==CELLSEL_BOX || config->countrycode_filename.fmt==CDF;
+  if(withcoord && opencoordinput(&coords,startgrid,config))
+    return TRUE;
+  if(config->cellsel==CELLSEL_COUNTRY)
+  {
+    if(config->countrycode_filename.fmt==CDF)
+    {
+      countrycode.cdf=openinput_netcdf(config->countrycode_filename.name,
+                                       config->countrycode_filename.var,NULL,0,config);
+      if(countrycode.cdf==NULL)
+      {
+        closecoordinput(&coords,config);
+        return TRUE;
+      }
+    }
+    else
+    {
+      countrycode.file=opencountrycode(&config->countrycode_filename,
+                                       &swap,&type,&offset,isroot(*config));
+      if(countrycode.file==NULL)
+        return TRUE;
+      if(seekcountrycode(countrycode.file,startgrid,type,offset))
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR106: Cannot seek in countrycode file to position %d.\n",
+                  startgrid);
+        fclose(countrycode.file);
+        return TRUE;
+      }
+    }
+  }
+  rc=FALSE;
+  country=-1;
+  for(cell=startgrid;cell<=endgrid;cell++)
+  {
+    if(withcoord && readcoordinput(&coords,&coord,cell,config))
+    {
+      rc=TRUE;
+      break;
+    }
+    if(config->cellsel==CELLSEL_COUNTRY)
+    {
+      if(config->countrycode_filename.fmt==CDF)
+        country=(readintinput_netcdf(countrycode.cdf,&data,&coord)) ? -1 : data;
+      else if(readcountrycode(countrycode.file,&code,type,swap))
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
+                  config->countrycode_filename.name,cell);
+        rc=TRUE;
+        break;
+      }
+      else
+        country=code.country;
+    }
+    if(iscellselected(config,cell,&coord,country))
+    {
+      if(config->cellsel_ncell % 1024==0)
+      {
+        config->cellsel_cells=realloc(config->cellsel_cells,
+                                      sizeof(int)*(config->cellsel_ncell+1024));
+        if(config->cellsel_cells==NULL)
+        {
+          printallocerr("cellsel_cells");
+          rc=TRUE;
+          break;
+        }
+      }
+      config->cellsel_cells[config->cellsel_ncell++]=cell;
+    }
+  }
+  if(withcoord)
+    closecoordinput(&coords,config);
+  if(config->cellsel==CELLSEL_COUNTRY)
+    closeinput(countrycode,config->countrycode_filename.fmt);
+  return rc;
+} /* of 'scancells' */
+
+Bool getcellselrange(int *startgrid, /**< first global cell index, restricted on return */
+                     int *endgrid,   /**< last global cell index, restricted on return */
+                     Config *config  /**< LPJmL configuration */
+                    )                /** \return TRUE on error */
+{
+  const int *cells;
+  int i,n;
+  Bool rc;
+  switch(config->cellsel)
+  {
+    case NO_CELLSEL:
+      return FALSE;
+    case CELLSEL_LIST:
+      /* list is sorted, indices outside grid range are rejected */
+      for(i=0;i<config->cellsel_n;i++)
+        if(config->cellsel_list[i]<*startgrid || config->cellsel_list[i]>*endgrid)
+        {
+          if(isroot(*config))
+            fprintf(stderr,"ERROR257: Selected cell %d not in range %d-%d.\n",
+                    config->cellsel_list[i],*startgrid,*endgrid);
+          return TRUE;
+        }
+      cells=config->cellsel_list;
+      n=config->cellsel_n;
+      break;
+    default:
+      /* cells are scanned by the root task only and sent to all tasks */
+      rc=(isroot(*config)) ? scancells(*startgrid,*endgrid,config) : FALSE;
+#ifdef USE_MPI
+      MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+      if(rc)
+        return TRUE;
+      MPI_Bcast(&config->cellsel_ncell,1,MPI_INT,0,config->comm);
+      if(!isroot(*config) && config->cellsel_ncell>0)
+      {
+        config->cellsel_cells=newvec(int,config->cellsel_ncell);
+        check(config->cellsel_cells);
+      }
+      MPI_Bcast(config->cellsel_cells,config->cellsel_ncell,MPI_INT,0,
+                config->comm);
+#else
+      if(rc)
+        return TRUE;
+#endif
+      if(config->cellsel_ncell==0)
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR257: No selected cell in range %d-%d.\n",
+                  *startgrid,*endgrid);
+        return TRUE;
+      }
+      cells=config->cellsel_cells;
+      n=config->cellsel_ncell;
+  }
+  *startgrid=cells[0];
+  *endgrid=cells[n-1];
+  return FALSE;
+} /* of 'getcellselrange' */
@@ -0,0 +1,45 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              g  e  t  g  a  t  h  e  r  p  l  a  n  .  c                       \n**/
+/**                                                                                \n**/
+/**     Function returns gather plan for output with n items per cell,             \n**/
+/**     e.g. layers or days of a block. Counts and offsets of the plan are         \n**/
+/**     scaled by n. Plans are created at first use and reused for all             \n**/
+/**     further output steps. Function has to be called by all tasks.              \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_OUTPUT
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+Gatherplan *getgatherplan(Outputfile *output,  /**< output data */
+                          int n,               /**< number of items per cell */
+                          const Config *config /**< LPJmL configuration */
+                         )                     /** \return gather plan */
+{
+  int i;
+  if(n==1)
+    return output->plan;
+  if(n>=output->nplan_block)
+  {
+    output->plan_block=realloc(output->plan_block,sizeof(Gatherplan *)*(n+1));
+    check(output->plan_block);
+    for(i=output->nplan_block;i<=n;i++)
+      output->plan_block[i]=NULL;
+    output->nplan_block=n+1;
+  }
+  if(output->plan_block[n]==NULL)
+    output->plan_block[n]=newgatherplan(config->count*n,config->comm);
+  return output->plan_block[n];
+} /* of 'getgatherplan' */
+
+#endif
@@ -0,0 +1,33 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               g  e  t  o  u  t  p  u  t  b  u  f  f  e  r  .  c                \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function returns staging buffer for output of at least the                 \n**/
+/**     requested size. Buffer is only enlarged, so it can be reused               \n**/
+/**     for all output variables and years                                         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void *getoutputbuffer(Outputbuffer *buffer, /**< staging buffer */
+                      size_t size           /**< requested size (bytes) */
+                     )                      /** \return pointer to buffer */
+{
+  if(size>buffer->size)
+  {
+    free(buffer->data);
+    buffer->data=malloc(size);
+    check(buffer->data);
+    buffer->size=size;
+  }
+  return buffer->data;
+} /* of 'getoutputbuffer' */
@@ -27,14 +27,22 @@
 #define IMAGE_OPT ""
 #endif
 #ifdef USE_MPI
-#define USAGE "\nUsage: %s [-h] [-l] [-v] [-vv] [-param] [-pp cmd] " FPE_OPT "\n" IMAGE_OPT\
+#define USAGE "\nUsage: %s [-h] [-l] [-v] [-ensemble n] [-vv] [-param] [-pp cmd] " FPE_OPT "\n" IMAGE_OPT\
                 "       [-output {gather|mpi2|socket=hostname[:port]}]\n"\
                 "       [-outpath dir] [-inpath dir] [-restartpath dir]\n"\
+                "       [-climatebuffer n] [-infil {slug|adaptive|verify}] [-asyncrestart]\n"\
+                "       [-socketv2] [-socketrle] [-dailybuffer {day|month|year}]\n"\
+                "       [-cells file] [-country c1,c2,...] [-box lonmin,latmin,lonmax,latmax]\n"\
+                "       [-threads n] [-dryrun] [-memdump file]\n"\
                 "       [[-Dmacro[=value]] [-Idir] ...] [filename]\n"
 #else
-#define USAGE "\nUsage: %s [-h] [-l] [-v] [-vv] [-param] [-pp cmd] " FPE_OPT "\n" IMAGE_OPT\
+#define USAGE "\nUsage: %s [-h] [-l] [-v] [-ensemble n] [-vv] [-param] [-pp cmd] " FPE_OPT "\n" IMAGE_OPT\
                 "       [-output {write|socket=hostname[:port]}]\n"\
                 "       [-outpath dir] [-inpath dir] [-restartpath dir]\n"\
+                "       [-climatebuffer n] [-infil {slug|adaptive|verify}] [-asyncrestart]\n"\
+                "       [-socketv2] [-socketrle] [-dailybuffer {day|month|year}]\n"\
+                "       [-cells file] [-country c1,c2,...] [-box lonmin,latmin,lonmax,latmax]\n"\
+                "       [-threads n] [-dryrun] [-memdump file]\n"\
                 "       [[-Dmacro[=value]] [-Idir] ...] [filename]\n"
 #endif
 
@@ -65,6 +73,9 @@ void help(const char *progname, /**< program filename */
           "-h               print this help text\n"
           "-l               print license file\n"
           "-v               print version, compiler and compile flags\n"
+          "-ensemble n      run n ensemble members sharing input data. Must be first\n"
+          "                 argument. Index of member is defined as macro\n"
+          "                 ENSEMBLE_MEMBER, output files are prefixed by 'member<n>_'\n"
           "-vv              verbosely print the actual values during reading of the\n"
           "                 configuration files\n"
           "-param           print LPJmL parameter\n"
@@ -85,6 +96,27 @@ void help(const char *progname, /**< program filename */
           "-outpath dir     directory appended to output filenames\n"
           "-inpath dir      directory appended to input filenames\n"
           "-restartpath dir directory appended to restart filename\n"
+          "-climatebuffer n number of years of binary climate data read at once.\n"
+          "                 Default is 1\n"
+          "-infil solver    infiltration solver. Must be slug, adaptive or verify.\n"
+          "                 verify runs both solvers and reports differences.\n"
+          "                 Default is slug\n"
+          "-asyncrestart    write restart file in the background while simulation\n"
+          "                 continues. Not supported on Windows\n"
+          "-socketv2        send socket output in frames holding all variables of a\n"
+          "                 time step. Frames are sent in the background\n"
+          "-socketrle       same as -socketv2 with run-length compressed frames\n"
+          "-dailybuffer block buffer daily output in memory and write it once per\n"
+          "                 block. Must be day, month or year. Default is day\n"
+          "-cells file      simulate only cells with global indices listed in file\n"
+          "-country c1,...  simulate only cells of the listed country codes\n"
+          "-box lonmin,latmin,lonmax,latmax simulate only cells inside box\n"
+          "                 Grid range is restricted to the selected cells, rivers\n"
+          "                 and irrigation are cut at the border of the selection\n"
+          "-threads n       number of threads for grid initialization, land-use change\n"
+          "                 and annual update. Not supported on Windows. Default is 1\n"
+          "-dryrun          initialize grid and input data, print memory report and exit\n"
+          "-memdump file    write memory report to file in CSV format\n"
           "-Dmacro[=value]  define macro for preprocessor of configuration file\n"
           "-Idir            directory to search for include files\n"
           "filename         configuration filename. Default is '%s'\n\n"
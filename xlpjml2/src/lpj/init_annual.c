@@ -27,6 +27,7 @@ void init_annual(Cell *cell, /**< Pointer to cell */
   cell->balance.aprec=cell->balance.nep=cell->balance.awater_flux=0.0;
   cell->afire_frac=cell->balance.biomass_yield=0.0;
   cell->balance.total_irrig_from_reservoir=cell->balance.total_reservoir_out=0.0;
+  cell->balance.infil_diff=0.0;
   foreachstand(stand,s,cell->standlist)
   {
 #ifdef DEBUG3
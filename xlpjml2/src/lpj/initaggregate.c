@@ -0,0 +1,195 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                  i  n  i  t  a  g  g  r  e  g  a  t  e  .  c                   \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function initializes bins for output aggregated by country, region         \n**/
+/**     or basin. Bins of basins are read from the basin input file                \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_OUTPUT
+
+#include "lpj.h"
+
+#define checkptr(ptr) if(ptr==NULL) { printallocerr(#ptr); return TRUE; }
+
+static Bool readbasin(int bin[],        /**< basin id of each active cell */
+                      const Cell grid[], /**< LPJ grid */
+                      const Config *config /**< LPJmL configuration */
+                     )                  /** \return TRUE on error */
+{
+  Header header;
+  String headername;
+  Infile file;
+  Bool swap=FALSE;
+  Type datatype=LPJ_SHORT;
+  size_t offset;
+  int cell,count,version,id;
+  if(config->basin_filename.fmt==CDF)
+  {
+    file.cdf=openinput_netcdf(config->basin_filename.name,config->basin_filename.var,NULL,0,config);
+    if(file.cdf==NULL)
+      return TRUE;
+  }
+  else
+  {
+    file.file=openinputfile(&header,&swap,&config->basin_filename,
+                            headername,&version,&offset,config);
+    if(file.file==NULL)
+      return TRUE;
+    datatype=(version<3) ? LPJ_SHORT : header.datatype;
+    if(fseek(file.file,(config->startgrid-header.firstcell)*typesizes[datatype]+offset,SEEK_CUR))
+    {
+      fprintf(stderr,"ERROR108: Cannot seek in basin file to position %d.\n",
+              config->startgrid);
+      fclose(file.file);
+      return TRUE;
+    }
+  }
+  count=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    if(config->basin_filename.fmt==CDF)
+    {
+      if(grid[cell].skip)
+        continue;
+      if(readintinput_netcdf(file.cdf,&id,&grid[cell].coord))
+        id=-1;
+    }
+    else if(readintvec(file.file,&id,1,swap,datatype))
+    {
+      fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
+              config->basin_filename.name,cell+config->startgrid);
+      fclose(file.file);
+      return TRUE;
+    }
+    if(!grid[cell].skip)
+      bin[count++]=id;
+  }
+  closeinput(file,config->basin_filename.fmt);
+  return FALSE;
+} /* of 'readbasin' */
+
+static Bool initbins(Aggregate *aggregate, /**< bins of aggregation */
+                     int type,             /**< type of aggregation */
+                     const Cell grid[],    /**< LPJ grid */
+                     const Config *config  /**< LPJmL configuration */
+                    )                      /** \return TRUE on error */
+{
+  int cell,count,nbin;
+  Bool rc;
+  aggregate->bin=newvec(int,config->count);
+  rc=(aggregate->bin==NULL);
+  if(rc)
+    printallocerr("bin");
+  count=0;
+  switch(type)
+  {
+    case AGGREGATE_COUNTRY:
+      if(rc)
+        return TRUE;
+      for(cell=0;cell<config->ngridcell;cell++)
+        if(!grid[cell].skip)
+          aggregate->bin[count++]=grid[cell].ml.manage.par->id;
+      aggregate->nbin=config->ncountries;
+      break;
+    case AGGREGATE_REGION:
+      if(rc)
+        return TRUE;
+      for(cell=0;cell<config->ngridcell;cell++)
+        if(!grid[cell].skip)
+          aggregate->bin[count++]=grid[cell].ml.manage.regpar->id;
+      aggregate->nbin=config->nregions;
+      break;
+    case AGGREGATE_BASIN:
+      /* all tasks have to reach the reduction below */
+      if(!rc)
+        rc=readbasin(aggregate->bin,grid,config);
+      if(iserror(rc,config))
+        return TRUE;
+      /* number of basins is given by largest basin id of all tasks */
+      nbin=0;
+      for(cell=0;cell<config->count;cell++)
+        if(aggregate->bin[cell]>=nbin)
+          nbin=aggregate->bin[cell]+1;
+#ifdef USE_MPI
+      MPI_Allreduce(&nbin,&aggregate->nbin,1,MPI_INT,MPI_MAX,config->comm);
+#else
+      aggregate->nbin=nbin;
+#endif
+      if(aggregate->nbin==0)
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR262: No valid basin id found in '%s'.\n",
+                  config->basin_filename.name);
+        return TRUE;
+      }
+      break;
+  }
+  /* cells with invalid code are not included in any bin */
+  for(cell=0;cell<config->count;cell++)
+    if(aggregate->bin[cell]>=aggregate->nbin)
+      aggregate->bin[cell]=-1;
+  aggregate->sum=newvec(Real,aggregate->nbin);
+  checkptr(aggregate->sum);
+#ifdef USE_MPI
+  if(isroot(*config))
+  {
+    aggregate->sum_all=newvec(Real,aggregate->nbin);
+    checkptr(aggregate->sum_all);
+  }
+#endif
+  return FALSE;
+} /* of 'initbins' */
+
+Bool initaggregate(Outputfile *output, /**< output data */
+                   const Cell grid[],  /**< LPJ grid */
+                   const Config *config /**< LPJmL configuration */
+                  )                    /** \return TRUE on error */
+{
+  int i,cell,count;
+  Bool rc;
+  output->aggregate=NULL;
+  output->area=NULL;
+  for(i=0;i<config->n_out;i++)
+    if(config->outputvars[i].aggregate!=NO_AGGREGATE)
+      break;
+  if(i==config->n_out) /* no aggregated output? */
+    return FALSE;
+  output->aggregate=newvec(Aggregate,NAGGREGATE);
+  output->area=newvec(Real,config->count);
+  if(output->aggregate!=NULL)
+    for(i=0;i<NAGGREGATE;i++)
+    {
+      output->aggregate[i].nbin=0;
+      output->aggregate[i].bin=NULL;
+      output->aggregate[i].sum=output->aggregate[i].sum_all=NULL;
+    }
+  rc=(output->aggregate==NULL || output->area==NULL);
+  if(rc)
+    printallocerr("aggregate");
+  /* errors are checked on all tasks, because initbins() calls collective functions */
+  if(iserror(rc,config))
+    return TRUE;
+  count=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+    if(!grid[cell].skip)
+      output->area[count++]=grid[cell].coord.area;
+  for(i=0;i<config->n_out;i++)
+    if(config->outputvars[i].aggregate!=NO_AGGREGATE &&
+       output->aggregate[config->outputvars[i].aggregate].bin==NULL)
+    {
+      if(iserror(initbins(output->aggregate+config->outputvars[i].aggregate,
+                          config->outputvars[i].aggregate,grid,config),config))
+        return TRUE;
+    }
+  return FALSE;
+} /* of 'initaggregate' */
@@ -28,6 +28,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 
 static int *getindex(const Input_netcdf input,const Cell grid[],
@@ -242,15 +244,18 @@ static Bool initirrig(Cell grid[],    /* Cell grid             */
         fclose(irrig_file.file);
         return TRUE;
       }
+    if(swap && config->neighb_irrig_filename.fmt!=CDF)
+      neighb_irrig=swapint(neighb_irrig);
+    if(config->cellsel!=NO_CELLSEL && !iscellselected(config,neighb_irrig,NULL,-1))
+      neighb_irrig=cell+config->startgrid; /* neighbour not selected, irrigate from own cell */
     /* add connection to network */
     rc=pnet_addconnect(config->irrig_neighbour,
                        cell+config->startgrid-config->firstgrid,
-                       ((swap) ? swapint(neighb_irrig) : neighb_irrig)-config->firstgrid);
+                       neighb_irrig-config->firstgrid);
     if(rc)
     {
       fprintf(stderr,"ERROR142: Cannot add irrigation neighbour %d of cell %d: %s.\n",
-              ((swap) ? swapint(neighb_irrig) : neighb_irrig),
-              cell+config->startgrid,
+              neighb_irrig,cell+config->startgrid,
               pnet_strerror(rc));
       fflush(stderr);
       closeinput(irrig_file,config->neighb_irrig_filename.fmt);
@@ -394,6 +399,9 @@ static Bool initriver(Cell grid[],Config *config)
       /* calculate transfer function */
       grid[cell].discharge.tfunct=transfer_function(r.len,&ncoeff);
     }
+    if(config->cellsel!=NO_CELLSEL && r.index>=0 &&
+       !iscellselected(config,r.index,NULL,-1))
+      r.index=-1; /* downstream cell not selected, cell is treated as outlet */
     grid[cell].discharge.next=r.index;
 
     if(grid[cell].discharge.tfunct==NULL)
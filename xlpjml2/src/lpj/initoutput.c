@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include "lpj.h"
 
 #define checkptr(ptr) if(ptr==NULL) { printallocerr(#ptr); return TRUE;}
@@ -30,61 +32,61 @@ Bool initoutput(Output *output, /**< Output data */
   checkptr(output->sdate);
   output->hdate=newvec(int,2*ncft);
   checkptr(output->hdate);
-  output->pft_npp=newvec(Real,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->pft_npp=newvec(Storereal,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->pft_npp);
-  output->pft_gcgp=newvec(Real,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->pft_gcgp=newvec(Storereal,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->pft_gcgp);
-  output->gcgp_count=newvec(Real,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->gcgp_count=newvec(Storereal,(npft-nbiomass)+2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->gcgp_count);
   output->pft_harvest=newvec(Harvest,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->pft_harvest);
-  output->fpc = newvec(Real, (npft-nbiomass)+1);
+  output->fpc = newvec(Storereal, (npft-nbiomass)+1);
   checkptr(output->fpc);
-  output->cftfrac=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cftfrac=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cftfrac);
-  output->cft_consump_water_g=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_consump_water_g=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_consump_water_g);
-  output->cft_consump_water_b=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_consump_water_b=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_consump_water_b);
-  output->growing_period=newvec(Real,2*(ncft+NGRASS));
+  output->growing_period=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->growing_period);
-  output->cft_pet=newvec(Real,2*(ncft+NGRASS));
+  output->cft_pet=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_pet);
   output->cft_irrig_events=newvec(int,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_irrig_events);
-  output->cft_transp=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_transp=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_transp);
-  output->cft_transp_b=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_transp_b=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_transp_b);
-  output->cft_evap=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_evap=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_evap);
-  output->cft_evap_b=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_evap_b=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_evap_b);
-  output->cft_interc=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_interc=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_interc);
-  output->cft_interc_b=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_interc_b=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_interc_b);
-  output->cft_return_flow_b=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_return_flow_b=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_return_flow_b);
-  output->cft_nir=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_nir=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_nir);
-  output->cft_temp=newvec(Real,2*(ncft+NGRASS));
+  output->cft_temp=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_temp);
-  output->cft_prec=newvec(Real,2*(ncft+NGRASS));
+  output->cft_prec=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_prec);
-  output->cft_srad=newvec(Real,2*(ncft+NGRASS));
+  output->cft_srad=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_srad);
-  output->cft_aboveground_biomass=newvec(Real,2*(ncft+NGRASS));
+  output->cft_aboveground_biomass=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_aboveground_biomass);
-  output->cft_airrig=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_airrig=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_airrig);
-  output->cft_fpar=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_fpar=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_fpar);
-  output->cft_luc_image=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_luc_image=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_luc_image);
-  output->cft_conv_loss_evap=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_conv_loss_evap=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_conv_loss_evap);
-  output->cft_conv_loss_drain=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_conv_loss_drain=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_conv_loss_drain);
 #ifdef DOUBLE_HARVEST
   output->sdate2=newvec(int,2*ncft); /* allocate memory for output */
@@ -97,29 +99,29 @@ Bool initoutput(Output *output, /**< Output data */
   checkptr(output->syear2);
   output->pft_harvest2=newvec(Harvest,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->pft_harvest2);
-  output->cftfrac2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cftfrac2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cftfrac2);
-  output->cft_pet2=newvec(Real,2*(ncft+NGRASS));
+  output->cft_pet2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_pet2);
-  output->cft_transp2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_transp2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_transp2);
-  output->cft_evap2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_evap2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_evap2);
-  output->cft_interc2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_interc2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_interc2);
-  output->cft_nir2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_nir2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_nir2);
-  output->cft_airrig2=newvec(Real,2*(ncft+NGRASS+NBIOMASSTYPE));
+  output->cft_airrig2=newvec(Storereal,2*(ncft+NGRASS+NBIOMASSTYPE));
   checkptr(output->cft_airrig2);
-  output->growing_period2=newvec(Real,2*(ncft+NGRASS));
+  output->growing_period2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->growing_period2);
-  output->cft_temp2=newvec(Real,2*(ncft+NGRASS));
+  output->cft_temp2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_temp2);
-  output->cft_prec2=newvec(Real,2*(ncft+NGRASS));
+  output->cft_prec2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_prec2);
-  output->cft_srad2=newvec(Real,2*(ncft+NGRASS));
+  output->cft_srad2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_srad2);
-  output->cft_aboveground_biomass2=newvec(Real,2*(ncft+NGRASS));
+  output->cft_aboveground_biomass2=newvec(Storereal,2*(ncft+NGRASS));
   checkptr(output->cft_aboveground_biomass2);
 #endif  
   initoutput_annual(output, npft, nbiomass,ncft);
@@ -0,0 +1,45 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 i  s  c  e  l  l  s  e  l  e  c  t  e  d  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function checks whether cell is part of the cell selection                 \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static int cmpint(const void *a,const void *b)
+{
+  return *(const int *)a-*(const int *)b;
+} /* of 'cmpint' */
+
+Bool iscellselected(const Config *config, /**< LPJmL configuration */
+                    int cell,             /**< global cell index */
+                    const Coord *coord,   /**< cell coordinate or NULL to check index only */
+                    int country           /**< country code of cell */
+                   )                      /** \return TRUE if cell is selected */
+{
+  if(coord==NULL && (config->cellsel==CELLSEL_COUNTRY || config->cellsel==CELLSEL_BOX))
+    /* cells were scanned by getcellselrange() */
+    return bsearch(&cell,config->cellsel_cells,config->cellsel_ncell,sizeof(int),cmpint)!=NULL;
+  switch(config->cellsel)
+  {
+    case CELLSEL_LIST:
+      return bsearch(&cell,config->cellsel_list,config->cellsel_n,sizeof(int),cmpint)!=NULL;
+    case CELLSEL_COUNTRY:
+      return bsearch(&country,config->cellsel_list,config->cellsel_n,sizeof(int),cmpint)!=NULL;
+    case CELLSEL_BOX:
+      return coord->lon>=config->cellsel_box[0] && coord->lon<=config->cellsel_box[2] &&
+             coord->lat>=config->cellsel_box[1] && coord->lat<=config->cellsel_box[3];
+    default:
+      return TRUE;
+  }
+} /* of 'iscellselected' */
@@ -55,6 +55,10 @@ int iterate(Outputfile *output,  /**< Output file data */
   Flux flux;
   int year,landuse_year,wateruse_year,startyear,firstspinupyear;
   Bool rc;
+  double tphase[NPHASE]={0};
+#ifdef IMAGE
+  Image_coupler *coupler=NULL;
+#endif
 
   firstspinupyear=(config->isfirstspinupyear) ?  config->firstspinupyear : input.climate->firstyear;
 #ifdef STORECLIMATE
@@ -74,6 +78,15 @@ int iterate(Outputfile *output,  /**< Output file data */
     rc=initsoiltemp(input.climate,grid,config);
     failonerror(config,rc,INITSOILTEMP_ERR,"Initialization of soil temperature failed");
   }
+#ifdef IMAGE
+  if(config->sim_id==LPJML_IMAGE)
+  {
+    coupler=new_imagecoupler(input.climate,config);
+    /* data of first coupled year are received in the background */
+    if(config->lastyear>=config->start_imagecoupling)
+      post_image_receive(coupler,config);
+  }
+#endif
   ischeckpoint=FALSE;
 #ifndef _WIN32
   if(ischeckpointrestart(config)) 
@@ -87,7 +100,15 @@ int iterate(Outputfile *output,  /**< Output file data */
   {
 #ifdef IMAGE
     if(year>=config->start_imagecoupling)
-      co2=receive_image_co2(config);
+    {
+      if(wait_image_receive(coupler,config))
+      {
+        fprintf(stderr,"ERROR104: Simulation stopped in wait_image_receive().\n");
+        fflush(stderr);
+        break; /* leave time loop */
+      }
+      co2=receive_image_co2(coupler);
+    }
     else
 #endif
     co2=getco2(input.climate,year); /* get atmospheric CO2 concentration */
@@ -113,7 +134,7 @@ int iterate(Outputfile *output,  /**< Output file data */
 #ifdef IMAGE
       if(year>=config->start_imagecoupling)
       {
-        if(receive_image_climate(input.climate,grid,year,config))
+        if(receive_image_climate(input.climate,grid,year,coupler,config))
         {
           fprintf(stderr,"ERROR104: Simulation stopped in receive_image_climate().\n");
           fflush(stderr);
@@ -143,14 +164,7 @@ int iterate(Outputfile *output,  /**< Output file data */
         wateruse_year=year;
 #ifdef IMAGE
       if(year>=config->start_imagecoupling)
-      {
-        if(receive_image_data(grid,npft,ncft,config))
-        {
-          fprintf(stderr,"ERROR104: Simulation stopped in receive_image_data().\n");
-          fflush(stderr);
-          break; /* leave time loop */
-        }
-      }
+        receive_image_data(grid,npft,ncft,coupler,config);
       else
 #endif
       /* read landuse pattern from file */
@@ -194,7 +208,7 @@ int iterate(Outputfile *output,  /**< Output file data */
     /* perform iteration for one year */
     if(year>=config->outputyear)
       openoutput_yearly(output,year,config);
-    iterateyear(output,grid,input,co2,npft,ncft,year,config);
+    iterateyear(output,grid,input,co2,npft,ncft,year,tphase,config);
     if(year>=config->outputyear)
       closeoutput_yearly(output,config);
     /* calculating total carbon and water fluxes collected from all tasks */
@@ -205,7 +219,7 @@ int iterate(Outputfile *output,  /**< Output file data */
       printflux(flux,cflux_total,year,config);
       if(output->method==LPJ_SOCKET && output->socket!=NULL &&
          year>=config->outputyear)
-        output_flux(output,flux);
+        output_flux(output,&flux,year);
       fflush(stdout); /* force output to console */
 #ifdef SAFE
       check_balance(flux,year,config);
@@ -223,13 +237,19 @@ int iterate(Outputfile *output,  /**< Output file data */
         fflush(stdout);
       }
 #endif
-      if(send_image_data(grid,input.climate,npft,config))
+      if(send_image_data(grid,input.climate,npft,coupler,config))
         fail(SEND_IMAGE_ERR,FALSE,
              "Problem with writing maps for transfer to IMAGE");
+      /* IMAGE answers after receiving data, receive in the background while
+         the end of the year is processed */
+      if(year<config->lastyear)
+        post_image_receive(coupler,config);
     }
 #endif
-    if(iswriterestart(config) && year==config->restartyear)
-      fwriterestart(grid,npft,ncft,year,config->write_restart_filename,config); /* write restart file */
+    if(iswriterestart(config) && year==config->restartyear &&
+       fwriterestart_async(grid,npft,ncft,year,config->write_restart_filename,config)) /* write restart file */
+      fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file '%s'",
+           config->write_restart_filename);
     if(year<config->lastyear && ischeckpointrestart(config))
     {
 #ifdef USE_MPI
@@ -239,7 +259,12 @@ int iterate(Outputfile *output,  /**< Output file data */
       {
         if(isroot(*config))
           printf("SIGTERM catched, restart file '%s' written.\n",config->checkpoint_restart_filename);
-        fwriterestart(grid,npft,ncft,year,config->checkpoint_restart_filename,config); /* write restart file */
+        if(fwriterestart(grid,npft,ncft,year,config->checkpoint_restart_filename,config)) /* write restart file */
+          fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file '%s'",
+               config->checkpoint_restart_filename);
+        if(waitrestart())
+          fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file '%s'",
+               config->write_restart_filename);
         fcloseoutput(output,config);
 #ifdef USE_MPI
         MPI_Finalize();
@@ -256,6 +281,14 @@ int iterate(Outputfile *output,  /**< Output file data */
     freeclimatedata(&store); /* free data not used anymore */
   }
 #endif
+#ifdef IMAGE
+  free_imagecoupler(coupler);
+#endif
+  printphases(tphase,config);
+  /* wait until restart file written in the background is complete */
+  if(waitrestart())
+    fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file '%s'",
+         config->write_restart_filename);
   if(year>config->lastyear && config->ischeckpoint)
     unlink(config->checkpoint_restart_filename); /* delete checkpoint file */
   return year;
@@ -0,0 +1,239 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              i  t  e  r  a  t  e  _  e  n  s  e  m  b  l  e  .  c              \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function provides main time loop for ensemble runs.                        \n**/
+/**     Climate, land use and water use are read only once per year                \n**/
+/**     and shared by all ensemble members                                         \n**/
+/**                                                                                \n**/
+/**     Prinicpal structure                                                        \n**/
+/**                                                                                \n**/
+/**     for(year=...)                                                              \n**/
+/**     {                                                                          \n**/
+/**       getclimate();                                                            \n**/
+/**       if(landuse) getlanduse();                                                \n**/
+/**       if(wateruse) getwateruse();                                              \n**/
+/**       for(member=0;member<n;member++)                                          \n**/
+/**       {                                                                        \n**/
+/**         param=memberparam[member];                                             \n**/
+/**         co2=getco2();                                                          \n**/
+/**         iterateyear();                                                         \n**/
+/**         flux_sum();                                                            \n**/
+/**         if(year==config[member].restartyear)                                   \n**/
+/**           fwriterestart();                                                     \n**/
+/**       }                                                                        \n**/
+/**     }                                                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static Bool readlanduse(Input input,Cell *grid[],int year,int ncft,
+                        const Config config[],int n)
+{
+  int i,landuse_year,wateruse_year;
+  if(config[0].withlanduse==CONST_LANDUSE || config[0].withlanduse==ALL_CROPS) /* constant landuse? */
+    landuse_year=config[0].landuse_year_const;
+  else
+    landuse_year=year;
+  /* under constand landuse also keep wateruse at landuse_year_const */
+  if(config[0].withlanduse==CONST_LANDUSE)
+    wateruse_year=config[0].landuse_year_const;
+  else
+    wateruse_year=year;
+  /* read landuse pattern from file for first member only */
+  if(getlanduse(input.landuse,grid[0],landuse_year,ncft,config))
+  {
+    fprintf(stderr,"ERROR104: Simulation stopped in getlanduse().\n");
+    fflush(stderr);
+    return TRUE;
+  }
+  for(i=1;i<n;i++)
+    copylanduse(grid[i],grid[0],ncft,config+i);
+  if(input.wateruse!=NULL)
+  {
+    if(getwateruse(input.wateruse,grid[0],wateruse_year,config))
+    {
+      fprintf(stderr,"ERROR104: Simulation stopped in getwateruse().\n");
+      fflush(stderr);
+      return TRUE;
+    }
+    for(i=1;i<n;i++)
+      copywateruse(grid[i],grid[0],config+i);
+  }
+  return FALSE;
+} /* of 'readlanduse' */
+
+int iterate_ensemble(Outputfile *output[], /**< Output file data of members */
+                     Cell *grid[],         /**< cell grid array of members */
+                     Input input,          /**< input data shared by members */
+                     const Param memberparam[], /**< LPJ parameter of members */
+                     int npft,             /**< Number of natural PFT's */
+                     int ncft,             /**< Number of crop PFT's */
+                     const Config config[],/**< LPJ configuration of members */
+                     int n                 /**< number of ensemble members */
+                    )                      /** \return last year+1 on success */
+{
+  Real co2,cflux_total;
+  Flux flux;
+  Co2data *co2data;
+  int i,year,firstspinupyear;
+  Bool rc;
+  double tphase[NPHASE]={0};
+
+  firstspinupyear=(config[0].isfirstspinupyear) ?  config[0].firstspinupyear : input.climate->firstyear;
+  /* CO2 scenario may differ between members */
+  co2data=newvec(Co2data,n);
+  check(co2data);
+  co2data[0]=input.climate->co2;
+  for(i=1;i<n;i++)
+    if(!strcmp(config[i].co2_filename.name,config[0].co2_filename.name))
+      co2data[i]=input.climate->co2;
+    else
+    {
+      rc=readco2(co2data+i,&config[i].co2_filename,isroot(config[i]));
+      failonerror(config+i,rc,INIT_INPUT_ERR,"Cannot read CO2 data of ensemble member");
+    }
+#ifdef STORECLIMATE
+  Climatedata store,data_save;
+  if(config[0].nspinup)
+  {
+    /* climate for the first nspinyear years is stored in memory
+       to avoid reading repeatedly from disk */
+    rc=storeclimate(&store,input.climate,grid[0],firstspinupyear,config[0].nspinyear,config);
+    failonerror(config,rc,STORE_CLIMATE_ERR,"Storage of climate failed");
+
+    data_save=input.climate->data;
+  }
+#endif
+  for(i=0;i<n;i++)
+    if(config[i].initsoiltemp)
+    {
+      param=memberparam[i];
+      rc=initsoiltemp(input.climate,grid[i],config+i);
+      failonerror(config+i,rc,INITSOILTEMP_ERR,"Initialization of soil temperature failed");
+    }
+  /* main loop over spinup + simulation years  */
+  for(year=config[0].firstyear-config[0].nspinup;year<=config[0].lastyear;year++)
+  {
+    if(year<input.climate->firstyear) /* are we in spinup phase? */
+      /* yes, let climate data point to stored data */
+#ifdef STORECLIMATE
+      moveclimate(input.climate,&store,
+                  (year-config[0].firstyear+config[0].nspinup) % config[0].nspinyear);
+#else
+      getclimate(input.climate,grid[0],firstspinupyear+(year-config[0].firstyear+config[0].nspinup) % config[0].nspinyear,config);
+#endif
+    else
+    {
+#ifdef STORECLIMATE
+      if(year==input.climate->firstyear && config[0].nspinup)
+      {
+        /* restore climate data pointers to initial data */
+        input.climate->data=data_save;
+        freeclimatedata(&store); /* free data not used anymore */
+      }
+#endif
+      /* read climate from files */
+      if(getclimate(input.climate,grid[0],year,config))
+      {
+        fprintf(stderr,"ERROR104: Simulation stopped in getclimate().\n");
+        fflush(stderr);
+        break; /* leave time loop */
+      }
+    }
+    if(input.landuse!=NULL)
+    {
+      for(i=0;i<n;i++)
+      {
+        param=memberparam[i];
+        calc_seasonality(grid[i],npft,ncft,config+i);
+      }
+      if(readlanduse(input,grid,year,ncft,config,n))
+        break; /* leave time loop */
+      for(i=0;i<n;i++)
+        if(config[i].reservoir)
+          allocate_reservoir(grid[i],year,config+i);
+    }
+    if(config[0].ispopulation)
+    {
+      if(readpopdens(input.popdens,year,grid[0],config))
+      {
+        fprintf(stderr,"ERROR104: Simulation stopped in getpopdens().\n");
+        fflush(stderr);
+        break; /* leave time loop */
+      }
+    }
+    if (config[0].prescribe_landcover != NO_LANDCOVER)
+    {
+      if (readlandcover(input.landcover,grid[0],year,config))
+      {
+        fprintf(stderr,"ERROR104: Simulation stopped in readlandcover().\n");
+        fflush(stderr);
+        break; /* leave time loop */
+      }
+    }
+    for(i=0;i<n;i++)
+    {
+      /* switch to LPJ parameter of member */
+      param=memberparam[i];
+      input.climate->co2=co2data[i];
+      co2=getco2(input.climate,year); /* get atmospheric CO2 concentration */
+      /* perform iteration for one year */
+      if(year>=config[i].outputyear)
+        openoutput_yearly(output[i],year,config+i);
+      iterateyear(output[i],grid[i],input,co2,npft,ncft,year,tphase,config+i);
+      if(year>=config[i].outputyear)
+        closeoutput_yearly(output[i],config+i);
+      /* calculating total carbon and water fluxes collected from all tasks */
+      cflux_total=flux_sum(&flux,grid[i],config+i);
+      if(isroot(config[i]))
+      {
+        if(i==0)
+          printflux(flux,cflux_total,year,config);
+        else
+          printf("%6d member %d: NEP %7.3f total %7.3f GtC\n",year,i,
+                 flux.nep*1e-15,cflux_total*1e-15);
+        if(output[i]->method==LPJ_SOCKET && output[i]->socket!=NULL &&
+           year>=config[i].outputyear)
+          output_flux(output[i],&flux,year);
+#ifdef SAFE
+        check_balance(flux,year,config+i);
+#endif
+      }
+      if(iswriterestart(config+i) && year==config[i].restartyear &&
+         fwriterestart_async(grid[i],npft,ncft,year,config[i].write_restart_filename,config+i)) /* write restart file */
+        fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file '%s'",
+             config[i].write_restart_filename);
+    }
+    input.climate->co2=co2data[0];
+    if(isroot(config[0]))
+      fflush(stdout); /* force output to console */
+  } /* of 'for(year=...)' */
+  input.climate->co2=co2data[0];
+#ifdef STORECLIMATE
+  if(config[0].nspinup && (config[0].lastyear<input.climate->firstyear || year<input.climate->firstyear))
+  {
+    /* restore climate data pointers to initial data */
+    input.climate->data=data_save;
+    freeclimatedata(&store); /* free data not used anymore */
+  }
+#endif
+  printphases(tphase,config);
+  /* wait until restart file written in the background is complete */
+  if(waitrestart())
+    fail(WRITE_RESTART_ERR,FALSE,"Cannot write restart file in background");
+  for(i=1;i<n;i++)
+    if(co2data[i].data!=input.climate->co2.data)
+      free(co2data[i].data);
+  free(co2data);
+  return year;
+} /* of 'iterate_ensemble' */
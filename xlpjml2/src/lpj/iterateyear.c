@@ -9,8 +9,9 @@
 /**                                                                                \n**/
 /**     Principal structure:                                                       \n**/
 /**                                                                                \n**/
-/**           for(cell=0;cell<config->ngridcell;cell++)                            \n**/
+/**           for(cell=0;cell<config->ngridcell;cell++)   (threaded)               \n**/
 /**             init_annual();                                                     \n**/
+/**             landusechange();                                                   \n**/
 /**           foreachmonth(month)                                                  \n**/
 /**           {                                                                    \n**/
 /**             foreachdayofmonth(dayofmonth,month)                                \n**/
@@ -22,12 +23,14 @@
 /**             for(cell=0;cell<config->ngridcell;cell++)                          \n**/
 /**               update_monthly();                                                \n**/
 /**           }                                                                    \n**/
-/**           for(cell=0;cell<config->ngridcell;cell++)                            \n**/
+/**           for(cell=0;cell<config->ngridcell;cell++)   (threaded)               \n**/
 /**           {                                                                    \n**/
 /**             update_annual();                                                   \n**/
 /**             check_fluxes();                                                    \n**/
 /**           }                                                                    \n**/
 /**                                                                                \n**/
+/**     Time spent in the phases is added to tphase.                               \n**/
+/**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
 /** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
@@ -38,6 +41,77 @@
 
 #include "lpj.h"
 
+typedef struct
+{
+  Input input;          /* input data */
+  int npft,ncft;        /* number of natural and crop PFTs */
+  int year;             /* simulation year (AD) */
+  Bool intercrop;       /* intercropping enabled */
+  Bool istimber;        /* timber harvest enabled */
+  Bool isdaily;         /* daily temperature data */
+  const Config *config; /* LPJ configuration */
+} Yeardata;
+
+static void landusecell(Cell *cell,int UNUSED(index),void *arg)
+{
+  Yeardata *data;
+  const Config *config;
+  data=arg;
+  config=data->config;
+  init_annual(cell,data->npft,config->nbiomass,data->ncft);
+  if(data->input.landuse!=NULL)
+  {
+    if(cell->lakefrac<1)
+    {
+      /* calculate landuse change */
+      if(config->laimax_interpolate!=CONST_LAI_MAX)
+        laimax_manage(&cell->ml.manage,config->pftpar+data->npft,data->npft,data->ncft,data->year);
+      if(data->year>config->firstyear-config->nspinup)
+        landusechange(cell,config->pftpar,data->npft,data->ncft,config->ntypes,
+                      data->intercrop,data->istimber,data->year,config->pft_output_scaled);
+      else if(cell->ml.dam)
+        landusechange_for_reservoir(cell,config->pftpar,data->npft,data->istimber,
+                                    data->intercrop,data->ncft,data->year);
+    }
+#ifdef IMAGE
+    setoutput_image(cell,data->ncft);
+#endif
+  }
+  initgdd(cell->gdd,data->npft);
+} /* of 'landusecell' */
+
+static void annualcell(Cell *cell,int index,void *arg)
+{
+  Yeardata *data;
+  const Config *config;
+  Real popdens=0; /* population density (capita/km2) */
+  data=arg;
+  config=data->config;
+  if(config->ispopulation)
+    popdens=getpopdens(data->input.popdens,index);
+  update_annual(cell,data->npft,data->ncft,popdens,data->year,
+                (config->prescribe_landcover!=NO_LANDCOVER) ? getlandcover(data->input.landcover,index) : NULL,
+                data->isdaily,data->intercrop,config);
+#ifdef SAFE
+  check_fluxes(cell,data->year,index,config);
+#endif
+#ifdef DEBUG
+  if(data->year>config->firstyear)
+  {
+    printf("year=%d\n",data->year);
+    printf("cell=%d\n",index+config->startgrid);
+    printcell(cell,1,data->npft,data->ncft,config);
+  }
+#endif
+  if(config->nspinup>veg_equil_year &&
+     data->year==config->firstyear-config->nspinup+veg_equil_year && !config->from_restart)
+    equilveg(cell);
+
+  if(config->nspinup>soil_equil_year &&
+     data->year==config->firstyear-config->nspinup+soil_equil_year && !config->from_restart)
+    equilsom(cell,data->npft+data->ncft,config->pftpar);
+} /* of 'annualcell' */
+
 void iterateyear(Outputfile *output,  /**< Output file data */
                  Cell grid[],         /**< cell array */
                  Input input,         /**< input data */
@@ -45,62 +119,59 @@ void iterateyear(Outputfile *output,  /**< Output file data */
                  int npft,            /**< number of natural PFTs */
                  int ncft,            /**< number of crop PFTs */
                  int year,            /**< simulation year (AD) */
+                 double tphase[],     /**< time spent in phases (sec) */
                  const Config *config /**< LPJ configuration */
                 )
 {
   Dailyclimate daily;
-  Bool intercrop,istimber;
+  Randstream rnd;
+  Yeardata data;
+  Bool intercrop;
   int month,dayofmonth,day;
-  int cell;
+  int cell,i,n;
   Real popdens=0; /* population density (capita/km2) */
+  double tstart;
+  int ndiff,cellmax;
+  String line;
+  intercrop=getintercrop(input.landuse);
+  data.input=input;
+  data.npft=npft;
+  data.ncft=ncft;
+  data.year=year;
+  data.intercrop=intercrop;
 #ifdef IMAGE
-  istimber=(config->start_imagecoupling!=INT_MAX);
+  data.istimber=(config->start_imagecoupling!=INT_MAX);
 #else
-  istimber=FALSE;
+  data.istimber=FALSE;
 #endif
-  intercrop=getintercrop(input.landuse);
+  data.config=config;
+  tstart=mrun();
   for(cell=0;cell<config->ngridcell;cell++)
   {
     grid[cell].output.adischarge=0;
     grid[cell].output.surface_storage=0;
-    if(!grid[cell].skip)
-    {
-      init_annual(grid+cell,npft,config->nbiomass,ncft);
-      if(input.landuse!=NULL)
-      {
-        if(grid[cell].lakefrac<1)
-        {
-          /* calculate landuse change */
-          if(config->laimax_interpolate!=CONST_LAI_MAX)
-            laimax_manage(&grid[cell].ml.manage,config->pftpar+npft,npft,ncft,year);
-          if(year>config->firstyear-config->nspinup)
-            landusechange(grid+cell,config->pftpar,npft,ncft,config->ntypes,
-                          intercrop,istimber,year,config->pft_output_scaled);
-          else if(grid[cell].ml.dam)
-            landusechange_for_reservoir(grid+cell,config->pftpar,npft,istimber,
-                                        intercrop,ncft,year);
-        }
-#ifdef IMAGE
-        setoutput_image(grid+cell,ncft);
-#endif
-      }
-      initgdd(grid[cell].gdd,npft);
-    } /*gridcell skipped*/
-  } /* of for(cell=...) */
+  }
+  /* land-use change of cells in parallel, ordered by costs of last year */
+  n=ordercells(config->cellorder,grid,config);
+  runcells(landusecell,grid,config->cellorder,n,&data,config);
+  /* stands may have changed, order cells by costs for daily loop */
+  n=ordercells(config->cellorder,grid,config);
+  tphase[LANDUSE_PHASE]+=mrun()-tstart;
 
   day=1;
   foreachmonth(month)
   {
+    tstart=mrun();
     for(cell=0;cell<config->ngridcell;cell++)
     {
       grid[cell].discharge.mfin=grid[cell].discharge.mfout=grid[cell].output.mdischarge=grid[cell].output.mwateramount=grid[cell].ml.mdemand=0.0;
       if(!grid[cell].skip)
       {
         initoutput_monthly(&((grid+cell)->output));
-        /* Initialize random seed */
-        if(israndomprec(input.climate))
-          srand48(config->seed+(config->startgrid+cell)*year*month);
-        initclimate_monthly(input.climate,&grid[cell].climbuf,cell,month);
+        /* Initialize random stream for global cell index and month */
+        initrandstream(&rnd,config->seed,STREAM_PREC,config->startgrid+cell,
+                       year*NMONTH+month);
+        initclimate_monthly(input.climate,&grid[cell].climbuf,cell,month,&rnd);
 
 #ifdef IMAGE
         monthlyoutput_image(&grid[cell].output,input.climate,cell,month);
@@ -127,31 +198,34 @@ void iterateyear(Outputfile *output,  /**< Output file data */
 #endif
       }
     } /* of 'for(cell=...)' */
+    tphase[MONTHLY_PHASE]+=mrun()-tstart;
     foreachdayofmonth(dayofmonth,month)
     {
-      for(cell=0;cell<config->ngridcell;cell++)
+      tstart=mrun();
+      /* cells not skipped, most expensive cells first */
+      for(i=0;i<n;i++)
       {
-        if(!grid[cell].skip)
-        {
-          if(config->ispopulation)
-            popdens=getpopdens(input.popdens,cell);
-          grid[cell].output.dcflux=0;
-          initoutput_daily(&(grid[cell].output.daily));
-          /* get daily values for temperature, precipitation and sunshine */
-          dailyclimate(&daily,input.climate,&grid[cell].climbuf,cell,day,
-                       month,dayofmonth);
-          /* get daily values for temperature, precipitation and sunshine */
-          grid[cell].output.daily.temp=daily.temp;
-          grid[cell].output.daily.prec=daily.prec;
-          grid[cell].output.daily.sun=daily.sun;
+        cell=config->cellorder[i];
+        if(config->ispopulation)
+          popdens=getpopdens(input.popdens,cell);
+        grid[cell].output.dcflux=0;
+        initoutput_daily(&(grid[cell].output.daily));
+        /* get daily values for temperature, precipitation and sunshine */
+        dailyclimate(&daily,input.climate,&grid[cell].climbuf,cell,day,
+                     month,dayofmonth);
+        /* get daily values for temperature, precipitation and sunshine */
+        grid[cell].output.daily.temp=daily.temp;
+        grid[cell].output.daily.prec=daily.prec;
+        grid[cell].output.daily.sun=daily.sun;
 
 #ifdef DEBUG
-          printf("day=%d cell=%d\n",day,cell);
+        printf("day=%d cell=%d\n",day,cell);
 #endif
-          update_daily(grid+cell,co2,popdens,daily,day,npft,
-                       ncft,year,month,output->withdaily,intercrop,config);
-        }
+        update_daily(grid+cell,co2,popdens,daily,day,npft,
+                     ncft,year,month,output->withdaily,intercrop,config);
       }
+      tphase[DAILY_PHASE]+=mrun()-tstart;
+      tstart=mrun();
 
       if(config->river_routing)
       {
@@ -163,13 +237,21 @@ void iterateyear(Outputfile *output,  /**< Output file data */
         if(input.landuse!=NULL || input.wateruse!=NULL)
           wateruse(grid,npft,ncft,config);
       }
+      tphase[ROUTING_PHASE]+=mrun()-tstart;
 
       if(output->withdaily && year>=config->outputyear)
+      {
+        tstart=mrun();
         fwriteoutput_daily(output,grid,day-1,year,config);
+        if(flush_output(output,year,day-1))
+          fail(SOCKET_ERR,FALSE,"Cannot send daily output for day %d of year %d",day,year);
+        tphase[OUTPUT_PHASE]+=mrun()-tstart;
+      }
 
       day++;
     } /* of 'foreachdayofmonth */
     /* Calculate resdata->mdemand as sum of ddemand to reservoir, instead of the sum of evaporation deficits per cell*/
+    tstart=mrun();
     for(cell=0;cell<config->ngridcell;cell++)
     {
       if(config->river_routing)
@@ -185,40 +267,26 @@ void iterateyear(Outputfile *output,  /**< Output file data */
                        cell,month),getmprec(input.climate,&grid[cell].climbuf,
                        cell,month),month);
     } /* of 'for(cell=0;...)' */
+    tphase[MONTHLY_PHASE]+=mrun()-tstart;
 
     if(year>=config->outputyear)
+    {
       /* write out monthly output */
+      tstart=mrun();
       fwriteoutput_monthly(output,grid,month,year,config);
+      if(flush_output(output,year,month))
+        fail(SOCKET_ERR,FALSE,"Cannot send monthly output for month %d of year %d",month+1,year);
+      tphase[OUTPUT_PHASE]+=mrun()-tstart;
+    }
 
   } /* of 'foreachmonth */
 
+  /* annual update of cells in parallel, most expensive cells first */
+  tstart=mrun();
+  data.isdaily=daily.isdailytemp;
+  runcells(annualcell,grid,config->cellorder,n,&data,config);
   for(cell=0;cell<config->ngridcell;cell++)
   {
-    if(!grid[cell].skip)
-    {
-      update_annual(grid+cell,npft,ncft,popdens,year,
-                    (config->prescribe_landcover!=NO_LANDCOVER) ? getlandcover(input.landcover,cell) : NULL,daily.isdailytemp,intercrop,config);
-#ifdef SAFE
-      check_fluxes(grid+cell,year,cell,config);
-#endif
-
-#ifdef DEBUG
-      if(year>config->firstyear)
-      {
-        printf("year=%d\n",year);
-        printf("cell=%d\n",cell+config->startgrid);
-        printcell(grid+cell,1,npft,ncft,config);
-      }
-#endif
-      if(config->nspinup>veg_equil_year &&
-         year==config->firstyear-config->nspinup+veg_equil_year && !config->from_restart)
-        equilveg(grid+cell);
-
-      if(config->nspinup>soil_equil_year &&
-         year==config->firstyear-config->nspinup+soil_equil_year && !config->from_restart)
-        equilsom(grid+cell,npft+ncft,config->pftpar);
-
-    }
     if(config->river_routing)
     {
       grid[cell].output.surface_storage=grid[cell].discharge.dmass_lake+grid[cell].discharge.dmass_river;
@@ -226,11 +294,32 @@ void iterateyear(Outputfile *output,  /**< Output file data */
         grid[cell].output.surface_storage+=reservoir_surface_storage(grid[cell].ml.resdata);
     }
   } /* of for(cell=0,...) */
+  if(config->infil_solver==INFIL_VERIFY)
+  {
+    /* one summary per year instead of a warning for each cell */
+    ndiff=0;
+    cellmax=-1;
+    for(cell=0;cell<config->ngridcell;cell++)
+      if(!grid[cell].skip && fabs(grid[cell].balance.infil_diff)>epsilon)
+      {
+        ndiff++;
+        if(cellmax==-1 || fabs(grid[cell].balance.infil_diff)>fabs(grid[cellmax].balance.infil_diff))
+          cellmax=cell;
+      }
+    if(ndiff)
+      fprintf(stderr,"WARNING029: y: %d Runoff of infiltration solvers differs in %d cell(s), maximum %g mm in cell %d (%s).\n",
+              year,ndiff,grid[cellmax].balance.infil_diff,cellmax+config->startgrid,sprintcoord(line,&grid[cellmax].coord));
+  }
+  tphase[ANNUAL_PHASE]+=mrun()-tstart;
 
   if(year>=config->outputyear)
   {
     /* write out annual output */
+    tstart=mrun();
     fwriteoutput_annual(output,grid,year,config);
     fwriteoutput_pft(output,grid,npft,ncft,year,config);
+    if(flush_output(output,year,SOCKET_ANNUAL))
+      fail(SOCKET_ERR,FALSE,"Cannot send annual output for year %d",year);
+    tphase[OUTPUT_PHASE]+=mrun()-tstart;
   }
-} /* of 'iterateyear_river' */
+} /* of 'iterateyear' */
@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_INPUT
+
 #include "lpj.h"
 
 struct landcover
@@ -6,7 +6,8 @@
 /**                                                                                \n**/
 /**     Function newgrid allocates grid cells and reads soil code,                 \n**/
 /**     country code and coordinates. If restart filename is set state             \n**/
-/**     of grid cells is recovered from a restart file.                            \n**/
+/**     of grid cells is recovered from a restart file. Static input is read       \n**/
+/**     with one call per file and cells are initialized by several threads.       \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -16,26 +17,181 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_GRID
+
 #include "lpj.h"
 #include "natural.h"
 
 #define checkptr(ptr) if(ptr==NULL) { printallocerr(#ptr); return NULL; }
 
+#define checkalloc(ptr) if(ptr==NULL) { printallocerr(#ptr); return TRUE; }
+
+typedef struct
+{
+  Cell *grid;                   /* cell grid */
+  const unsigned int *soilcodes; /* soil codes of cells */
+  Bool isnew;                   /* cell state has to be initialized */
+  int first,last;               /* range of cells initialized */
+  int npft,ncft;                /* number of natural and crop PFTs */
+  const Config *config;         /* LPJ configuration */
+  Bool rc;                      /* error code */
+} Initdata;
+
+static Bool initcell(Cell *cell,            /* pointer to cell */
+                     unsigned int soilcode, /* soil code of cell */
+                     int npft,              /* number of natural PFTs */
+                     int ncft,              /* number of crop PFTs */
+                     const Config *config   /* LPJ configuration */
+                    )                       /* returns TRUE on error */
+{
+  Stand *stand;
+  int l,n;
+  cell->standlist=newlist();
+  checkalloc(cell->standlist);
+  updatestandindex(cell);
+  cell->gdd=newgdd(npft);
+  checkalloc(cell->gdd);
+  cell->ml.sowing_month=newvec(int,2*ncft);
+  checkalloc(cell->ml.sowing_month);
+  cell->ml.gs=newvec(int,2*ncft);
+  checkalloc(cell->ml.gs);
+  for(l=0;l<2*ncft;l++)
+  {
+    cell->ml.sowing_month[l]=0;
+    cell->ml.gs[l]=0;
+  }
+  if(cell->lakefrac<1)
+  {
+    n=addstand(&natural_stand,cell);
+    stand=getstand(cell->standlist,n-1);
+    stand->frac=1-cell->lakefrac;
+    if(initsoil(&stand->soil,config->soilpar+soilcode-1,npft+ncft))
+      return TRUE;
+    for(l=0;l<FRACGLAYER;l++)
+      stand->frac_g[l]=1.0;
+  }
+  if(new_climbuf(&cell->climbuf))
+  {
+    printallocerr("climbuf");
+    return TRUE;
+  }
+  cell->ml.cropdates=init_cropdates(config->pftpar+npft,ncft,cell->coord.lat);
+  checkalloc(cell->ml.cropdates);
+  if(config->sdate_option>NO_FIXED_SDATE)
+  {
+    cell->ml.sdate_fixed=newvec(int,2*ncft);
+    checkalloc(cell->ml.sdate_fixed);
+    for(l=0;l<2*ncft;l++)
+      cell->ml.sdate_fixed[l]=0;
+  }
+  else
+    cell->ml.sdate_fixed=NULL;
+  return FALSE;
+} /* of 'initcell' */
+
+static void *initrange(void *arg)
+{
+  Initdata *data;
+  int i;
+  data=arg;
+  data->rc=FALSE;
+  for(i=data->first;i<data->last;i++)
+  {
+    if(data->isnew && !data->grid[i].skip &&
+       initcell(data->grid+i,data->soilcodes[i],data->npft,data->ncft,data->config))
+    {
+      data->rc=TRUE;
+      break;
+    }
+    if(initoutput(&data->grid[i].output,data->config->crop_index,
+                  data->config->crop_irrigation,data->npft,
+                  data->config->nbiomass,data->ncft))
+    {
+      data->rc=TRUE;
+      break;
+    }
+  }
+  return NULL;
+} /* of 'initrange' */
+
+static Bool initcells(Cell grid[],                  /* cell grid */
+                      const unsigned int soilcodes[], /* soil codes of cells */
+                      Bool isnew,                   /* no restart file read */
+                      int npft,                     /* number of natural PFTs */
+                      int ncft,                     /* number of crop PFTs */
+                      const Config *config          /* LPJ configuration */
+                     )                              /* returns TRUE on error */
+{
+  Initdata *data;
+  int t,nthreads;
+  Bool rc;
+#ifndef _WIN32
+  pthread_t *threads;
+  int nstarted;
+#endif
+  nthreads=min(config->nthreads,config->ngridcell);
+  if(nthreads<1)
+    nthreads=1;
+  data=newvec(Initdata,nthreads);
+  checkalloc(data);
+  for(t=0;t<nthreads;t++)
+  {
+    data[t].grid=grid;
+    data[t].soilcodes=soilcodes;
+    data[t].isnew=isnew;
+    data[t].first=(int)((long long)config->ngridcell*t/nthreads);
+    data[t].last=(int)((long long)config->ngridcell*(t+1)/nthreads);
+    data[t].npft=npft;
+    data[t].ncft=ncft;
+    data[t].config=config;
+  }
+#ifndef _WIN32
+  if(nthreads>1)
+  {
+    threads=newvec(pthread_t,nthreads-1);
+    if(threads==NULL)
+    {
+      printallocerr("threads");
+      free(data);
+      return TRUE;
+    }
+    for(nstarted=1;nstarted<nthreads;nstarted++)
+      if(pthread_create(threads+nstarted-1,NULL,initrange,data+nstarted))
+        break;
+    /* ranges of threads that could not be created are initialized here */
+    for(t=nstarted;t<nthreads;t++)
+      initrange(data+t);
+    initrange(data);
+    for(t=1;t<nstarted;t++)
+      pthread_join(threads[t-1],NULL);
+    free(threads);
+  }
+  else
+#endif
+    for(t=0;t<nthreads;t++)
+      initrange(data+t);
+  rc=FALSE;
+  for(t=0;t<nthreads;t++)
+    rc|=data[t].rc;
+  free(data);
+  return rc;
+} /* of 'initcells' */
+
 static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration */
                       int *count,
                       const Standtype standtype[], /* array of stand types */
                       int nstand,              /* number of stand types */
                       int npft,                /* number of natural PFTs */
-                      int ncft                 /* number of crop PFTs */
+                      int ncft,                /* number of crop PFTs */
+                      double tphase[],         /* time spent in phases (sec) */
+                      double *restart_bytes    /* number of bytes read from restart file */
                      ) /* returns allocated cell grid or NULL */
 {
   Cell *grid;
   Header header;
   String headername;
-  Stand *stand;
-  int i,n,l,j,data;
+  int i,j,data;
   int version;
-  int cft;
   size_t offset;
   long country_offset;
   Celldata celldata;
@@ -45,9 +201,14 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
   Bool swap_grassfix;
   Type grassfix_datatype;
   Infile grassfix_file;
-  unsigned int soilcode;
+  unsigned int soilcode,*soilcodes;
+  int *codes,*grassfix;
+  Real *lakefracs;
+  double tstart;
+  Bool selected,*selection;
   Code code;
   FILE *file_restart;
+  long long *restart_index;
   Infile lakes,countrycode,regioncode;
 #ifdef IMAGE
   Productinit *productinit;
@@ -60,6 +221,11 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
   }
 #endif
 
+  if(config->cellsel==CELLSEL_COUNTRY && config->countrypar==NULL)
+  {
+    fputs("ERROR258: Country selection requires country codes, land use must be enabled.\n",stderr);
+    return NULL;
+  }
   /* Open coordinate and soil file */
   celldata=opencelldata(config);
   if(celldata==NULL)
@@ -281,7 +447,7 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
   }
   else
   {
-    file_restart=openrestart((config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,config,npft+ncft,&swap_restart);
+    file_restart=openrestart2((config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,config,npft+ncft,&swap_restart,&restart_index);
     if(file_restart==NULL)
     {
       free(grid);
@@ -305,12 +471,62 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     }
   }
   *count=0;
-  for(i=0;i<config->ngridcell;i++)
+  /* read static cell data of all cells */
+  tstart=mrun();
+  soilcodes=newvec(unsigned int,config->ngridcell);
+  checkptr(soilcodes);
+  if(file_restart!=NULL)
+  {
+    selection=newvec(Bool,config->ngridcell);
+    checkptr(selection);
+  }
+  else
+    selection=NULL;
+  if(readallcelldata(celldata,grid,soilcodes,config))
+    return NULL;
+  codes=grassfix=NULL;
+  lakefracs=NULL;
+  if(config->countrypar!=NULL)
   {
-    /* read cell coordinate and soil code from file */
-    if(readcelldata(celldata,&grid[i].coord,&soilcode,&grid[i].discharge.runoff2ocean_coord,i,config))
+    if(config->countrycode_filename.fmt!=CDF && config->ngridcell>0)
+    {
+      codes=newvec(int,2*config->ngridcell);
+      checkptr(codes);
+      if(readintvec(countrycode.file,codes,2*config->ngridcell,swap_cow,cow_type))
+      {
+        fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cells %d-%d.\n",
+                config->countrycode_filename.name,config->startgrid,config->startgrid+config->ngridcell-1);
+        return NULL;
+      }
+    }
+    if(config->grassfix_filename.name!=NULL && config->grassfix_filename.fmt!=CDF && config->ngridcell>0)
+    {
+      grassfix=newvec(int,config->ngridcell);
+      checkptr(grassfix);
+      if(readintvec(grassfix_file.file,grassfix,config->ngridcell,swap_grassfix,grassfix_datatype))
+      {
+        fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cells %d-%d.\n",
+                config->grassfix_filename.name,config->startgrid,config->startgrid+config->ngridcell-1);
+        return NULL;
+      }
+    }
+  }
+  if(config->river_routing && config->lakes_filename.fmt!=CDF && config->ngridcell>0)
+  {
+    lakefracs=newvec(Real,config->ngridcell);
+    checkptr(lakefracs);
+    if(readrealvec(lakes.file,lakefracs,0,lake_scalar,config->ngridcell,swap_lakes,lake_datatype))
+    {
+      fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cells %d-%d.\n",
+              config->lakes_filename.name,config->startgrid,config->startgrid+config->ngridcell-1);
       return NULL;
-
+    }
+  }
+  tphase[0]=mrun()-tstart;
+  tstart=mrun();
+  for(i=0;i<config->ngridcell;i++)
+  {
+    soilcode=soilcodes[i];
     if(config->countrypar!=NULL)
     {
       if(config->countrycode_filename.fmt==CDF)
@@ -326,14 +542,11 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
       }
       else
       {
-        if(readcountrycode(countrycode.file,&code,cow_type,swap_cow))
-        {
-          fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
-                  config->countrycode_filename.name,i+config->startgrid);
-          return NULL;
-        }
+        code.country=(short)codes[2*i];
+        code.region=(short)codes[2*i+1];
       }
-      if(soilcode>=1 && soilcode<=config->nsoil)
+      selected=iscellselected(config,i+config->startgrid,&grid[i].coord,code.country);
+      if(selected && soilcode>=1 && soilcode<=config->nsoil)
       {
         if(code.country<0 || code.country>=config->ncountries ||
            code.region<0 || code.region>=config->nregions)
@@ -356,19 +569,14 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
           }
         }
         else
-        {
-          if(readintvec(grassfix_file.file,&grid[i].ml.fixed_grass_pft,1,swap_grassfix,grassfix_datatype))
-          {
-            fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
-                    config->grassfix_filename.name,i+config->startgrid);
-            return NULL;
-          }
-        }
+          grid[i].ml.fixed_grass_pft=grassfix[i];
       }
       else
         grid[i].ml.fixed_grass_pft= -1;
 
      }
+    else
+      selected=iscellselected(config,i+config->startgrid,&grid[i].coord,-1);
     grid[i].lakefrac=0.0;
     if(config->river_routing)
     {
@@ -382,14 +590,7 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
         }
       }
       else
-      {
-        if(readrealvec(lakes.file,&grid[i].lakefrac,0,lake_scalar,1,swap_lakes,lake_datatype))
-        {
-          fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
-                  config->lakes_filename.name,i+config->startgrid);
-          return NULL;
-        }
-      }
+        grid[i].lakefrac=lakefracs[i];
     }
     /* Init cells */
     grid[i].ml.dam=FALSE;
@@ -438,72 +639,73 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     }
     if(file_restart==NULL)
     {
-      if(soilcode<1 || soilcode>config->nsoil)
+      if(!selected)
+        grid[i].skip=TRUE; /* cell not part of cell selection */
+      else if(soilcode<1 || soilcode>config->nsoil)
       {
         (*count)++;
         fprintf(stderr,"Invalid soilcode=%u, cell %d skipped\n",soilcode,i+config->startgrid);
         grid[i].skip=TRUE;
       }
       else
-      {
         grid[i].skip=FALSE;
-        grid[i].standlist=newlist();
-        checkptr(grid[i].standlist);
-        grid[i].gdd=newgdd(npft);
-        checkptr(grid[i].gdd);
-        grid[i].ml.sowing_month=newvec(int,2*ncft);
-        checkptr(grid[i].ml.sowing_month);
-        grid[i].ml.gs=newvec(int,2*ncft);
-        checkptr(grid[i].ml.gs);
-        for(l=0;l<2*ncft;l++)
-        {
-          grid[i].ml.sowing_month[l]=0;
-          grid[i].ml.gs[l]=0;
-        }
-        if(grid[i].lakefrac<1)
-        {
-          n=addstand(&natural_stand,grid+i);
-          stand=getstand(grid[i].standlist,n-1);
-          stand->frac=1-grid[i].lakefrac;
-          if(initsoil(&stand->soil,config->soilpar+soilcode-1,npft+ncft))
-            return NULL;
-          for(l=0;l<FRACGLAYER;l++)
-            stand->frac_g[l]=1.0;
-        }
-        if(new_climbuf(&grid[i].climbuf))
-        {
-          printallocerr("climbuf");
-          return NULL;
-        }
-        grid[i].ml.cropdates=init_cropdates(config->pftpar+npft,ncft,grid[i].coord.lat);
-        checkptr(grid[i].ml.cropdates);
-        if(config->sdate_option>NO_FIXED_SDATE)
-        {
-          grid[i].ml.sdate_fixed=newvec(int,2*ncft);
-          checkptr(grid[i].ml.sdate_fixed);
-          for(cft=0;cft<2*ncft;cft++)
-            grid[i].ml.sdate_fixed[cft]=0;
-        }
-        else
-          grid[i].ml.sdate_fixed=NULL;
-      }
     }
-    else /* read cell data from restart file */
+    else
+      selection[i]=selected; /* cell data are read from restart file below */
+  } /* of for(i=0;...) */
+  free(codes);
+  free(grassfix);
+  free(lakefracs);
+  tphase[1]=mrun()-tstart;
+  if(file_restart!=NULL)
+  {
+    /* read cell state of all cells from restart file */
+    tstart=mrun();
+    if(freadcells(file_restart,restart_index,grid,soilcodes,npft,ncft,
+                  standtype,nstand,swap_restart,
+                  (config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,
+                  config))
+      return NULL;
+    tphase[4]=mrun()-tstart;
+    *restart_bytes=(double)(restart_index[config->ngridcell]-restart_index[0]);
+    free(restart_index);
+    for(i=0;i<config->ngridcell;i++)
     {
-      if(freadcell(file_restart,grid+i,npft,ncft,
-                   config->soilpar+soilcode-1,standtype,nstand,
-                   swap_restart,config))
+      if(!grid[i].skip && !selection[i])
       {
-        fprintf(stderr,"ERROR190: Unexpected end of file in '%s' for cell %d.\n",
-                (config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,i+config->startgrid);
-        return NULL;
+        /* cell not part of cell selection, release cell state read */
+        while(!isempty(grid[i].standlist))
+          delstand(grid[i].standlist,0);
+        freelist(grid[i].standlist);
+        freeclimbuf(&grid[i].climbuf);
+        freecropdates(grid[i].ml.cropdates);
+        free(grid[i].gdd);
+        free(grid[i].ml.sowing_month);
+        free(grid[i].ml.gs);
+        free(grid[i].ml.sdate_fixed);
+        grid[i].skip=TRUE;
       }
-      if(!grid[i].skip)
+      else if(!grid[i].skip)
         check_stand_fracs(grid+i,
                           grid[i].lakefrac+grid[i].ml.reservoirfrac);
-      else
+      else if(selection[i])
         (*count)++;
-    }
+    } /* of for(i=0;...) */
+    free(selection);
+  }
+  else
+  {
+    tphase[4]=0;
+    *restart_bytes=0;
+  }
+  /* initialize cell state and output in parallel, cells are independent */
+  tstart=mrun();
+  if(initcells(grid,soilcodes,file_restart==NULL,npft,ncft,config))
+    return NULL;
+  free(soilcodes);
+  tphase[2]=mrun()-tstart;
+  for(i=0;i<config->ngridcell;i++)
+  {
     if(!grid[i].skip)
     {
       config->count++;
@@ -518,11 +720,17 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
       grid[i].ml.image_data=NULL;
 #endif
     }
-    if(initoutput(&grid[i].output,config->crop_index,config->crop_irrigation,
-                  npft,config->nbiomass,ncft))
-      return NULL;
-
   } /* of for(i=0;...) */
+  /* list of active cells for output and cell loops */
+  config->activecell=newvec(int,max(config->count,1));
+  checkptr(config->activecell);
+  config->cellorder=newvec(int,max(config->count,1));
+  checkptr(config->cellorder);
+  config->count=0;
+  for(i=0;i<config->ngridcell;i++)
+    if(!grid[i].skip)
+      config->activecell[config->count++]=i;
+  ordercells(config->cellorder,grid,config);
   if(file_restart!=NULL)
     fclose(file_restart);
   closecelldata(celldata);
@@ -549,12 +757,14 @@ Cell *newgrid(Config *config,          /**< Pointer to LPJ configuration */
              ) /** \return allocated cell grid or NULL */
 {
 #ifdef USE_MPI
-  int *counts,i;
+  int *counts;
 #endif
+  int i;
   int count,count_total;
   Bool iserr;
   Cell *grid;
-  grid=newgrid2(config,&count,standtype,nstand,npft,ncft);
+  double tphase[5],tmax[5],tstart,restart_bytes,restart_bytes_total;
+  grid=newgrid2(config,&count,standtype,nstand,npft,ncft,tphase,&restart_bytes);
   iserr=(grid==NULL);
 #ifdef USE_MPI
   counts=newvec(int,config->ntask);
@@ -585,6 +795,7 @@ Cell *newgrid(Config *config,          /**< Pointer to LPJ configuration */
   }
   if(isroot(*config) && count_total)
     printf("Invalid soil code in %d cells.\n",count_total);
+  tstart=mrun();
   if(config->river_routing)
   {
     /* initialize river-routing network */
@@ -601,5 +812,23 @@ Cell *newgrid(Config *config,          /**< Pointer to LPJ configuration */
     if(initignition(grid,config))
       return NULL;
   }
+  tphase[3]=mrun()-tstart;
+#ifdef USE_MPI
+  MPI_Reduce(tphase,tmax,5,MPI_DOUBLE,MPI_MAX,0,config->comm);
+  MPI_Reduce(&restart_bytes,&restart_bytes_total,1,MPI_DOUBLE,MPI_SUM,0,config->comm);
+#else
+  for(i=0;i<5;i++)
+    tmax[i]=tphase[i];
+  restart_bytes_total=restart_bytes;
+#endif
+  if(isroot(*config))
+  {
+    printf("Grid initialization: read %.2f sec, setup %.2f sec, init %.2f sec, routing %.2f sec\n",
+           tmax[0],tmax[1],tmax[2],tmax[3]);
+    if(restart_bytes_total>0)
+      printf("Restart file decoded: %.1f MB in %.2f sec, %.1f MB/sec\n",
+             restart_bytes_total/1e6,tmax[4],
+             (tmax[4]>0) ? restart_bytes_total/1e6/tmax[4] : 0);
+  }
   return grid;
 } /* of 'newgrid' */
@@ -69,6 +69,20 @@ FILE *openconfig(Config *config,      /**< configuration struct */
   env_options=getenv(LPJOUTPUTMETHOD);
   config->port=DEFAULT_PORT;
   config->param_out=FALSE;
+  config->climate_buffer=1; /* no read-ahead of climate data */
+  config->infil_solver=INFIL_SLUG;
+  config->async_restart=FALSE;
+  config->socket_version=1;
+  config->socket_rle=FALSE;
+  config->daily_buffer=DAILY_NOBUFFER;
+  config->cellsel=NO_CELLSEL;
+  config->nthreads=1;
+  config->dryrun=FALSE;
+  config->memdump_filename=NULL;
+  config->cellsel_list=NULL;
+  config->cellsel_n=0;
+  config->cellsel_cells=NULL;
+  config->cellsel_ncell=0;
   config->scan_verbose=ERR; /* NO_ERR would suppress also error messages */
 #ifdef IMAGE
   config->image_inport=DEFAULT_IMAGE_INPORT;
@@ -286,6 +300,36 @@ FILE *openconfig(Config *config,      /**< configuration struct */
 #endif
       else if(!strcmp((*argv)[i],"-param"))
         config->param_out=TRUE;
+      else if(!strcmp((*argv)[i],"-asyncrestart"))
+        config->async_restart=TRUE;
+      else if(!strcmp((*argv)[i],"-dryrun"))
+        config->dryrun=TRUE;
+      else if(!strcmp((*argv)[i],"-memdump"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-memdump' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        else
+        {
+          free(config->memdump_filename);
+          config->memdump_filename=strdup((*argv)[++i]);
+        }
+      }
+      else if(!strcmp((*argv)[i],"-socketv2"))
+        config->socket_version=2;
+      else if(!strcmp((*argv)[i],"-socketrle"))
+      {
+        config->socket_version=2;
+        config->socket_rle=TRUE;
+      }
       else if(!strcmp((*argv)[i],"-vv"))
         config->scan_verbose=VERB;
       else if(!strcmp((*argv)[i],"-inpath"))
@@ -328,6 +372,185 @@ FILE *openconfig(Config *config,      /**< configuration struct */
           config->outputdir=strdup((*argv)[++i]);
         }
       }
+      else if(!strcmp((*argv)[i],"-climatebuffer"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-climatebuffer' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        else
+        {
+          config->climate_buffer=strtol((*argv)[++i],&endptr,10);
+          if(*endptr!='\0' || config->climate_buffer<1)
+          {
+            if(isroot(*config))
+              fprintf(stderr,"ERROR252: Invalid number '%s' for '-climatebuffer' option.\n",(*argv)[i]);
+            free(options);
+            return NULL;
+          }
+        }
+      }
+      else if(!strcmp((*argv)[i],"-threads"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-threads' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        else
+        {
+          config->nthreads=strtol((*argv)[++i],&endptr,10);
+          if(*endptr!='\0' || config->nthreads<1)
+          {
+            if(isroot(*config))
+              fprintf(stderr,"ERROR263: Invalid number '%s' for '-threads' option.\n",(*argv)[i]);
+            free(options);
+            return NULL;
+          }
+        }
+      }
+      else if(!strcmp((*argv)[i],"-infil"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-infil' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        else if(!strcmp((*argv)[i+1],"slug"))
+          config->infil_solver=INFIL_SLUG;
+        else if(!strcmp((*argv)[i+1],"adaptive"))
+          config->infil_solver=INFIL_ADAPTIVE;
+        else if(!strcmp((*argv)[i+1],"verify"))
+          config->infil_solver=INFIL_VERIFY;
+        else
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR253: Invalid infiltration solver '%s'.\n",
+                    (*argv)[i+1]);
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        i++;
+      }
+      else if(!strcmp((*argv)[i],"-dailybuffer"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-dailybuffer' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        else if(!strcmp((*argv)[i+1],"day"))
+          config->daily_buffer=DAILY_NOBUFFER;
+        else if(!strcmp((*argv)[i+1],"month"))
+          config->daily_buffer=DAILY_MONTH;
+        else if(!strcmp((*argv)[i+1],"year"))
+          config->daily_buffer=DAILY_YEAR;
+        else
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR255: Invalid block '%s' for daily output buffer.\n",
+                    (*argv)[i+1]);
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        i++;
+      }
+      else if(!strcmp((*argv)[i],"-cells"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-cells' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        if(readcellsel(config,(*argv)[++i],CELLSEL_LIST))
+        {
+          if(isroot(*config) && usage!=NULL)
+            fprintf(stderr,usage,(*argv)[0]);
+          free(options);
+          return NULL;
+        }
+      }
+      else if(!strcmp((*argv)[i],"-country"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-country' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        if(readcellsel(config,(*argv)[++i],CELLSEL_COUNTRY))
+        {
+          if(isroot(*config) && usage!=NULL)
+            fprintf(stderr,usage,(*argv)[0]);
+          free(options);
+          return NULL;
+        }
+      }
+      else if(!strcmp((*argv)[i],"-box"))
+      {
+        if(i==*argc-1)
+        {
+          if(isroot(*config))
+          {
+            fprintf(stderr,"ERROR164: Argument missing for '-box' option.\n");
+            if(usage!=NULL)
+              fprintf(stderr,usage,(*argv)[0]);
+          }
+          free(options);
+          return NULL;
+        }
+        if(readcellsel(config,(*argv)[++i],CELLSEL_BOX))
+        {
+          if(isroot(*config) && usage!=NULL)
+            fprintf(stderr,usage,(*argv)[0]);
+          free(options);
+          return NULL;
+        }
+      }
       else if(!strcmp((*argv)[i],"-restartpath"))
       {
         if(i==*argc-1)
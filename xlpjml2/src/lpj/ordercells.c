@@ -0,0 +1,58 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                       o  r  d  e  r  c  e  l  l  s  .  c                       \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function orders cells with valid soil code by their computational          \n**/
+/**     costs given by the number of stands. Cells with more stands come           \n**/
+/**     first, cells with equal costs are kept in file order                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_GRID
+
+#include "lpj.h"
+
+int ordercells(int cellorder[],      /**< indices of cells ordered by costs */
+               const Cell grid[],    /**< cell grid */
+               const Config *config  /**< LPJ configuration */
+              )                      /** \return number of cells ordered */
+{
+  int i,cell,n,nmax,*start;
+  /* counting sort of cells by number of stands, cells can be skipped
+     during the run because of missing climate data */
+  nmax=0;
+  foreachactivecell(i,cell,config)
+    if(!grid[cell].skip)
+      nmax=max(nmax,getlistlen(grid[cell].standlist));
+  start=newvec(int,nmax+2);
+  if(start==NULL)
+  {
+    /* keep file order */
+    n=0;
+    foreachactivecell(i,cell,config)
+      if(!grid[cell].skip)
+        cellorder[n++]=cell;
+    return n;
+  }
+  for(i=0;i<=nmax+1;i++)
+    start[i]=0;
+  foreachactivecell(i,cell,config)
+    if(!grid[cell].skip)
+      start[nmax-getlistlen(grid[cell].standlist)+1]++;
+  for(i=1;i<=nmax+1;i++)
+    start[i]+=start[i-1];
+  n=start[nmax+1];
+  foreachactivecell(i,cell,config)
+    if(!grid[cell].skip)
+      cellorder[start[nmax-getlistlen(grid[cell].standlist)]++]=cell;
+  free(start);
+  return n;
+} /* of 'ordercells' */
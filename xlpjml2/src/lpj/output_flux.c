@@ -0,0 +1,31 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     o  u  t  p  u  t  _  f  l  u  x  .  c                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function sends global fluxes using socket connection                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void output_flux(Outputfile *output, /**< output data */
+                 const Flux *flux,   /**< global carbon and water fluxes */
+                 int year            /**< simulation year (AD) */
+                )
+{
+  if(output->sendbuf==NULL)
+    writedouble_socket(output->socket,(const Real *)flux,sizeof(Flux)/sizeof(Real));
+  else
+  {
+    add_sendbuffer(output->sendbuf,0,0,LPJ_DOUBLE,flux,sizeof(Flux)/sizeof(Real));
+    flush_sendbuffer(output->sendbuf,year,SOCKET_FLUX);
+  }
+} /* of 'output_flux' */
@@ -0,0 +1,127 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                    p  r  i  n  t  m  e  m  s  t  a  t  .  c                    \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function prints memory report. Memory allocated by subsystems              \n**/
+/**     is printed if compiled with -DWITH_MEMSTAT, maximum resident set           \n**/
+/**     size is always printed. Report of all tasks is optionally                  \n**/
+/**     written to a file in CSV format                                            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define LIVE_TOTAL (3*NMEMTAG)   /* index of live bytes of all subsystems */
+#define PEAK_TOTAL (3*NMEMTAG+1) /* index of peak bytes of all subsystems */
+#define MAXRSS (3*NMEMTAG+2)     /* index of maximum resident set size */
+#define PROJECTED (3*NMEMTAG+3)  /* index of projected additional bytes */
+#define NITEM (3*NMEMTAG+4)      /* number of items per task */
+
+#define MB (1024.0*1024.0)
+
+static void fprintdump(FILE *file,const char *phase,const double item[],int ntask)
+{
+  int i,tag;
+  for(i=0;i<ntask;i++)
+  {
+    for(tag=0;tag<NMEMTAG;tag++)
+      fprintf(file,"%s,%d,%s,%.0f,%.0f,%.0f\n",phase,i,memtagnames[tag],
+              item[i*NITEM+tag],item[i*NITEM+NMEMTAG+tag],
+              item[i*NITEM+2*NMEMTAG+tag]);
+    fprintf(file,"%s,%d,total,,%.0f,%.0f\n",phase,i,
+            item[i*NITEM+LIVE_TOTAL],item[i*NITEM+PEAK_TOTAL]);
+    fprintf(file,"%s,%d,maxrss,,,%.0f\n",phase,i,item[i*NITEM+MAXRSS]);
+    if(item[i*NITEM+PROJECTED]>0)
+      fprintf(file,"%s,%d,projected,,%.0f,\n",phase,i,item[i*NITEM+PROJECTED]);
+  }
+} /* of 'fprintdump' */
+
+void printmemstat(const char *phase,    /**< phase of simulation */
+                  long long projected,  /**< projected additional memory (bytes) */
+                  const Config *config  /**< LPJ configuration */
+                 )
+{
+  static Bool isfirst=TRUE; /* dump file has to be created */
+  Memstat stat;
+  Bool isaccounted;
+  FILE *file;
+  double item[NITEM],sum[NITEM],max[NITEM],*all;
+  int tag;
+  isaccounted=getmemstat(&stat);
+  for(tag=0;tag<NMEMTAG;tag++)
+  {
+    item[tag]=(double)stat.count[tag];
+    item[NMEMTAG+tag]=(double)stat.live[tag];
+    item[2*NMEMTAG+tag]=(double)stat.peak[tag];
+  }
+  item[LIVE_TOTAL]=(double)stat.live_total;
+  item[PEAK_TOTAL]=(double)stat.peak_total;
+  item[MAXRSS]=(double)getmaxrss();
+  item[PROJECTED]=(double)projected;
+#ifdef USE_MPI
+  MPI_Reduce(item,sum,NITEM,MPI_DOUBLE,MPI_SUM,0,config->comm);
+  MPI_Reduce(item,max,NITEM,MPI_DOUBLE,MPI_MAX,0,config->comm);
+  all=NULL;
+  if(config->memdump_filename!=NULL)
+  {
+    if(isroot(*config))
+    {
+      all=newvec(double,NITEM*config->ntask);
+      if(all==NULL)
+        printallocerr("all");
+    }
+    MPI_Gather(item,NITEM,MPI_DOUBLE,all,NITEM,MPI_DOUBLE,0,config->comm);
+  }
+#else
+  for(tag=0;tag<NITEM;tag++)
+    sum[tag]=max[tag]=item[tag];
+  all=item;
+#endif
+  if(isroot(*config))
+  {
+    printf("Memory after %s:\n",phase);
+    if(isaccounted)
+    {
+      printf("Subsystem     Allocations Total (MB) Max/task (MB) Peak/task (MB)\n"
+             "------------- ----------- ---------- ------------- --------------\n");
+      for(tag=0;tag<NMEMTAG;tag++)
+        printf("%-13s %11.0f %10.1f %13.1f %14.1f\n",memtagnames[tag],
+               sum[tag],sum[NMEMTAG+tag]/MB,max[NMEMTAG+tag]/MB,
+               max[2*NMEMTAG+tag]/MB);
+      printf("------------- ----------- ---------- ------------- --------------\n"
+             "%-13s %11s %10.1f %13.1f %14.1f\n","Total","",
+             sum[LIVE_TOTAL]/MB,max[LIVE_TOTAL]/MB,max[PEAK_TOTAL]/MB);
+    }
+    printf("Maximum resident set size: %.1f MB per task, %.1f MB total\n",
+           max[MAXRSS]/MB,sum[MAXRSS]/MB);
+    if(max[PROJECTED]>0)
+      printf("Projected additional memory: %.1f MB per task, %.1f MB total\n",
+             max[PROJECTED]/MB,sum[PROJECTED]/MB);
+    if(config->memdump_filename!=NULL && all!=NULL)
+    {
+      file=fopen(config->memdump_filename,(isfirst) ? "w" : "a");
+      if(file==NULL)
+        printfopenerr(config->memdump_filename);
+      else
+      {
+        if(isfirst)
+          fputs("phase,task,subsystem,allocations,live_bytes,peak_bytes\n",file);
+        fprintdump(file,phase,all,config->ntask);
+        fclose(file);
+      }
+    }
+    fflush(stdout);
+  }
+  isfirst=FALSE;
+#ifdef USE_MPI
+  free(all);
+#endif
+} /* of 'printmemstat' */
@@ -0,0 +1,37 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     p  r  i  n  t  p  h  a  s  e  s  .  c                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function prints time spent in the phases of the simulation years.          \n**/
+/**     Maximum over all tasks is printed                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void printphases(const double tphase[], /**< time spent in phases (sec) */
+                 const Config *config   /**< LPJ configuration */
+                )
+{
+  double tmax[NPHASE];
+#ifdef USE_MPI
+  MPI_Reduce((double *)tphase,tmax,NPHASE,MPI_DOUBLE,MPI_MAX,0,config->comm);
+#else
+  int i;
+  for(i=0;i<NPHASE;i++)
+    tmax[i]=tphase[i];
+#endif
+  if(isroot(*config))
+    printf("Time in phases: land use %.2f sec, daily %.2f sec, routing %.2f sec,\n"
+           "                monthly %.2f sec, annual %.2f sec, output %.2f sec\n",
+           tmax[LANDUSE_PHASE],tmax[DAILY_PHASE],tmax[ROUTING_PHASE],
+           tmax[MONTHLY_PHASE],tmax[ANNUAL_PHASE],tmax[OUTPUT_PHASE]);
+} /* of 'printphases' */
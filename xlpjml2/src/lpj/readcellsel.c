@@ -0,0 +1,124 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     r  e  a  d  c  e  l  l  s  e  l  .  c                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads cell selection from command line argument. Argument         \n**/
+/**     is a file with global cell indices, a list of country codes or a           \n**/
+/**     longitude/latitude box lonmin,latmin,lonmax,latmax                         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static int cmpint(const void *a,const void *b)
+{
+  return *(const int *)a-*(const int *)b;
+} /* of 'cmpint' */
+
+static Bool addcellsel(Config *config,int index)
+{
+  int *list;
+  list=realloc(config->cellsel_list,sizeof(int)*(config->cellsel_n+1));
+  if(list==NULL)
+  {
+    printallocerr("cellsel_list");
+    return TRUE;
+  }
+  config->cellsel_list=list;
+  config->cellsel_list[config->cellsel_n++]=index;
+  return FALSE;
+} /* of 'addcellsel' */
+
+Bool readcellsel(Config *config, /**< LPJmL configuration */
+                 const char *arg, /**< command line argument */
+                 int mode         /**< CELLSEL_LIST, CELLSEL_COUNTRY or CELLSEL_BOX */
+                )                 /** \return TRUE on error */
+{
+  FILE *file;
+  const char *s;
+  char *end;
+  int index;
+  config->cellsel=mode;
+  config->cellsel_n=0;
+  free(config->cellsel_list);
+  config->cellsel_list=NULL;
+  switch(mode)
+  {
+    case CELLSEL_LIST:
+      file=fopen(arg,"r");
+      if(file==NULL)
+      {
+        if(isroot(*config))
+          printfopenerr(arg);
+        return TRUE;
+      }
+      while(fscanf(file,"%d",&index)==1)
+      {
+        if(index<0)
+        {
+          if(isroot(*config))
+            fprintf(stderr,"ERROR256: Invalid cell index %d in '%s'.\n",index,arg);
+          fclose(file);
+          return TRUE;
+        }
+        if(addcellsel(config,index))
+        {
+          fclose(file);
+          return TRUE;
+        }
+      }
+      if(!feof(file))
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR256: Invalid cell index in '%s'.\n",arg);
+        fclose(file);
+        return TRUE;
+      }
+      fclose(file);
+      break;
+    case CELLSEL_COUNTRY:
+      s=arg;
+      do
+      {
+        index=(int)strtol(s,&end,10);
+        if(end==s || (*end!=',' && *end!='\0'))
+        {
+          if(isroot(*config))
+            fprintf(stderr,"ERROR256: Invalid country code list '%s'.\n",arg);
+          return TRUE;
+        }
+        if(addcellsel(config,index))
+          return TRUE;
+        s=end+1;
+      }while(*end==',');
+      break;
+    case CELLSEL_BOX:
+      if(sscanf(arg,"%lf,%lf,%lf,%lf",config->cellsel_box,config->cellsel_box+1,
+                config->cellsel_box+2,config->cellsel_box+3)!=4 ||
+         config->cellsel_box[0]>config->cellsel_box[2] ||
+         config->cellsel_box[1]>config->cellsel_box[3])
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR256: Invalid box '%s', must be lonmin,latmin,lonmax,latmax.\n",arg);
+        return TRUE;
+      }
+      return FALSE;
+  }
+  if(config->cellsel_n==0)
+  {
+    if(isroot(*config))
+      fprintf(stderr,"ERROR256: Empty cell selection '%s'.\n",arg);
+    return TRUE;
+  }
+  /* sort list for binary search in iscellselected() */
+  qsort(config->cellsel_list,config->cellsel_n,sizeof(int),cmpint);
+  return FALSE;
+} /* of 'readcellsel' */
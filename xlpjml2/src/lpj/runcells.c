@@ -0,0 +1,93 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                          r  u  n  c  e  l  l  s  .  c                          \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function calls a function for a list of grid cells. Cells are              \n**/
+/**     distributed round-robin over the threads, so that cells ordered            \n**/
+/**     by decreasing costs give balanced loads. Cells must be                     \n**/
+/**     independent of each other                                                  \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+typedef struct
+{
+  Cellfcn fcn;       /* function called for each cell */
+  Cell *grid;        /* cell grid */
+  const int *index;  /* indices of cells */
+  int first;         /* first element of index processed */
+  int n;             /* size of index vector */
+  int stride;        /* number of threads */
+  void *data;        /* data passed to function */
+} Rundata;
+
+static void *runrange(void *arg)
+{
+  Rundata *run;
+  int i;
+  run=arg;
+  for(i=run->first;i<run->n;i+=run->stride)
+    run->fcn(run->grid+run->index[i],run->index[i],run->data);
+  return NULL;
+} /* of 'runrange' */
+
+void runcells(Cellfcn fcn,          /**< function called for each cell */
+              Cell grid[],          /**< cell grid */
+              const int index[],    /**< indices of cells */
+              int n,                /**< number of cells */
+              void *data,           /**< data passed to function */
+              const Config *config  /**< LPJ configuration */
+             )
+{
+  int i;
+#ifndef _WIN32
+  Rundata *run;
+  pthread_t *threads;
+  int t,nthreads,nstarted;
+  nthreads=min(config->nthreads,n);
+  if(nthreads>1)
+  {
+    run=newvec(Rundata,nthreads);
+    threads=newvec(pthread_t,nthreads-1);
+    if(run!=NULL && threads!=NULL)
+    {
+      for(t=0;t<nthreads;t++)
+      {
+        run[t].fcn=fcn;
+        run[t].grid=grid;
+        run[t].index=index;
+        run[t].first=t;
+        run[t].n=n;
+        run[t].stride=nthreads;
+        run[t].data=data;
+      }
+      for(nstarted=1;nstarted<nthreads;nstarted++)
+        if(pthread_create(threads+nstarted-1,NULL,runrange,run+nstarted))
+          break;
+      /* cells of threads that could not be created are processed here */
+      for(t=nstarted;t<nthreads;t++)
+        runrange(run+t);
+      runrange(run);
+      for(t=1;t<nstarted;t++)
+        pthread_join(threads[t-1],NULL);
+      free(threads);
+      free(run);
+      return;
+    }
+    /* not enough memory for threads, process cells sequentially */
+    free(threads);
+    free(run);
+  }
+#endif
+  for(i=0;i<n;i++)
+    fcn(grid+index[i],index[i],data);
+} /* of 'runcells' */
@@ -14,6 +14,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STAND
+
 #include "lpj.h"
 #include "natural.h"
 
@@ -101,6 +103,7 @@ int addstand(const Standtype *type, /**< stand type */
    /* call stand-specific allocation function */
    initstand(stand);
    stand->type->newstand(stand);
+   updatestandindex(cell);
    return getlistlen(cell->standlist);
 } /* of 'addstand' */
 
@@ -130,11 +133,48 @@ int delstand(Standlist list, /**< stand list */
 {
   /* Function deletes stand from list */
   Stand *stand;
+  Cell *cell;
+  int n;
   stand=getstand(list,index);
+  cell=stand->cell;
   freestand(stand);
-  return dellistitem(list,index);
+  /* last stand is moved to index, index has to be updated */
+  n=dellistitem(list,index);
+  updatestandindex(cell);
+  return n;
 } /* of 'delstand' */
 
+void updatestandindex(Cell *cell /**< cell pointer */
+                     )
+{
+  /* Function rebuilds index of stands by land-use type */
+  Stand *stand;
+  int s,t;
+  for(t=0;t<NLANDUSETYPE;t++)
+  {
+    cell->standindex.first[t]=NOT_FOUND;
+    cell->standindex.n[t]=0;
+  }
+  /* stands are linked backwards to keep order of stand list */
+  for(s=getlistlen(cell->standlist)-1;s>=0;s--)
+  {
+    stand=getstand(cell->standlist,s);
+    t=stand->type->landusetype;
+    stand->next=cell->standindex.first[t];
+    cell->standindex.first[t]=s;
+    cell->standindex.n[t]++;
+  }
+} /* of 'updatestandindex' */
+
+void setstandtype(Stand *stand,          /**< pointer to stand */
+                  const Standtype *type  /**< new stand type */
+                 )
+{
+  /* Function changes type of stand in list */
+  stand->type=type;
+  updatestandindex(stand->cell);
+} /* of 'setstandtype' */
+
 void freestandlist(Standlist standlist /**< stand list */
                   )
 {
@@ -0,0 +1,63 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 w  r  i  t  e  a  g  g  r  e  g  a  t  e  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes output aggregated by country, region or basin.             \n**/
+/**     Cell values are weighted by cell area and summed up for each bin.          \n**/
+/**     Sums of all tasks are reduced to the root task                             \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void writeaggregate(Outputfile *output, /**< output data */
+                    int index,          /**< index of output file */
+                    const float data[], /**< unscaled output of active cells */
+                    const Config *config /**< LPJmL configuration */
+                   )
+{
+  int i;
+  Aggregate *aggregate;
+  Real *sum;
+  float *vec;
+  aggregate=output->aggregate+output->files[index].aggregate;
+  for(i=0;i<aggregate->nbin;i++)
+    aggregate->sum[i]=0;
+  for(i=0;i<config->count;i++)
+    if(aggregate->bin[i]>=0)
+      aggregate->sum[aggregate->bin[i]]+=output->area[i]*data[i];
+#ifdef USE_MPI
+  MPI_Reduce(aggregate->sum,aggregate->sum_all,aggregate->nbin,MPI_DOUBLE,
+             MPI_SUM,0,config->comm);
+  sum=aggregate->sum_all;
+#else
+  sum=aggregate->sum;
+#endif
+  if(isroot(*config) && aggregate->nbin>0)
+  {
+    vec=getoutputbuffer(&output->gather,sizeof(float)*aggregate->nbin);
+    /* scale and offset are applied once to the area-weighted sum of each bin */
+    for(i=0;i<aggregate->nbin;i++)
+      vec[i]=(float)(config->outnames[index].scale*sum[i]+config->outnames[index].offset);
+    switch(output->files[index].fmt)
+    {
+      case RAW: case CLM:
+        if(fwrite(vec,sizeof(float),aggregate->nbin,output->files[index].fp.file)!=aggregate->nbin)
+          fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
+        break;
+      case TXT:
+        for(i=0;i<aggregate->nbin-1;i++)
+          fprintf(output->files[index].fp.file,"%g ",vec[i]);
+        fprintf(output->files[index].fp.file,"%g\n",vec[aggregate->nbin-1]);
+        break;
+    }
+  }
+} /* of 'writeaggregate' */
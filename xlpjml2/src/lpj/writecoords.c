@@ -15,6 +15,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_OUTPUT
+
 #include "lpj.h"
 
 int writecoords(Outputfile *output,  /**< output struct */
@@ -27,7 +29,6 @@ int writecoords(Outputfile *output,  /**< output struct */
   Intcoord *dst=NULL;
   MPI_Datatype type;
   MPI_Status status;
-  int *offsets,*counts;
 #endif
   Bool rc;
   int cell,count;
@@ -89,32 +90,8 @@ int writecoords(Outputfile *output,  /**< output struct */
     case LPJ_GATHER: case LPJ_SOCKET:
       if(output->method==LPJ_GATHER && output->files[index].fmt==CDF)
       {
-        rc=FALSE;
-        counts=newvec(int,config->ntask);
-        if(counts==NULL)
-        {
-          printallocerr("counts");
-          rc=TRUE;
-        }
-        offsets=newvec(int,config->ntask);
-        if(offsets==NULL)
-        {
-          printallocerr("offsets");
-          rc=TRUE;
-        }
-        if(iserror(rc,config))
-        {
-          free(soilcode);
-          free(counts);
-          free(offsets);
-          return 0;
-        }
-        getcounts(counts,offsets,config->nall,1,config->ntask);
         mpi_write_netcdf(&output->files[index].fp.cdf,soilcode,MPI_SHORT,
-                         config->nall,NO_TIME,
-                         counts,offsets,config->rank,config->comm);
-        free(counts);
-        free(offsets);
+                         NO_TIME,output->plan_all);
         free(soilcode);
       }
       else
@@ -138,13 +115,18 @@ int writecoords(Outputfile *output,  /**< output struct */
           free(vec);
           return 0;
         } 
-        MPI_Gatherv(vec,config->count,type,dst,output->counts,output->offsets,
-                    type,0,config->comm);
+        MPI_Gatherv(vec,config->count,type,dst,output->plan->counts,
+                    output->plan->offsets,type,0,config->comm);
         MPI_Type_free(&type);
         if(isroot(*config))
         {
           if(output->method==LPJ_SOCKET)
-            writeshort_socket(output->socket,dst,config->total*2);
+          {
+            if(output->sendbuf!=NULL)
+              add_sendbuffer(output->sendbuf,index,0,LPJ_SHORT,dst,config->total*2);
+            else
+              writeshort_socket(output->socket,dst,config->total*2);
+          }
           else
             switch(output->files[index].fmt)
             {
@@ -190,7 +172,10 @@ int writecoords(Outputfile *output,  /**< output struct */
     }
   else
   {
-    writeshort_socket(output->socket,vec,count*2);
+    if(output->sendbuf!=NULL)
+      add_sendbuffer(output->sendbuf,index,0,LPJ_SHORT,vec,count*2);
+    else
+      writeshort_socket(output->socket,vec,count*2);
     free(vec);
   }
 #endif
@@ -0,0 +1,117 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     w  r  i  t  e  l  a  y  e  r  s  .  c                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes output with several layers (PFTs, CFTs or soil             \n**/
+/**     layers) for one time step. Data of all layers are gathered with            \n**/
+/**     one collective call and written with one call to file, NetCDF or           \n**/
+/**     socket. Data are stored layer by layer in the buffer                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_OUTPUT
+
+#include "lpj.h"
+
+static void writeblock(Outputfile *output,int index,const void *data,Type type,
+                       int nlayer,int n,int time)
+{
+  int i,layer;
+  size_t size;
+  size=typesizes[type];
+  if(output->method==LPJ_SOCKET)
+  {
+    if(output->sendbuf!=NULL)
+      for(layer=0;layer<nlayer;layer++)
+        add_sendbuffer(output->sendbuf,index,layer,type,(const char *)data+size*n*layer,n);
+    else
+    {
+      writeint_socket(output->socket,&index,1);
+      write_socket(output->socket,data,size*n*nlayer);
+    }
+    return;
+  }
+  switch(output->files[index].fmt)
+  {
+    case RAW: case CLM:
+      if(fwrite(data,size,n*nlayer,output->files[index].fp.file)!=n*nlayer)
+        fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
+      break;
+    case TXT:
+      for(layer=0;layer<nlayer;layer++)
+      {
+        for(i=0;i<n;i++)
+          if(type==LPJ_FLOAT)
+            fprintf(output->files[index].fp.file,(i<n-1) ? "%g " : "%g\n",
+                    ((const float *)data)[layer*n+i]);
+          else
+            fprintf(output->files[index].fp.file,(i<n-1) ? "%d " : "%d\n",
+                    ((const short *)data)[layer*n+i]);
+      }
+      break;
+    case CDF:
+      write_pft_block_netcdf(&output->files[index].fp.cdf,data,type,time,nlayer,n);
+      break;
+  }
+} /* of 'writeblock' */
+
+void writelayers(Outputfile *output,   /**< output data */
+                 int index,            /**< index of output variable */
+                 void *data,           /**< data of all layers (count*nlayer) */
+                 Type type,            /**< datatype of data (LPJ_FLOAT, LPJ_SHORT) */
+                 int nlayer,           /**< number of layers */
+                 int step,             /**< time step in file */
+                 int time,             /**< time index in NetCDF file or NO_TIME */
+                 const Config *config  /**< LPJmL configuration */
+                )
+{
+  int i;
+#ifdef USE_MPI
+  MPI_Status status;
+  MPI_Datatype mpi_type;
+  Gatherplan *plan;
+  int task,layer;
+  char *vec,*dst;
+  size_t size;
+#endif
+  if(type==LPJ_FLOAT)
+    for(i=0;i<config->count*nlayer;i++)
+      ((float *)data)[i]=config->outnames[index].scale*((float *)data)[i]+config->outnames[index].offset;
+#ifdef USE_MPI
+  size=typesizes[type];
+  mpi_type=(type==LPJ_FLOAT) ? MPI_FLOAT : MPI_SHORT;
+  if(output->method==LPJ_MPI2)
+  {
+    for(layer=0;layer<nlayer;layer++)
+      MPI_File_write_at(output->files[index].fp.mpi_file,
+                        ((long)step*nlayer+layer)*config->total+config->offset,
+                        (char *)data+size*config->count*layer,config->count,
+                        mpi_type,&status);
+    return;
+  }
+  /* plan with counts and offsets scaled by number of layers */
+  plan=getgatherplan(output,nlayer,config);
+  vec=mpi_gather(plan,data,mpi_type);
+  if(isroot(*config))
+  {
+    /* reorder data from task to layer order */
+    dst=getoutputbuffer(&output->gather,size*config->total*nlayer);
+    for(task=0;task<config->ntask;task++)
+      for(layer=0;layer<nlayer;layer++)
+        memcpy(dst+size*(layer*config->total+output->plan->offsets[task]),
+               vec+size*(plan->offsets[task]+layer*output->plan->counts[task]),
+               size*output->plan->counts[task]);
+    writeblock(output,index,dst,type,nlayer,config->total,time);
+  }
+#else
+  writeblock(output,index,data,type,nlayer,config->count,time);
+#endif
+} /* of 'writelayers' */
@@ -0,0 +1,69 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**           w  r  i  t  e  o  u  t  p  u  t  _  s  o  c  k  e  t  .  c           \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions send output data using socket connection. For protocol           \n**/
+/**     version 1 the variable index is sent before the first layer, for           \n**/
+/**     version 2 a record is added to the frame of the current time step          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+void mpi_writeoutput_socket(Outputfile *output,    /**< output data */
+                            int index,             /**< variable index */
+                            int layer,             /**< layer of variable */
+                            Type type,             /**< datatype of data */
+                            void *data,            /**< data to be sent */
+                            MPI_Datatype mpi_type, /**< MPI datatype of data */
+                            Gatherplan *plan,      /**< gather plan */
+                            const Config *config   /**< LPJmL configuration */
+                           )
+{
+  void *vec;
+  if(config->socket_version==2)
+    mpi_add_sendbuffer(output->sendbuf,index,layer,type,data,mpi_type,plan->size,
+                       plan->counts,plan->offsets,config->rank,config->comm);
+  else
+  {
+    vec=mpi_gather(plan,data,mpi_type);
+    if(isroot(*config))
+    {
+      if(layer==0)
+        writeint_socket(output->socket,&index,1);
+      write_socket(output->socket,vec,typesizes[type]*plan->size);
+    }
+  }
+} /* of 'mpi_writeoutput_socket' */
+
+#else
+
+void writeoutput_socket(Outputfile *output, /**< output data */
+                        int index,          /**< variable index */
+                        int layer,          /**< layer of variable */
+                        Type type,          /**< datatype of data */
+                        const void *data,   /**< data to be sent */
+                        int n               /**< number of items */
+                       )
+{
+  if(output->sendbuf!=NULL)
+    add_sendbuffer(output->sendbuf,index,layer,type,data,n);
+  else
+  {
+    if(layer==0)
+      writeint_socket(output->socket,&index,1);
+    write_socket(output->socket,data,n*typesizes[type]);
+  }
+} /* of 'writeoutput_socket' */
+
+#endif
@@ -97,11 +97,170 @@
                                          if called by lpj */
 #endif
 
+#define ENSEMBLE_MEMBER "-DENSEMBLE_MEMBER=%d" /* macro defined for each member */
+
+static long long projectedmem(Input input,         /**< input data */
+                              int nmember,         /**< number of ensemble members */
+                              const Config config[] /**< LPJ configuration of members */
+                             )                     /** \return memory allocated later (bytes) */
+{
+  long long size;
+  int i;
+  /* output buffers are allocated at first write */
+  size=0;
+  for(i=0;i<nmember;i++)
+    size+=outputbuffersize(config+i);
+#ifdef STORECLIMATE
+  /* climate of the first years is stored in memory for spinup */
+  if(config->nspinup)
+    size+=storeclimatesize(input.climate,config->nspinyear);
+#endif
+  return size;
+} /* of 'projectedmem' */
+
+static int ensemble(int nmember,  /**< number of ensemble members */
+                    int argc,     /**< number of arguments */
+                    char **argv,  /**< argument vector */
+                    const char *progname, /**< program name */
+                    Fscanpftparfcn scanfcn[], /**< PFT-specific scan functions */
+                    const Standtype standtype[] /**< array of stand types */
+                   )              /** \return exit code */
+{
+  /*
+   * Ensemble run: configuration is read for each member with macro
+   * ENSEMBLE_MEMBER set to the index of the member, input data are
+   * read only once and shared by all members
+   */
+  Outputfile **output; /* Output file array of members */
+  Cell **grid;         /* cell array of members */
+  Config *config;      /* LPJ configuration of members */
+  Param *memberparam;  /* LPJ parameter of members */
+  Input input;         /* input data shared by all members */
+  char **member_argv,**argvptr;
+  String define;
+  int i,year,rc,member_argc;
+  time_t tstart,tend;
+  config=newvec(Config,nmember);
+  check(config);
+  grid=newvec(Cell *,nmember);
+  check(grid);
+  output=newvec(Outputfile *,nmember);
+  check(output);
+  memberparam=newvec(Param,nmember);
+  check(memberparam);
+  member_argv=newvec(char *,argc+1);
+  check(member_argv);
+  for(i=0;i<nmember;i++)
+  {
+    initconfig(config+i);
+    snprintf(define,STRING_LEN,ENSEMBLE_MEMBER,i);
+    member_argv[0]=argv[0];
+    member_argv[1]=define;
+    memcpy(member_argv+2,argv+1,sizeof(char *)*(argc-1));
+    member_argc=argc+1;
+    argvptr=member_argv;
+    rc=readconfig(config+i,
+                  (strcmp(progname,"lpj")) ? dflt_conf_filename_ml :
+                                             dflt_conf_filename,
+                  scanfcn,NTYPES,NOUT,&member_argc,&argvptr,lpj_usage);
+    failonerror(config+i,rc,READ_CONFIG_ERR,"Cannot read configuration");
+    memberparam[i]=param; /* LPJ parameter are stored in global variable */
+    rc=setensemblemember(config+i,i);
+    failonerror(config+i,rc,READ_CONFIG_ERR,"Cannot set ensemble member");
+  }
+  free(member_argv);
+  rc=checkensemble(config,nmember);
+  failonerror(config,rc,READ_CONFIG_ERR,"Invalid ensemble configuration");
+  if(isroot(config[0]))
+  {
+    printf("Ensemble run with %d members.\n",nmember);
+    printconfig(config,config[0].npft[GRASS]+config[0].npft[TREE],
+                config[0].npft[CROP]);
+  }
+  for(i=0;i<nmember;i++)
+  {
+    param=memberparam[i];
+    rc=((grid[i]=newgrid(config+i,standtype,NSTANDTYPES,config[i].npft[GRASS]+config[i].npft[TREE],config[i].npft[CROP]))==NULL);
+    failonerror(config+i,rc,INIT_GRID_ERR,"Initialization of LPJ grid failed");
+  }
+  /* input data are opened only once for the first member */
+  rc=initinput(&input,grid[0],config[0].npft[GRASS]+config[0].npft[TREE],config[0].npft[CROP],config);
+  failonerror(config,rc,INIT_INPUT_ERR,
+              "Initialization of input data failed");
+  if(config[0].check_climate)
+  {
+    rc=checkvalidclimate(input.climate,grid[0],config);
+    failonerror(config,rc,INIT_INPUT_ERR,"Check of climate data failed");
+  }
+  /* memory is reported before output files are opened, output buffers are projected */
+  printmemstat("initialization",projectedmem(input,nmember,config),config);
+  if(config[0].dryrun)
+  {
+    freeinput(input,isroot(config[0]));
+    for(i=0;i<nmember;i++)
+    {
+      freegrid(grid[i],config[i].npft[GRASS]+config[i].npft[TREE],config+i);
+      freeconfig(config+i);
+    }
+    if(isroot(*config))
+      puts("Dry run finished, simulation not started.");
+    free(memberparam);
+    free(output);
+    free(grid);
+    free(config);
+    return EXIT_SUCCESS;
+  }
+  for(i=0;i<nmember;i++)
+  {
+    output[i]=fopenoutput(grid[i],NOUT,config+i);
+    if(isopen(output[i],GRID))
+      writecoords(output[i],GRID,grid[i],config+i);
+    if(isopen(output[i],COUNTRY) && config[i].withlanduse)
+      writecountrycode(output[i],COUNTRY,grid[i],config+i);
+    if(isopen(output[i],REGION) && config[i].withlanduse)
+      writeregioncode(output[i],REGION,grid[i],config+i);
+    if(flush_output(output[i],config[i].outputyear,SOCKET_INIT))
+      fail(SOCKET_ERR,FALSE,"Cannot send initial output");
+  }
+  if(isroot(config[0]))
+    puts("Simulation begins...");
+  time(&tstart); /* Start timing */
+  year=iterate_ensemble(output,grid,input,memberparam,
+                        config[0].npft[GRASS]+config[0].npft[TREE],
+                        config[0].npft[CROP],config,nmember);
+  time(&tend); /* Stop timing */
+  for(i=0;i<nmember;i++)
+    fcloseoutput(output[i],config+i);
+  if(isroot(config[0]))
+    puts((year>config[0].lastyear) ? "Simulation ended." : "Simulation stopped.");
+  printmemstat("simulation",0,config);
+  freeinput(input,isroot(config[0]));
+  for(i=0;i<nmember;i++)
+    freegrid(grid[i],config[i].npft[GRASS]+config[i].npft[TREE],config+i);
+  if(isroot(config[0]))
+  {
+    printf( (year>config[0].lastyear) ? "%s successfully" : "%s errorneously",progname);
+    printf(" terminated, %d ensemble members with %d grid cells processed.\n"
+           "Wall clock time:\t%d sec, %.2g sec/cell/year.\n",
+           nmember,config[0].total,(int)(tend-tstart),
+           (double)(tend-tstart)/config[0].total/nmember/(year-config[0].firstyear+
+                                                          config[0].nspinup));
+  }
+  rc=(year>config[0].lastyear) ? EXIT_SUCCESS : EXIT_FAILURE;
+  for(i=0;i<nmember;i++)
+    freeconfig(config+i);
+  free(memberparam);
+  free(output);
+  free(grid);
+  free(config);
+  return rc;
+} /* of 'ensemble' */
+
 int main(int argc,char **argv)
 {
   Outputfile *output; /* Output file array */
   const char *progname;
-  int year,rc;
+  int year,rc,nmember;
   Cell *grid;         /* cell array */
   Input input;        /* input data */
   time_t tstart,tend,tbegin,tfinal;   /* variables for timing */
@@ -126,6 +285,7 @@ int main(int argc,char **argv)
  
   /* sequential version of LPJ */
   initconfig(&config);
+  nmember=1;
  
   progname=strippath(argv[0]); /* strip path from program name */
   if(argc>1)
@@ -154,6 +314,22 @@ int main(int argc,char **argv)
  
       return EXIT_SUCCESS;
     }
+    else if(!strcmp(argv[1],"-ensemble")) /* check for ensemble option */
+    {
+      if(argc<3 || (nmember=atoi(argv[2]))<1)
+      {
+        if(isroot(config))
+        {
+          fputs("ERROR164: Invalid or missing number of members for '-ensemble' option.\n",stderr);
+          fprintf(stderr,lpj_usage,progname);
+        }
+        return EXIT_FAILURE;
+      }
+      /* remove option from argument list */
+      argv[2]=argv[0];
+      argv+=2;
+      argc-=2;
+    }
   }
   if(isroot(config))
   { /* Output only for the root task 0 */
@@ -162,6 +338,24 @@ int main(int argc,char **argv)
            ctime(&tbegin));
     fflush(stdout);
   }
+  if(nmember>1)
+  {
+    rc=ensemble(nmember,argc,argv,progname,scanfcn,standtype);
+#ifdef USE_MPI
+    /* Wait until all tasks have finished to measure total wall clock time */
+    MPI_Barrier(MPI_COMM_WORLD);
+    /* Exit MPI */
+    MPI_Finalize();
+#endif
+    time(&tfinal);
+    if(isroot(config))
+    {
+      printf("Total wall clock time:\t%d sec (",(int)(tfinal-tbegin));
+      printtime(tfinal-tbegin);
+      puts(").");
+    }
+    return rc;
+  }
 
   /* NTYPES is set to natural vegetation must be considered
    * in light and establishment
@@ -202,6 +396,24 @@ int main(int argc,char **argv)
     rc=checkvalidclimate(input.climate,grid,&config);
     failonerror(&config,rc,INIT_INPUT_ERR,"Check of climate data failed");
   }
+  /* memory is reported before output files are opened, output buffers are projected */
+  printmemstat("initialization",projectedmem(input,1,&config),&config);
+  if(config.dryrun)
+  {
+    freeinput(input,isroot(config));
+    freegrid(grid,config.npft[GRASS]+config.npft[TREE],&config);
+    if(isroot(config))
+      puts("Dry run finished, simulation not started.");
+#ifdef IMAGE
+    if(config.sim_id==LPJML_IMAGE)
+      close_image(&config);
+#endif
+    freeconfig(&config);
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
+    return EXIT_SUCCESS;
+  }
   /* open output files */  
   output=fopenoutput(grid,NOUT,&config);
 
@@ -211,6 +423,8 @@ int main(int argc,char **argv)
     writecountrycode(output,COUNTRY,grid,&config);
   if(isopen(output,REGION) && config.withlanduse)
     writeregioncode(output,REGION,grid,&config);
+  if(flush_output(output,config.outputyear,SOCKET_INIT))
+    fail(SOCKET_ERR,FALSE,"Cannot send initial output");
   if(isroot(config))
     puts("Simulation begins...");
   time(&tstart); /* Start timing */
@@ -223,6 +437,7 @@ int main(int argc,char **argv)
   fcloseoutput(output,&config);
   if(isroot(config))
     puts((year>config.lastyear) ? "Simulation ended." : "Simulation stopped.");
+  printmemstat("simulation",0,&config);
   /* free memory */
   freeinput(input,isroot(config));
   freegrid(grid,config.npft[GRASS]+config.npft[TREE],&config);
@@ -82,7 +82,7 @@ Coord_array *createcoord(Outputfile *output,
       vec[count++]=grid[cell].coord.lon;
   MPI_Gatherv(vec,config->count,
               (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
-              lon,output->counts,output->offsets,
+              lon,output->plan->counts,output->plan->offsets,
               (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
               0,config->comm);
   count=0;
@@ -91,7 +91,7 @@ Coord_array *createcoord(Outputfile *output,
       vec[count++]=grid[cell].coord.lat;
   MPI_Gatherv(vec,config->count,
               (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
-              lat,output->counts,output->offsets,
+              lat,output->plan->counts,output->plan->offsets,
               (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
               0,config->comm);
   free(vec);
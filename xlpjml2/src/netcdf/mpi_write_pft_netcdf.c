@@ -22,43 +22,21 @@
 Bool mpi_write_pft_netcdf(const Netcdf *cdf, /* pointer to NetCDF */
                           void *data,        /* data to be written to disk */
                           MPI_Datatype type,
-                          int size,
                           int year,
                           int pft,
-                          int counts[],
-                          int offsets[],
-                          int rank,          /* MPI rank */
-                          MPI_Comm comm      /* MPI communicator */
+                          Gatherplan *plan   /* gather plan */
                          )                   /* returns TRUE on error */
 {
-  Bool rc;
-  MPI_Aint extent;
-  void *vec=NULL;
-  MPI_Type_extent(type,&extent);
-  if(rank==0)
-  {
-    vec=malloc(size*extent); /* allocate receive buffer */
-    if(vec==NULL)
-    {
-      printallocerr("vec");
-      rc=TRUE;
-    }
-    else
-      rc=FALSE;
-  }
-  MPI_Bcast(&rc,1,MPI_INT,0,comm);
-  if(rc)
-    return TRUE;
-  MPI_Gatherv(data,counts[rank],type,vec,counts,offsets,type,0,comm);
-  if(rank==0)
+  Bool rc=FALSE;
+  void *vec;
+  vec=mpi_gather(plan,data,type);
+  if(plan->rank==0)
   {
     if(type==MPI_FLOAT)
-      rc=write_pft_float_netcdf(cdf,vec,year,pft,size); /* write data to file */
+      rc=write_pft_float_netcdf(cdf,vec,year,pft,plan->size); /* write data to file */
     else if(type==MPI_SHORT)
-      rc=write_pft_short_netcdf(cdf,vec,year,pft,size); /* write data to file */
-    free(vec);
+      rc=write_pft_short_netcdf(cdf,vec,year,pft,plan->size); /* write data to file */
   }
-  MPI_Barrier(comm);
   return rc;
 } /* of 'mpi_write_pft_netcdf' */
 #endif
@@ -0,0 +1,64 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              w r i t e _ f l o a t _ b l o c k _ n e t c d f . c               \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes consecutive time steps of float output into NetCDF         \n**/
+/**     file with one call of nc_put_vara_float()                                  \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+#include <netcdf.h>
+#endif
+
+Bool write_float_block_netcdf(const Netcdf *cdf, /**< pointer to NetCDF file */
+                              const float vec[], /**< data for each time step and cell */
+                              int time,          /**< index of first time step */
+                              int nstep,         /**< number of time steps */
+                              int size           /**< number of cells */
+                             )                   /** \return TRUE on error */
+{
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+  int i,step,rc,ncell;
+  size_t offsets[3],counts[3];
+  float *grid;
+  ncell=cdf->index->nlon*cdf->index->nlat;
+  grid=newvec(float,ncell*nstep);
+  if(grid==NULL)
+  {
+    printallocerr("grid");
+    return TRUE;
+  }
+  for(i=0;i<ncell*nstep;i++)
+    grid[i]=cdf->missing_value;
+  for(step=0;step<nstep;step++)
+    for(i=0;i<size;i++)
+      grid[step*ncell+cdf->index->index[i]]=vec[step*size+i];
+  counts[0]=nstep;
+  counts[1]=cdf->index->nlat;
+  counts[2]=cdf->index->nlon;
+  offsets[0]=time;
+  offsets[1]=offsets[2]=0;
+  rc=nc_put_vara_float(cdf->ncid,cdf->varid,offsets,counts,grid);
+  free(grid);
+  if(rc!=NC_NOERR)
+  {
+    fprintf(stderr,"ERROR431: Cannot write output data: %s.\n",
+            nc_strerror(rc));
+    return TRUE;
+  }
+  return FALSE;
+#else
+  return TRUE;
+#endif
+} /* of 'write_float_block_netcdf' */
@@ -0,0 +1,84 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                w r i t e _ p f t _ b l o c k _ n e t c d f . c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes all PFT or layer values of one time step into              \n**/
+/**     NetCDF file with one call                                                  \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+#include <netcdf.h>
+#endif
+
+Bool write_pft_block_netcdf(const Netcdf *cdf, /**< pointer to NetCDF file */
+                            const void *vec,   /**< data for each PFT and cell */
+                            Type type,         /**< datatype (LPJ_FLOAT, LPJ_SHORT) */
+                            int year,          /**< time index or NO_TIME */
+                            int npft,          /**< number of PFTs */
+                            int size           /**< number of cells */
+                           )                   /** \return TRUE on error */
+{
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+  int i,p,rc,ncell;
+  size_t offsets[4],counts[4];
+  void *grid;
+  ncell=cdf->index->nlon*cdf->index->nlat;
+  grid=malloc(typesizes[type]*ncell*npft);
+  if(grid==NULL)
+  {
+    printallocerr("grid");
+    return TRUE;
+  }
+  if(type==LPJ_FLOAT)
+  {
+    for(i=0;i<ncell*npft;i++)
+      ((float *)grid)[i]=cdf->missing_value;
+    for(p=0;p<npft;p++)
+      for(i=0;i<size;i++)
+        ((float *)grid)[p*ncell+cdf->index->index[i]]=((const float *)vec)[p*size+i];
+  }
+  else
+  {
+    for(i=0;i<ncell*npft;i++)
+      ((short *)grid)[i]=MISSING_VALUE_SHORT;
+    for(p=0;p<npft;p++)
+      for(i=0;i<size;i++)
+        ((short *)grid)[p*ncell+cdf->index->index[i]]=((const short *)vec)[p*size+i];
+  }
+  if(year==NO_TIME)
+    rc=(type==LPJ_FLOAT) ? nc_put_var_float(cdf->ncid,cdf->varid,grid) :
+                           nc_put_var_short(cdf->ncid,cdf->varid,grid);
+  else
+  {
+    counts[0]=1;
+    counts[1]=npft;
+    counts[2]=cdf->index->nlat;
+    counts[3]=cdf->index->nlon;
+    offsets[0]=year;
+    offsets[1]=offsets[2]=offsets[3]=0;
+    rc=(type==LPJ_FLOAT) ? nc_put_vara_float(cdf->ncid,cdf->varid,offsets,counts,grid) :
+                           nc_put_vara_short(cdf->ncid,cdf->varid,offsets,counts,grid);
+  }
+  free(grid);
+  if(rc!=NC_NOERR)
+  {
+    fprintf(stderr,"ERROR431: Cannot write output data: %s.\n",
+            nc_strerror(rc));
+    return TRUE;
+  }
+  return FALSE;
+#else
+  return TRUE;
+#endif
+} /* of 'write_pft_block_netcdf' */
@@ -47,3 +47,19 @@ Real interpolate(const MReal mval, /**< monthly values to interpolate        */
 
   return mval[month]+dm*(mval[nextmonth]-mval[month])*diffday[month];
 } /* of 'interpolate' */
+
+#ifdef USE_MIXED_PRECISION
+
+Real interpolatestore(const Storereal mval[], /**< monthly values to interpolate */
+                      int month,  /**< month (0..11)                        */
+                      int dm      /**< day of month (0..ndaymonth[month]-1) */
+                     )            /** \return interpolated value            */
+{
+  MReal val;
+  int i;
+  for(i=0;i<NMONTH;i++)
+    val[i]=mval[i];
+  return interpolate(val,month,dm);
+} /* of 'interpolatestore' */
+
+#endif
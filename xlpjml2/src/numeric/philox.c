@@ -0,0 +1,85 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                             p  h  i  l  o  x  .  c                             \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Counter-based random number generator Philox4x32-10 (Salmon et             \n**/
+/**     al. 2011). Random numbers are a function of counter and key only,          \n**/
+/**     no state is kept, so results do not depend on the order of calls           \n**/
+/**     or on the distribution of cells to tasks                                   \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include "types.h"
+#include "numeric.h"
+
+#define M0 0xD2511F53U
+#define M1 0xCD9E8D57U
+#define W0 0x9E3779B9U
+#define W1 0xBB67AE85U
+#define NROUND 10
+
+void philox4x32(unsigned int out[4],       /**< 4 random 32-bit integers */
+                const unsigned int ctr[4], /**< counter */
+                const unsigned int key[2]  /**< key */
+               )
+{
+  unsigned long long p0,p1;
+  unsigned int k0,k1,c[4];
+  int i;
+  c[0]=ctr[0];
+  c[1]=ctr[1];
+  c[2]=ctr[2];
+  c[3]=ctr[3];
+  k0=key[0];
+  k1=key[1];
+  for(i=0;i<NROUND;i++)
+  {
+    p0=(unsigned long long)M0*c[0];
+    p1=(unsigned long long)M1*c[2];
+    c[0]=(unsigned int)(p1>>32)^c[1]^k0;
+    c[1]=(unsigned int)p1;
+    c[2]=(unsigned int)(p0>>32)^c[3]^k1;
+    c[3]=(unsigned int)p0;
+    /* bump key */
+    k0+=W0;
+    k1+=W1;
+  }
+  out[0]=c[0];
+  out[1]=c[1];
+  out[2]=c[2];
+  out[3]=c[3];
+} /* of 'philox4x32' */
+
+void initrandstream(Randstream *stream, /**< random stream */
+                    int seed,           /**< seed of random number generator */
+                    int index,          /**< index of random stream */
+                    int cell,           /**< global index of cell */
+                    int step            /**< time step (year*NMONTH+month) */
+                   )
+{
+  stream->key[0]=(unsigned int)seed;
+  stream->key[1]=(unsigned int)index;
+  stream->ctr[0]=(unsigned int)cell;
+  stream->ctr[1]=(unsigned int)step;
+  stream->ctr[2]=stream->ctr[3]=0;
+} /* of 'initrandstream' */
+
+void randstream(Real rnd[4],             /**< random numbers in (0,1) */
+                const Randstream *stream /**< random stream */
+               )
+{
+  unsigned int out[4];
+  int i;
+  philox4x32(out,stream->ctr,stream->key);
+  for(i=0;i<4;i++)
+    rnd[i]=(out[i]+0.5)*(1.0/4294967296.0);
+} /* of 'randstream' */
@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_PNET
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -20,6 +20,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_PNET
+
 #include <stdlib.h>
 #include <stdio.h>
 #ifdef USE_MPI
@@ -23,6 +23,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_PNET
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
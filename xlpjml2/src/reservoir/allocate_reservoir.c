@@ -10,6 +10,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_RESERVOIR
+
 #include "lpj.h"
 
 void allocate_reservoir(Cell grid[],         /**< LPJ grid */
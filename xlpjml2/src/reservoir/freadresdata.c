@@ -12,6 +12,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_RESERVOIR
+
 #include "lpj.h"
 
 Bool freadresdata(FILE *file,  /**< pointer to restart file */
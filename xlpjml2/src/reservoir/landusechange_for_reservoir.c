@@ -28,7 +28,7 @@ static void deforest_for_reservoir(Cell *cell,    /**< pointer to cell */
   int s,pos;
   Stand *natstand,*cutstand;
 
-  s=findlandusetype(cell->standlist,NATURAL);
+  s=findlandusetype(cell,NATURAL);
   if(s!=NOT_FOUND)
   {
     pos=addstand(&natural_stand,cell)-1;
@@ -77,8 +77,8 @@ static Real from_setaside_for_reservoir(Cell *cell,             /**< pointer to
   Irrigation *data;
 
   /* first check if there is any SETASIDE in the cell */
-  s=findlandusetype(cell->standlist,SETASIDE_RF);
-  s2=findlandusetype(cell->standlist,SETASIDE_IR);
+  s=findlandusetype(cell,SETASIDE_RF);
+  s2=findlandusetype(cell,SETASIDE_IR);
   /* if there IS already setaside in the the cell: */
   if(s!=NOT_FOUND)
   {
@@ -167,7 +167,7 @@ static Real from_setaside_for_reservoir(Cell *cell,             /**< pointer to
   /* if previous step correct, there is now enough setaside
    * created to put the be replaced by the reservoir
    */
-  s=findlandusetype(cell->standlist,SETASIDE_RF);
+  s=findlandusetype(cell,SETASIDE_RF);
   setasidestand=getstand(cell->standlist,s);
 
   if(difffrac<=setasidestand->frac+epsilon)
@@ -259,16 +259,16 @@ void landusechange_for_reservoir(Cell *cell,            /**< pointer to cell */
     /* first choice: deforest natural land */
     if(difffrac>epsilon && (1-cell->lakefrac-cell->ml.cropfrac_rf-cell->ml.cropfrac_ir-minnatfrac_res)>=difffrac)
     {  /* deforestation to built the reservoir */
-       s=findlandusetype(cell->standlist,NATURAL);
+       s=findlandusetype(cell,NATURAL);
        if(s!=NOT_FOUND) deforest_for_reservoir(cell,difffrac,istimber,npft+ncft);
     }
     /* if this is not possible: deforest all the natural land and then reduce crops  */
     if(difffrac>epsilon && 1-cell->lakefrac-cell->ml.cropfrac_rf-cell->ml.cropfrac_ir-minnatfrac_res<difffrac)
     {
-      s=findlandusetype(cell->standlist,NATURAL);
+      s=findlandusetype(cell,NATURAL);
       if(s!=NOT_FOUND) /* check if there is still natural land in the gridcell */
         deforest(cell,difffrac,pftpar,intercrop,npft,FALSE,istimber,FALSE,ncft,year,minnatfrac_res); /* 1 deforest */
-      s=findlandusetype(cell->standlist,NATURAL); /* 2 check if everyting is deforested */
+      s=findlandusetype(cell,NATURAL); /* 2 check if everyting is deforested */
       if(s!=NOT_FOUND)
       {
         stand=getstand(cell->standlist,s);
@@ -284,7 +284,7 @@ void landusechange_for_reservoir(Cell *cell,            /**< pointer to cell */
                "wrong loop, there is still natural land to deforest left"); */
       
           deforest(cell,difffrac,pftpar,intercrop,npft,FALSE,istimber,FALSE,ncft,year,minnatfrac_res); /* 1 deforest */
-          s=findlandusetype(cell->standlist,NATURAL); /* 2 check if everyting is deforested */
+          s=findlandusetype(cell,NATURAL); /* 2 check if everyting is deforested */
           if(s!=NOT_FOUND)
           {
             printf("defor res 2 wrong loop %d %g %g %g %g %g %g\n in cell lon %.2f lat %.2f\n",
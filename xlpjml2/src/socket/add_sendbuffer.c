@@ -0,0 +1,35 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 a  d  d  _  s  e  n  d  b  u  f  f  e  r  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function adds record with data to frame under construction                 \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "channel.h"
+
+void add_sendbuffer(Sendbuffer *buffer, /**< send buffer */
+                    int index,          /**< variable index */
+                    int layer,          /**< layer of variable */
+                    Type type,          /**< datatype of data */
+                    const void *data,   /**< data to be sent */
+                    int n               /**< number of items */
+                   )
+{
+  void *vec;
+  vec=reserve_sendbuffer(buffer,index,layer,type,n);
+  if(vec!=NULL)
+    memcpy(vec,data,n*typesizes[type]);
+} /* of 'add_sendbuffer' */
@@ -0,0 +1,52 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              c  l  o  s  e  _  s  e  n  d  b  u  f  f  e  r  .  c              \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function sends last frame, waits until all frames have been sent           \n**/
+/**     and deletes send buffer. Socket is not closed                              \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "channel.h"
+
+Bool close_sendbuffer(Sendbuffer *buffer /**< send buffer */
+                     )                   /** \return TRUE on error */
+{
+  Frameheader header;
+  Bool rc;
+  if(buffer==NULL)
+    return FALSE;
+#ifndef _WIN32
+  pthread_mutex_lock(&buffer->mutex);
+  buffer->done=TRUE;
+  pthread_cond_signal(&buffer->notempty);
+  pthread_mutex_unlock(&buffer->mutex);
+  pthread_join(buffer->thread,NULL);
+  pthread_mutex_destroy(&buffer->mutex);
+  pthread_cond_destroy(&buffer->notempty);
+  pthread_cond_destroy(&buffer->notfull);
+#endif
+  /* all frames are sent, last frame tells receiver to close connection */
+  header.magic=FRAME_MAGIC;
+  header.year=header.step=0;
+  header.nrec=header.size=header.len=0;
+  header.flags=FRAME_END;
+  if(!buffer->err && write_socket(buffer->socket,&header,sizeof(header)))
+    buffer->err=TRUE;
+  rc=buffer->err;
+  free(buffer->payload);
+  free(buffer->queue);
+  free(buffer);
+  return rc;
+} /* of 'close_sendbuffer' */
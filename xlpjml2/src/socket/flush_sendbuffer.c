@@ -0,0 +1,116 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              f  l  u  s  h  _  s  e  n  d  b  u  f  f  e  r  .  c              \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function finishes frame under construction and puts it into the            \n**/
+/**     send queue. Payload is optionally compressed by a run-length               \n**/
+/**     encoding of 4-byte words: a positive count n is followed by n              \n**/
+/**     literal words, a negative count -n by one word repeated n times            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "channel.h"
+
+#define MINRUN 3 /* minimum length of run to be encoded */
+
+static int rle(int *dst,const int *src,int n)
+{
+  int i,j,len,start;
+  len=0;
+  start=0; /* start of literal words */
+  i=0;
+  while(i<n)
+  {
+    for(j=i+1;j<n && src[j]==src[i];j++);
+    if(j-i>=MINRUN)
+    {
+      if(len+i-start+3>=n) /* no gain by compression */
+        return n;
+      if(i>start)
+      {
+        dst[len++]=i-start;
+        memcpy(dst+len,src+start,sizeof(int)*(i-start));
+        len+=i-start;
+      }
+      dst[len++]=-(j-i);
+      dst[len++]=src[i];
+      start=j;
+    }
+    i=j;
+  }
+  if(n>start)
+  {
+    if(len+n-start+1>=n)
+      return n;
+    dst[len++]=n-start;
+    memcpy(dst+len,src+start,sizeof(int)*(n-start));
+    len+=n-start;
+  }
+  return len;
+} /* of 'rle' */
+
+Bool flush_sendbuffer(Sendbuffer *buffer, /**< send buffer */
+                      int year,           /**< year of frame */
+                      int step            /**< time step of frame */
+                     )                    /** \return TRUE on error */
+{
+  Frame frame;
+  Frameheader *header;
+#ifndef _WIN32
+  Bool err;
+#endif
+  frame.data=malloc(sizeof(Frameheader)+buffer->size);
+  if(frame.data==NULL)
+  {
+    fputs("ERROR304: Cannot allocate memory for send buffer.\n",stderr);
+    return TRUE;
+  }
+  header=(Frameheader *)frame.data;
+  header->magic=FRAME_MAGIC;
+  header->year=year;
+  header->step=step;
+  header->nrec=buffer->nrec;
+  header->flags=0;
+  header->size=buffer->size;
+  header->len=buffer->size;
+  if(buffer->compress && buffer->size>0)
+  {
+    header->len=rle((int *)(header+1),(int *)buffer->payload,buffer->size/sizeof(int))*sizeof(int);
+    if(header->len<buffer->size)
+      header->flags|=FRAME_RLE;
+    else
+      header->len=buffer->size;
+  }
+  if(!(header->flags & FRAME_RLE))
+    memcpy(header+1,buffer->payload,buffer->size);
+  frame.len=sizeof(Frameheader)+header->len;
+  buffer->size=buffer->nrec=0;
+#ifdef _WIN32
+  if(!buffer->err && write_socket(buffer->socket,frame.data,frame.len))
+    buffer->err=TRUE;
+  free(frame.data);
+  return buffer->err;
+#else
+  pthread_mutex_lock(&buffer->mutex);
+  while(buffer->n==buffer->nframe)
+    pthread_cond_wait(&buffer->notfull,&buffer->mutex);
+  buffer->queue[(buffer->first+buffer->n) % buffer->nframe]=frame;
+  buffer->n++;
+  pthread_cond_signal(&buffer->notempty);
+  err=buffer->err;
+  pthread_mutex_unlock(&buffer->mutex);
+  return err;
+#endif
+} /* of 'flush_sendbuffer' */
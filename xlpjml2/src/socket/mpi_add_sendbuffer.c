@@ -0,0 +1,54 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**           m  p  i  _  a  d  d  _  s  e  n  d  b  u  f  f  e  r  .  c           \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function gathers data from all tasks into record of frame under            \n**/
+/**     construction on task 0                                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "channel.h"
+
+#ifdef USE_MPI
+
+void mpi_add_sendbuffer(Sendbuffer *buffer,    /**< send buffer, only used on task 0 */
+                        int index,             /**< variable index */
+                        int layer,             /**< layer of variable */
+                        Type type,             /**< datatype of data */
+                        void *data,            /**< data to be written */
+                        MPI_Datatype mpi_type, /**< MPI datatype of data */
+                        int size,              /**< total number of items */
+                        int counts[],
+                        int offsets[],
+                        int rank,              /**< MPI rank */
+                        MPI_Comm comm          /**< MPI communicator */
+                       )
+{
+  void *vec,*tmp=NULL;
+  vec=(rank==0) ? reserve_sendbuffer(buffer,index,layer,type,size) : NULL;
+  if(rank==0 && vec==NULL)
+  {
+    /* record was dropped, but task 0 still has to take part in the gather */
+    vec=tmp=malloc(size*typesizes[type]);
+    if(tmp==NULL)
+    {
+      fputs("ERROR304: Cannot allocate memory for send buffer.\n",stderr);
+      MPI_Abort(comm,EXIT_FAILURE);
+    }
+  }
+  MPI_Gatherv(data,counts[rank],mpi_type,vec,counts,offsets,mpi_type,0,comm);
+  free(tmp);
+} /* of 'mpi_add_sendbuffer' */
+
+#endif
@@ -50,7 +50,6 @@ Bool mpi_write_socket(Socket *socket,    /* socket */
   }
   else
     rc=FALSE;
-  MPI_Barrier(comm);
   return rc;
 } /* of 'mpi_write_socket' */
 
@@ -0,0 +1,102 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               o  p  e  n  _  s  e  n  d  b  u  f  f  e  r  .  c                \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function creates send buffer for framed socket protocol version 2.         \n**/
+/**     Frames are sent by a background thread. The number of frames               \n**/
+/**     waiting to be sent is bounded, so the model blocks only if the             \n**/
+/**     receiver cannot keep up. On Windows frames are sent synchronously.         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "channel.h"
+
+#ifndef _WIN32
+
+static void *sendframes(void *arg)
+{
+  Sendbuffer *buffer;
+  Frame frame;
+  Bool err;
+  buffer=arg;
+  for(;;)
+  {
+    pthread_mutex_lock(&buffer->mutex);
+    while(buffer->n==0 && !buffer->done)
+      pthread_cond_wait(&buffer->notempty,&buffer->mutex);
+    if(buffer->n==0)
+    {
+      /* queue is empty and no more frames will be added */
+      pthread_mutex_unlock(&buffer->mutex);
+      break;
+    }
+    frame=buffer->queue[buffer->first];
+    buffer->first=(buffer->first+1) % buffer->nframe;
+    buffer->n--;
+    pthread_cond_signal(&buffer->notfull);
+    err=buffer->err;
+    pthread_mutex_unlock(&buffer->mutex);
+    /* frames are discarded after first error */
+    if(!err && write_socket(buffer->socket,frame.data,frame.len))
+    {
+      pthread_mutex_lock(&buffer->mutex);
+      buffer->err=TRUE;
+      pthread_mutex_unlock(&buffer->mutex);
+    }
+    free(frame.data);
+  }
+  return NULL;
+} /* of 'sendframes' */
+
+#endif
+
+Sendbuffer *open_sendbuffer(Socket *socket, /**< socket connection */
+                            int nframe,     /**< maximum number of frames in queue */
+                            Bool compress   /**< compress payload (TRUE/FALSE) */
+                           )                /** \return send buffer or NULL */
+{
+  Sendbuffer *buffer;
+  buffer=malloc(sizeof(Sendbuffer));
+  if(buffer==NULL)
+    return NULL;
+  buffer->socket=socket;
+  buffer->compress=compress;
+  buffer->err=FALSE;
+  buffer->payload=NULL;
+  buffer->size=buffer->capacity=buffer->nrec=0;
+  buffer->nframe=nframe;
+  buffer->first=buffer->n=0;
+  buffer->queue=malloc(sizeof(Frame)*nframe);
+  if(buffer->queue==NULL)
+  {
+    free(buffer);
+    return NULL;
+  }
+#ifndef _WIN32
+  buffer->done=FALSE;
+  pthread_mutex_init(&buffer->mutex,NULL);
+  pthread_cond_init(&buffer->notempty,NULL);
+  pthread_cond_init(&buffer->notfull,NULL);
+  if(pthread_create(&buffer->thread,NULL,sendframes,buffer))
+  {
+    pthread_mutex_destroy(&buffer->mutex);
+    pthread_cond_destroy(&buffer->notempty);
+    pthread_cond_destroy(&buffer->notfull);
+    free(buffer->queue);
+    free(buffer);
+    return NULL;
+  }
+#endif
+  return buffer;
+} /* of 'open_sendbuffer' */
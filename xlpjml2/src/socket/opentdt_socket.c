@@ -114,6 +114,7 @@ Socket *opentdt_socket(int port, /* port of TCP/IP connection */
     fputs("ERROR304: Cannot allocate memory for socket.\n",stderr);
     return NULL;
   }
+  len=sizeof(fsin);
   sock->channel=accept(my_socket,&fsin,&len);
   if(isinvalid_socket(sock->channel))
   {
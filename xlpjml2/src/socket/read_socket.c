@@ -25,12 +25,12 @@ Bool read_socket(Socket *socket,void *data,int n)
 {
   int i,j;
   i=n;
-  do
+  while(i>0)
   {
     j=recv(socket->channel,(char *)data+n-i,i,0);
-    if(j<0)
+    if(j<=0) /* error or connection closed */
       return TRUE;
     i-=j;
-  }while(i);
+  }
   return FALSE;
 } /* of 'read_socket' */
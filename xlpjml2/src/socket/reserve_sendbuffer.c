@@ -0,0 +1,67 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**           r  e  s  e  r  v  e  _  s  e  n  d  b  u  f  f  e  r  .  c           \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function adds record to frame under construction and returns               \n**/
+/**     pointer to its data area                                                   \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "channel.h"
+
+#define roundup4(n) (((n)+3)/4*4)
+
+void *reserve_sendbuffer(Sendbuffer *buffer, /**< send buffer */
+                         int index,          /**< variable index */
+                         int layer,          /**< layer of variable */
+                         Type type,          /**< datatype of data */
+                         int n               /**< number of items */
+                        )                    /** \return pointer to data area of record or NULL */
+{
+  Recordheader *header;
+  int len;
+  char *payload;
+  len=sizeof(Recordheader)+roundup4(n*typesizes[type]);
+  if(buffer->size+len>buffer->capacity)
+  {
+    /* payload size grows only during the first frames */
+    payload=realloc(buffer->payload,buffer->size+len);
+    if(payload==NULL)
+    {
+      fputs("ERROR304: Cannot allocate memory for send buffer.\n",stderr);
+      /* record is dropped, error is returned by next flush_sendbuffer() */
+#ifndef _WIN32
+      pthread_mutex_lock(&buffer->mutex);
+#endif
+      buffer->err=TRUE;
+#ifndef _WIN32
+      pthread_mutex_unlock(&buffer->mutex);
+#endif
+      return NULL;
+    }
+    buffer->payload=payload;
+    buffer->capacity=buffer->size+len;
+  }
+  header=(Recordheader *)(buffer->payload+buffer->size);
+  header->index=index;
+  header->layer=layer;
+  header->type=type;
+  header->n=n;
+  /* clear padding bytes */
+  if(len>(int)sizeof(Recordheader))
+    *(int *)(buffer->payload+buffer->size+len-sizeof(int))=0;
+  buffer->size+=len;
+  buffer->nrec++;
+  return header+1;
+} /* of 'reserve_sendbuffer' */
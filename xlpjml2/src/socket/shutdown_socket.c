@@ -0,0 +1,31 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**           s  h  u  t  d  o  w  n  _  s  o  c  k  e  t  .  c                    \n**/
+/**                                                                                \n**/
+/**     Function shuts down send and receive of socket. Threads blocked            \n**/
+/**     in reading from socket return with an error.                               \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/socket.h>
+#endif
+#include "types.h"
+#include "channel.h"
+
+void shutdown_socket(Socket *socket)
+{
+#ifdef _WIN32
+  shutdown(socket->channel,SD_BOTH);
+#else
+  shutdown(socket->channel,SHUT_RDWR);
+#endif
+} /* of 'shutdown_socket' */
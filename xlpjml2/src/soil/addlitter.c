@@ -13,6 +13,8 @@
 /**                                                                                \n**/
 /**************************************************************************************/
 
+#define MEMTAG MEM_STAND
+
 #include "lpj.h"
 
 int addlitter(Litter *litter,    /**< pointer to litter */
@@ -161,6 +161,10 @@ unsigned int fscansoilpar(LPJfile *file,     /**< pointer to LPJ file */
     soil->wsats[BOTTOMLAYER]=0.006*soildepth[BOTTOMLAYER];
     soil->bulkdens[BOTTOMLAYER]=(1-soil->wsats[BOTTOMLAYER]/soildepth[BOTTOMLAYER])*MINERALDENS;
     soil->k_dry[BOTTOMLAYER]=0.039*pow(soil->wsats[BOTTOMLAYER]/soildepth[BOTTOMLAYER],-2.2);
+    /* saturated conductivity of unfrozen soil depends only on porosity */
+    foreachsoillayer(l)
+      soil->k_sat[l]=pow(K_SOLID,(1-soil->wsats[l]/soildepth[l]))*
+                     pow(K_WATER,soil->wsats[l]/soildepth[l]);
     fscanint2(verb,&item,&soil->hsg,soil->name,"hsg");
     if(soil->hsg<1 || soil->hsg>NHSG)
     {
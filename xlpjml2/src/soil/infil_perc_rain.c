@@ -6,6 +6,12 @@
 /**                                                                                \n**/
 /**     Function calculates water balance                                          \n**/
 /**                                                                                \n**/
+/**     Rain is infiltrated in slugs of 4 mm. The adaptive solver starts           \n**/
+/**     with MAXSLUG slugs for heavy rainfall and halves the slug size until       \n**/
+/**     runoff and seepage of two successive slug sizes differ by less than        \n**/
+/**     INFIL_TOL (step doubling). In verify mode both solvers are run and         \n**/
+/**     the difference in runoff is accumulated for each cell.                     \n**/
+/**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
 /** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
@@ -17,37 +23,40 @@
 #include "lpj.h"
 #include "agriculture.h"
 
-Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
-                     Real infil,         /**< rainfall + melting water - interception_stand (mm) + rw_irrig */
-                     Real *return_flow_b, /**< blue water return flow (mm) */
-                     Bool rw_manage       /**< do rain water management? (TRUE/FALSE) */
-                    )                    /** \return water runoff (mm) */
+#define SLUG 4.0   /* size of water slug infiltrated at once (mm) */
+#define MAXSLUG 10 /* number of slugs of first step of adaptive solver */
+#define INFIL_TOL 0.01 /* tolerance in runoff and seepage of adaptive solver (mm) */
+
+typedef struct
+{
+  Soil soil;
+  Real frac_g[NSOILLAYER];
+  Real return_flow_b,runoff,outflux,runoff_surface;
+} Infil;
+
+static void infil_perc(Stand *stand,        /**< Stand pointer */
+                       Soil *soil,          /**< soil of stand */
+                       Real frac_g[],       /**< fraction of green water in soil layers */
+                       Real infil,          /**< infiltrating water (mm) */
+                       Real slugsize,       /**< size of slugs (mm) */
+                       Real soil_infil,     /**< infiltration parameter */
+                       Real *return_flow_b, /**< blue water return flow (mm) */
+                       Real *runoff,        /**< lateral runoff (mm) */
+                       Real *outflux,       /**< seepage (mm) */
+                       Real *runoff_surface /**< surface runoff (mm) */
+                      )
 {
-  Real runoff;
   Real perc,slug;
   Real TT; /*traveltime in [mm/h]*/
   Real HC; /*hydraulic conductivity in [mm/h]*/
   Real influx;
   Real frac_g_influx;
-  Real outflux,grunoff,inactive_water[NSOILLAYER];
-  Real runoff_surface,freewater,soil_infil;
-  Soil *soil;
+  Real grunoff,inactive_water[NSOILLAYER];
+  Real freewater;
   int l;
   Real updated_soil_water=0,previous_soil_water[NSOILLAYER];
   String line;
-  Irrigation *data_irrig;
-  data_irrig=stand->data;
-
-  soil=&stand->soil;
-  soil_infil=2; /* default to draw square root for infiltration factor*/
   influx=grunoff=perc=frac_g_influx=freewater=0.0;
-  runoff_surface=runoff=outflux=0;
-  if(rw_manage)
-    if(stand->type->landusetype==AGRICULTURE || stand->type->landusetype==GRASSLAND || stand->type->landusetype==BIOMASS_GRASS || stand->type->landusetype==BIOMASS_TREE)
-      soil_infil=param.soil_infil; /* parameter to increase soil infiltration rate */
-  if(soil_infil<2)
-    soil_infil=2;
-
   for(l=0;l<NSOILLAYER;l++)
   {
     previous_soil_water[l]=soil->w[l]*soil->par->whcs[l]+soil->ice_depth[l]+soil->w_fw[l]+soil->ice_fw[l];
@@ -59,10 +68,10 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
   while(infil > epsilon || freewater > epsilon)
   {
     freewater=0.0;
-    slug=min(4,infil);
+    slug=min(slugsize,infil);
     infil=infil-slug;
     influx=slug*pow(1-(soil->w[0]*soil->par->whcs[0]+soil->w_fw[0]+soil->ice_depth[0]+soil->ice_fw[0])/(soil->par->wsats[0]-soil->par->wpwps[0]),(1/soil_infil));
-    runoff_surface+=slug - influx;
+    *runoff_surface+=slug - influx;
     frac_g_influx=1; /* first layer has only green influx, but lower layers with percolation have mixed frac_g_influx */
 
     for(l=0;l<NSOILLAYER;l++)
@@ -82,7 +91,7 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
       }
       if(updated_soil_water>previous_soil_water[l] && updated_soil_water>0)
       {
-          stand->frac_g[l]=(previous_soil_water[l]*stand->frac_g[l] + (updated_soil_water - previous_soil_water[l])*frac_g_influx)/updated_soil_water; /* new green fraction equals old green amount + new green amount divided by total water */
+          frac_g[l]=(previous_soil_water[l]*frac_g[l] + (updated_soil_water - previous_soil_water[l])*frac_g_influx)/updated_soil_water; /* new green fraction equals old green amount + new green amount divided by total water */
       }
 
       /* lateral runoff of water above saturation */
@@ -90,16 +99,16 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
       {
         grunoff=(soil->w[l]*soil->par->whcs[l])-((soildepth[l]-soil->freeze_depth[l])*(soil->par->wsat-soil->par->wpwp));
         soil->w[l]-=grunoff/soil->par->whcs[l];
-        runoff+=grunoff;
-        *return_flow_b+=grunoff*(1-stand->frac_g[l]);
+        *runoff+=grunoff;
+        *return_flow_b+=grunoff*(1-frac_g[l]);
       }
       /*needed here??? -> Only if (soildepth[l]-soil->freeze_depth[l])*(soil->par->wsat[l]-soil->par->wpwp[l])!=(soil->ice_depth[l]+soil->ice_fw[l])*/
       if((inactive_water[l]+soil->w[l]*soil->par->whcs[l])>soil->par->wsats[l])
       {
         grunoff=(inactive_water[l]+soil->w[l]*soil->par->whcs[l])-soil->par->wsats[l];
         soil->w[l]-=grunoff/soil->par->whcs[l];
-        runoff+=grunoff;
-        *return_flow_b+=grunoff*(1-stand->frac_g[l]);
+        *runoff+=grunoff;
+        *return_flow_b+=grunoff*(1-frac_g[l]);
       }
 
       if (soildepth[l]>soil->freeze_depth[l])
@@ -129,13 +138,13 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
           }
           if(l==BOTTOMLAYER)
           {
-            outflux+=perc;
-            *return_flow_b+=perc*(1-stand->frac_g[l]);
+            *outflux+=perc;
+            *return_flow_b+=perc*(1-frac_g[l]);
           }
           else
           {
             influx=perc;
-            frac_g_influx=stand->frac_g[l];
+            frac_g_influx=frac_g[l];
             soil->perc_energy[l+1]=((soil->temp[l]-soil->temp[l+1])*perc*1e-3)*c_water;
           }
         } /*end percolation*/
@@ -156,11 +165,11 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
     if (fabs(soil->w[l])<epsilon)
       soil->w[l]=0;
     if(soil->w[l]*soil->par->whcs[l]+soil->ice_depth[l]+soil->w_fw[l]+soil->ice_fw[l]<epsilon)
-      stand->frac_g[l]=1.0;
+      frac_g[l]=1.0;
 #ifdef SAFE
-    if(stand->frac_g[l]<(-0.01) || stand->frac_g[l]>(1.01))
+    if(frac_g[l]<(-0.01) || frac_g[l]>(1.01))
     {
-      fprintf(stderr,"Cell (%s) infil perc frac_g error frac_g=  %3.12f standtype= %s\n",sprintcoord(line,&stand->cell->coord),stand->frac_g[l],stand->type->name);
+      fprintf(stderr,"Cell (%s) infil perc frac_g error frac_g=  %3.12f standtype= %s\n",sprintcoord(line,&stand->cell->coord),frac_g[l],stand->type->name);
       fflush(stderr);
     }
    if (soil->w[l]<0)
@@ -176,8 +185,118 @@ Real infil_perc_rain(Stand *stand,       /**< Stand pointer */
 #endif
   } /* soil layer loop */
 
+} /* of 'infil_perc' */
+
+static void infil_copy(Infil *infil_step,  /**< result of infiltration */
+                       Stand *stand,       /**< Stand pointer */
+                       const Soil *soil,   /**< soil of stand */
+                       const Real frac_g[],/**< fraction of green water in soil layers */
+                       Real infil,         /**< infiltrating water (mm) */
+                       Real slugsize,      /**< size of slugs (mm) */
+                       Real soil_infil     /**< infiltration parameter */
+                      )
+{
+  /* infiltrate on copy of soil water state */
+  infil_step->soil=*soil;
+  memcpy(infil_step->frac_g,frac_g,sizeof(Real)*NSOILLAYER);
+  infil_step->return_flow_b=infil_step->runoff=infil_step->outflux=infil_step->runoff_surface=0;
+  infil_perc(stand,&infil_step->soil,infil_step->frac_g,infil,slugsize,soil_infil,
+             &infil_step->return_flow_b,&infil_step->runoff,&infil_step->outflux,
+             &infil_step->runoff_surface);
+} /* of 'infil_copy' */
+
+static void infil_adaptive(Stand *stand,        /**< Stand pointer */
+                           Soil *soil,          /**< soil of stand */
+                           Real frac_g[],       /**< fraction of green water in soil layers */
+                           Real infil,          /**< infiltrating water (mm) */
+                           Real soil_infil,     /**< infiltration parameter */
+                           Real *return_flow_b, /**< blue water return flow (mm) */
+                           Real *runoff,        /**< lateral runoff (mm) */
+                           Real *outflux,       /**< seepage (mm) */
+                           Real *runoff_surface /**< surface runoff (mm) */
+                          )
+{
+  Infil step[2];
+  Real slugsize;
+  int coarse;
+  if(infil<=SLUG*MAXSLUG)
+  {
+    infil_perc(stand,soil,frac_g,infil,SLUG,soil_infil,
+               return_flow_b,runoff,outflux,runoff_surface);
+    return;
+  }
+  slugsize=infil/MAXSLUG;
+  coarse=0;
+  infil_copy(step,stand,soil,frac_g,infil,slugsize,soil_infil);
+  for(;;)
+  {
+    slugsize*=0.5;
+    if(slugsize<=SLUG)
+    {
+      /* no convergence above slug size of reference solver */
+      infil_perc(stand,soil,frac_g,infil,SLUG,soil_infil,
+                 return_flow_b,runoff,outflux,runoff_surface);
+      return;
+    }
+    infil_copy(step+1-coarse,stand,soil,frac_g,infil,slugsize,soil_infil);
+    if(fabs(step[0].runoff-step[1].runoff)<=INFIL_TOL &&
+       fabs(step[0].outflux-step[1].outflux)<=INFIL_TOL &&
+       fabs(step[0].runoff_surface-step[1].runoff_surface)<=INFIL_TOL)
+      break;
+    coarse=1-coarse;
+  }
+  /* accept result of smaller slug size */
+  *soil=step[1-coarse].soil;
+  memcpy(frac_g,step[1-coarse].frac_g,sizeof(Real)*NSOILLAYER);
+  *return_flow_b+=step[1-coarse].return_flow_b;
+  *runoff+=step[1-coarse].runoff;
+  *outflux+=step[1-coarse].outflux;
+  *runoff_surface+=step[1-coarse].runoff_surface;
+} /* of 'infil_adaptive' */
+
+Real infil_perc_rain(Stand *stand,        /**< Stand pointer */
+                     Real infil,          /**< rainfall + melting water - interception_stand (mm) + rw_irrig */
+                     Real *return_flow_b, /**< blue water return flow (mm) */
+                     const Config *config /**< LPJmL configuration */
+                    )                     /** \return water runoff (mm) */
+{
+  Real runoff;
+  Real outflux;
+  Real runoff_surface,soil_infil;
+  Infil ref;
+  Soil *soil;
+  Irrigation *data_irrig;
+  data_irrig=stand->data;
+
+  soil=&stand->soil;
+  soil_infil=2; /* default to draw square root for infiltration factor*/
+  runoff_surface=runoff=outflux=0;
+  if(config->rw_manage)
+    if(stand->type->landusetype==AGRICULTURE || stand->type->landusetype==GRASSLAND || stand->type->landusetype==BIOMASS_GRASS || stand->type->landusetype==BIOMASS_TREE)
+      soil_infil=param.soil_infil; /* parameter to increase soil infiltration rate */
+  if(soil_infil<2)
+    soil_infil=2;
+  if(config->infil_solver==INFIL_VERIFY)
+  {
+    /* run adaptive solver on copy of soil water state */
+    ref.soil=*soil;
+    memcpy(ref.frac_g,stand->frac_g,sizeof(Real)*NSOILLAYER);
+    ref.return_flow_b=ref.runoff=ref.outflux=ref.runoff_surface=0;
+    infil_adaptive(stand,&ref.soil,ref.frac_g,infil,soil_infil,
+                   &ref.return_flow_b,&ref.runoff,&ref.outflux,&ref.runoff_surface);
+  }
+  if(config->infil_solver==INFIL_ADAPTIVE)
+    infil_adaptive(stand,soil,stand->frac_g,infil,soil_infil,
+                   return_flow_b,&runoff,&outflux,&runoff_surface);
+  else
+    infil_perc(stand,soil,stand->frac_g,infil,SLUG,soil_infil,
+               return_flow_b,&runoff,&outflux,&runoff_surface);
+  if(config->infil_solver==INFIL_VERIFY)
+    stand->cell->balance.infil_diff+=(ref.runoff+ref.outflux+ref.runoff_surface
+                                     -runoff-outflux-runoff_surface)*stand->frac;
+
   /* Rainwater Harvesting: store part of surface runoff for supplementary irrigation */
-  if(rw_manage && ((stand->type->landusetype==AGRICULTURE && !data_irrig->irrigation) || stand->type->landusetype==SETASIDE_RF))
+  if(config->rw_manage && ((stand->type->landusetype==AGRICULTURE && !data_irrig->irrigation) || stand->type->landusetype==SETASIDE_RF))
   {
     soil->rw_buffer+=param.frac_ro_stored*runoff_surface;
     runoff_surface-=param.frac_ro_stored*runoff_surface;
@@ -0,0 +1,57 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                        l  i  t  t  e  r  _  a  g  .  c                         \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function computes sums of above-ground litter pools for trees for          \n**/
+/**     each fuel class, for grass and the total without 1000h fuel in one         \n**/
+/**     pass over the litter list. Results are identical to the functions          \n**/
+/**     litter_ag_tree(), litter_ag_grass() and litter_ag_sum_quick().             \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void litter_ag(Litter_ag *sum,      /**< above-ground litter sums (gC/m2) */
+               const Litter *litter /**< pointer to litter data */
+              )
+{
+  int i,l;
+  for(i=0;i<NFUELCLASS;i++)
+    sum->tree[i]=0;
+  sum->grass=sum->sum_quick=0;
+  for(l=0;l<litter->n;l++)
+  {
+    if(litter->ag[l].pft->type==TREE)
+    {
+      sum->tree[0]+=litter->ag[l].trait.leaf+litter->ag[l].trait.wood[0];
+      for(i=1;i<NFUELCLASS;i++)
+        sum->tree[i]+=litter->ag[l].trait.wood[i];
+    }
+    else if(litter->ag[l].pft->type==GRASS || litter->ag[l].pft->type==CROP)
+      sum->grass+=litter->ag[l].trait.leaf;
+    sum->sum_quick+=litter->ag[l].trait.leaf;
+    for(i=0;i<NFUELCLASS-1;i++)
+      sum->sum_quick+=litter->ag[l].trait.wood[i];
+  }
+#ifdef DEBUG_LITTER
+  /* cross-check with full recalculation */
+  for(i=0;i<NFUELCLASS;i++)
+    if(sum->tree[i]!=litter_ag_tree(litter,i))
+      fprintf(stderr,"Invalid tree litter %g!=%g for fuel class %d in litter_ag().\n",
+              sum->tree[i],litter_ag_tree(litter,i),i);
+  if(sum->grass!=litter_ag_grass(litter))
+    fprintf(stderr,"Invalid grass litter %g!=%g in litter_ag().\n",
+            sum->grass,litter_ag_grass(litter));
+  if(sum->sum_quick!=litter_ag_sum_quick(litter))
+    fprintf(stderr,"Invalid litter sum %g!=%g in litter_ag().\n",
+            sum->sum_quick,litter_ag_sum_quick(litter));
+#endif
+} /* of 'litter_ag' */
@@ -16,9 +16,6 @@
 
 #define JOHANSEN
 #define K_DRY 0.237 /* assuming a bulk density of 1600 kg/m3, following Farouki (1981)*/
-#define K_SOLID 8
-#define K_ICE 2.2
-#define K_WATER 0.57
 
 Real soilconduct(const Soil *soil, /**< pointer to soil data */
                  int layer         /**< soil layer */
@@ -34,9 +31,14 @@ Real soilconduct(const Soil *soil, /**< pointer to soil data */
 #ifdef JOHANSEN
    Real k_sat,sat,ke,
         por;
-   por=soil->par->wsats[layer]/soildepth[layer];  /*porosity*/
-   k_sat = pow(K_SOLID,(1-por))*pow(K_ICE,(por*soil->freeze_depth[layer]/soildepth[layer]))
-           *pow(K_WATER,(por*(1-soil->freeze_depth[layer]/soildepth[layer])));
+   if(soil->freeze_depth[layer]==0)
+     k_sat=soil->par->k_sat[layer]; /* precalculated for unfrozen soil */
+   else
+   {
+     por=soil->par->wsats[layer]/soildepth[layer];  /*porosity*/
+     k_sat = pow(K_SOLID,(1-por))*pow(K_ICE,(por*soil->freeze_depth[layer]/soildepth[layer]))
+             *pow(K_WATER,(por*(1-soil->freeze_depth[layer]/soildepth[layer])));
+   }
    /* saturation */
    sat=(soil->w[layer]*soil->par->whcs[layer]+soil->ice_depth[layer]+soil->par->wpwps[layer]
         +soil->w_fw[layer]+soil->ice_fw[layer])/soil->par->wsats[layer];
@@ -49,6 +49,8 @@ void soiltemp(Soil *soil,   /**< pointer to soil data */
        dT,                       /* change in temperature [K] */
        heat,heat2,               /* energy for water/ice conversions [J/m2]*/
        dt,                       /* change in time [s]*/
+       dtime,                    /* length of heat step [s] */
+       coeff,                    /* temperature change per heat step and K of gradient */
        z0;                       /* depth of hypothetic Zero-degree Isotherme (assuming homogeneous soil properties)*/
   Real layer;
   int l;
@@ -132,11 +134,13 @@ void soiltemp(Soil *soil,   /**< pointer to soil data */
   {
     t_lower=(l==BOTTOMLAYER) ? t_upper : soil->temp[l+1];
     admit_lower=(l==BOTTOMLAYER) ? admit[l] : admit[l+1];
+    /* constant for all heat steps of this layer */
+    dtime=timestep2sec(1.0,heat_steps[l]);
+    coeff=th_diff[l]*dtime/(soildepth[l]*soildepth[l])*1000000;
     for (t=0; t<heat_steps[l];++t)
     {
       /* temperature change during this timestep*/
-      dT=th_diff[l]*timestep2sec(1.0,heat_steps[l])/(soildepth[l]*soildepth[l])*1000000
-          *(t_upper+t_lower-2*soil->temp[l]);
+      dT=coeff*(t_upper+t_lower-2*soil->temp[l]);
       if((dT>-epsilon&&dT<epsilon) || t==maxheatsteps)
         break;
       if(soil->temp[l]*t_upper>0 && t_upper*t_lower>0 && (soil->temp[l]+dT)*t_upper>0)
@@ -185,7 +189,7 @@ void soiltemp(Soil *soil,   /**< pointer to soil data */
         {
           /* phase transition in this layer */
           /* use part of available energy for water conversion*/                
-          heat=z0/soildepth[l]*lambda[l]*dT/soildepth[l]*1000*timestep2sec(1.0,heat_steps[l]);       
+          heat=z0/soildepth[l]*lambda[l]*dT/soildepth[l]*1000*dtime;       
           if (dT>0 && allice(soil,l)>epsilon)
           {
             if(getstate(soil->temp+l)==ABOVE_T_ZERO)
@@ -202,15 +206,15 @@ void soiltemp(Soil *soil,   /**< pointer to soil data */
               moisture2soilice(soil, &heat, l);
             soil->state[l]=FREEZING;
           }                   
-          dT=(1-z0/soildepth[l])*dT+heat/lambda[l]*(soildepth[l]*1e-3)/timestep2sec(1.0,heat_steps[l]);
+          dT=(1-z0/soildepth[l])*dT+heat/lambda[l]*(soildepth[l]*1e-3)/dtime;
         }
         else
         { /*whole layer is heated*/
           /* energy corresponding to dT*/
-          heat=lambda[l]*dT/soildepth[l]*1000*timestep2sec(1.0,heat_steps[l]);
+          heat=lambda[l]*dT/soildepth[l]*1000*dtime;
           convert_water(soil,l,&heat);
           /*energy left after water conversion changes temperature*/
-          dT=heat*(soildepth[l]*1e-3)/lambda[l]/timestep2sec(1.0,heat_steps[l]);
+          dT=heat*(soildepth[l]*1e-3)/lambda[l]/dtime;
           soil->state[l]=(short)getstate(soil->temp+l);
         }
         soil->temp[l]+=dT;
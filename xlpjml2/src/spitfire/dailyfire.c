@@ -15,9 +15,48 @@
 /**************************************************************************************/
 
 #include "lpj.h"
+#include "grass.h"
 #define CG 0.2 /*cloud to ground flashes ratio */
 #define LER 0.04 /*efficiency in starting fires */
 
+/*
+ * Define VERIFY_FIRE to run the full fire calculation also for stands
+ * where no fire can occur and to check that burnt area and emissions
+ * are zero
+ */
+
+static Bool isnofire(const Stand *stand, /**< pointer to stand */
+                     Livefuel *livefuel  /**< live fuel */
+                    )                    /** \return no fire possible (TRUE/FALSE) */
+{
+  /*
+   * Fire danger index is zero without Nesterov index or if dead fuel or
+   * live grass are missing (see fuelload() and firedangerindex()), then
+   * number of fires and burnt area are zero, too.
+   * Live grass biomass is updated as in fuelload() because it is used
+   * by the following stands.
+   */
+  const Pft *pft;
+  const Pftgrass *grass;
+  Real livegrass;
+  int p;
+  livegrass=0;
+  foreachpft(pft,p,&stand->pftlist)
+  {
+    if(isgrass(pft))
+    {
+      grass=pft->data;
+      livegrass += c2biomass((grass->ind.leaf * pft->nind )* pft->phen);
+      if(pft->par->path==C3)
+        livefuel->pot_fc_lg_c3 = c2biomass(grass->ind.leaf*pft->nind*pft->phen);
+      else
+        livefuel->pot_fc_lg_c4 = c2biomass(grass->ind.leaf*pft->nind*pft->phen);
+    }
+  }
+  return stand->cell->ignition.nesterov_max<=0 || livegrass<=epsilon ||
+         c2biomass(litter_ag_sum_quick(&stand->soil.litter))<=epsilon;
+} /* of 'isnofire' */
+
 void dailyfire(Stand *stand,            /**< pointer to stand */
                Livefuel *livefuel,
                Real popdens,            /**< population density (capita/km2) */
@@ -36,6 +75,10 @@ void dailyfire(Stand *stand,            /**< pointer to stand */
   Output *output;
   Pft *pft;
   Tracegas emission={0,0,0,0,0,0};
+#ifdef VERIFY_FIRE
+  Bool nofire;
+  String line;
+#endif
   output=&stand->cell->output;
   initfuel(&fuel);
 
@@ -65,6 +108,13 @@ void dailyfire(Stand *stand,            /**< pointer to stand */
     /* if burnt area is simulated use the actual Nesterov index instead the maximum */
     stand->cell->ignition.nesterov_max = stand->cell->ignition.nesterov_accum;
   }
+  /* skip calculation of fire if burnt area must be zero */
+#ifdef VERIFY_FIRE
+  nofire=!prescribe_burntarea && isnofire(stand,livefuel);
+#else
+  if(!prescribe_burntarea && isnofire(stand,livefuel))
+    return;
+#endif
 
   fuelload(stand, &fuel, livefuel, stand->cell->ignition.nesterov_max);
   fire_danger_index=firedangerindex(fuel.char_moist_factor,
@@ -144,6 +194,13 @@ void dailyfire(Stand *stand,            /**< pointer to stand */
     }
   }
   total_firec = (deadfuel_consump + livefuel_consump) * stand->frac;
+#ifdef VERIFY_FIRE
+  if(nofire && (fire_danger_index!=0 || burnt_area!=0 || total_firec!=0 ||
+     emission.co2!=0 || emission.co!=0 || emission.ch4!=0 ||
+     emission.voc!=0 || emission.tpm!=0 || emission.nox!=0))
+    fail(INVALID_FIRE_ERR,TRUE,"Cell (%s) fire in stand '%s' not skipped: fire danger index=%g, burnt area=%g ha, fire carbon=%g gC/m2",
+         sprintcoord(line,&stand->cell->coord),stand->type->name,fire_danger_index,burnt_area,total_firec);
+#endif
 
   /* write SPITFIRE outputs to LPJ output structures */
   output->mfiredi +=fire_danger_index;
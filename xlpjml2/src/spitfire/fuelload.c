@@ -37,6 +37,7 @@ void fuelload(Stand *stand,
   Real ratio_c3_livegrass, ratio_c4_livegrass;
   Real livegrass,dlm_1hr,fbd_livefuel,fbd_deadfuel;
   Real fuel_gBiomass[NFUELCLASS];
+  Litter_ag litter_sum;
   Pft *pft;
   Pftgrass *grass;
   int p,i;
@@ -54,13 +55,14 @@ void fuelload(Stand *stand,
     for(j=1;j<NFUELCLASS;j++)
       fuel_gBiomass[j]+=c2biomass(litter->ag[i].trait.wood[j]);
   } */
-  /*TODO: simplify loop with new function litter_ag_tree.c!! */
-  fuel_gBiomass[0]=c2biomass(litter_ag_grass(&stand->soil.litter)+litter_ag_tree(&stand->soil.litter,0));
+  /* all litter sums are calculated in one pass over the litter list */
+  litter_ag(&litter_sum,&stand->soil.litter);
+  fuel_gBiomass[0]=c2biomass(litter_sum.grass+litter_sum.tree[0]);
   for (i=1; i<NFUELCLASS;++i) /* 1hr fuel consumption not included*/
-    fuel_gBiomass[i]=c2biomass(litter_ag_tree(&stand->soil.litter,i));
+    fuel_gBiomass[i]=c2biomass(litter_sum.tree[i]);
 
   /* Dead fuel load, excluding 1000 hr fuels & convert to biomass (g m-2) */
-  dead_fuel = c2biomass(litter_ag_sum_quick(&stand->soil.litter));
+  dead_fuel = c2biomass(litter_sum.sum_quick);
 
   /* Net fuel load (kg biomass)*/
   if (dead_fuel > 0)
@@ -110,9 +112,9 @@ void fuelload(Stand *stand,
   /* average fuel bulk density for live and dead fuel*/
   fbd_livefuel = fbd_c3_livegrass * ratio_c3_livegrass +
                  fbd_c4_livegrass * ratio_c4_livegrass;
-  fbd_deadfuel = stand->soil.litter.avg_fbd[NFUELCLASS]*litter_ag_grass(&stand->soil.litter);
+  fbd_deadfuel = stand->soil.litter.avg_fbd[NFUELCLASS]*litter_sum.grass;
   for (i=0; i<NFUELCLASS-1;++i)
-    fbd_deadfuel += stand->soil.litter.avg_fbd[i]*litter_ag_tree(&stand->soil.litter,i)*fbd_fac[i]; /*fbd_fac replaces FBD_A + FBD_B*/
+    fbd_deadfuel += stand->soil.litter.avg_fbd[i]*litter_sum.tree[i]*fbd_fac[i]; /*fbd_fac replaces FBD_A + FBD_B*/
   if(dead_fuel > epsilon)
     fbd_deadfuel /= biomass2c(dead_fuel);
     /*fbd_deadfuel /= litter_ag_sum_quick(&stand->soil.litter); */
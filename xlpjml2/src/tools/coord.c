@@ -181,6 +181,30 @@ Bool readintcoord(FILE *file,      /**< pointer to binary file */
   return FALSE;
 } /* of 'readintcoord' */
 
+static void setcoord(Coord *coord,     /**< cell coordinate */
+                     int ilon,int ilat, /**< integer coordinate */
+                     float scalar,      /**< scaling factor */
+                     const Coord *resol /**< resolution (deg) */
+                    )
+{
+  coord->lat=ilat*scalar;
+  coord->lon=ilon*scalar;
+  if(resol->lat==0.25)
+  {
+    if(coord->lat>=0)
+      coord->lat+=0.005;
+    else
+      coord->lat-=0.005;
+  }
+  if(resol->lon==0.25)
+  {
+    if(coord->lon>=0)
+      coord->lon+=0.005;
+    else
+      coord->lon-=0.005;
+  }
+} /* of 'setcoord' */
+
 Bool readcoord(Coordfile coordfile, /**< open coord file */
                Coord *coord,        /**< cell coordinate read from file */
                const Coord *resol   /**< resolution (deg) */
@@ -195,22 +219,7 @@ Bool readcoord(Coordfile coordfile, /**< open coord file */
     case LPJ_SHORT:
       if(readintcoord(coordfile->file,&icoord,coordfile->swap))
         return TRUE;
-      coord->lat=icoord.lat*coordfile->scalar;
-      coord->lon=icoord.lon*coordfile->scalar;
-      if(resol->lat==0.25)
-      {
-        if(coord->lat>=0)
-          coord->lat+=0.005;
-        else
-          coord->lat-=0.005;
-      }
-      if(resol->lon==0.25)
-      {
-        if(coord->lon>=0)
-          coord->lon+=0.005;
-        else
-          coord->lon-=0.005;
-      }
+      setcoord(coord,icoord.lon,icoord.lat,coordfile->scalar,resol);
       break;
     case LPJ_FLOAT:
       if(freadfloat(&lon,1,coordfile->swap,coordfile->file)!=1)
@@ -244,6 +253,105 @@ Bool readcoord(Coordfile coordfile, /**< open coord file */
   return FALSE;
 } /* of 'readcoord' */
 
+Bool readcoords(Coordfile coordfile, /**< open coord file */
+                Coord coords[],      /**< cell coordinates read from file */
+                int n,               /**< number of coordinates */
+                const Coord *resol   /**< resolution (deg) */
+               )                     /** \return FALSE for successful read */
+{
+  /* Function reads n coordinates with one read call */
+  Intcoord *icoord;
+  float *fvec;
+  double *dvec;
+  int *ivec;
+  int i;
+  Bool rc;
+  if(n==0)
+    return FALSE;
+  rc=FALSE;
+  switch(coordfile->datatype)
+  {
+    case LPJ_SHORT:
+      icoord=newvec(Intcoord,n);
+      if(icoord==NULL)
+      {
+        printallocerr("icoord");
+        return TRUE;
+      }
+      if(fread(icoord,sizeof(Intcoord),n,coordfile->file)!=n)
+        rc=TRUE;
+      else
+        for(i=0;i<n;i++)
+        {
+          if(coordfile->swap)
+          {
+            icoord[i].lat=swapshort(icoord[i].lat);
+            icoord[i].lon=swapshort(icoord[i].lon);
+          }
+          setcoord(coords+i,icoord[i].lon,icoord[i].lat,coordfile->scalar,resol);
+        }
+      free(icoord);
+      break;
+    case LPJ_FLOAT:
+      fvec=newvec(float,2*n);
+      if(fvec==NULL)
+      {
+        printallocerr("fvec");
+        return TRUE;
+      }
+      if(freadfloat(fvec,2*n,coordfile->swap,coordfile->file)!=2*n)
+        rc=TRUE;
+      else
+        for(i=0;i<n;i++)
+        {
+          coords[i].lon=fvec[2*i];
+          coords[i].lat=fvec[2*i+1];
+        }
+      free(fvec);
+      break;
+    case LPJ_DOUBLE:
+      dvec=newvec(double,2*n);
+      if(dvec==NULL)
+      {
+        printallocerr("dvec");
+        return TRUE;
+      }
+      if(freaddouble(dvec,2*n,coordfile->swap,coordfile->file)!=2*n)
+        rc=TRUE;
+      else
+        for(i=0;i<n;i++)
+        {
+          coords[i].lon=dvec[2*i];
+          coords[i].lat=dvec[2*i+1];
+        }
+      free(dvec);
+      break;
+    case LPJ_INT:
+      ivec=newvec(int,2*n);
+      if(ivec==NULL)
+      {
+        printallocerr("ivec");
+        return TRUE;
+      }
+      if(freadint(ivec,2*n,coordfile->swap,coordfile->file)!=2*n)
+        rc=TRUE;
+      else
+        for(i=0;i<n;i++)
+        {
+          coords[i].lat=ivec[2*i+1]*coordfile->scalar;
+          coords[i].lon=ivec[2*i]*coordfile->scalar;
+        }
+      free(ivec);
+      break;
+    default:
+      return TRUE;
+  } /* of switch */
+  if(!rc)
+    for(i=0;i<n;i++)
+      coords[i].area=cellarea(coords+i,resol);
+  return rc;
+} /* of 'readcoords' */
+
 Bool writecoord(FILE *file,        /**< pointer to binary file */
                 const Coord *coord /**< cell coordinate written to file */
                )                   /** \return FALSE for successful write */
@@ -0,0 +1,77 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              f  r  e  a  d  c  h  u  n  k  h  e  a  d  e  r  .  c              \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads chunk parameters and chunk index of LPJ files               \n**/
+/**     in chunked format (version 4). Header has to be read before.               \n**/
+/**     Chunk offsets are checked to be increasing and inside the file.            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Chunkheader *freadchunkheader(FILE *file,          /**< pointer to binary file */
+                              const char *filename, /**< name of binary file */
+                              const Header *header, /**< file header */
+                              Bool swap            /**< byte order has to be swapped */
+                             )                     /** \return chunk header or NULL on error */
+{
+  Chunkheader *chunk;
+  int par[4];
+  size_t i,n;
+  long long pos;
+  if(freadint(par,4,swap,file)!=4)
+    return NULL;
+  if(par[0]<1 || par[1]<1 || par[2]<CHUNK_NOCOMPRESS || par[2]>CHUNK_DEFLATE ||
+     par[3]<CHUNK_NOFILTER || par[3]>CHUNK_SHUFFLE)
+    return NULL;
+  chunk=new(Chunkheader);
+  if(chunk==NULL)
+  {
+    printallocerr("chunk");
+    return NULL;
+  }
+  chunk->header=*header;
+  chunk->nyear=par[0];
+  chunk->ncell=par[1];
+  chunk->compress=par[2];
+  chunk->filter=par[3];
+  chunk->filename=filename;
+  chunk->nchunk_year=(header->nyear+chunk->nyear-1)/chunk->nyear;
+  chunk->nchunk_cell=(header->ncell+chunk->ncell-1)/chunk->ncell;
+  n=(size_t)chunk->nchunk_year*chunk->nchunk_cell+1;
+  chunk->index=newvec(long long,n);
+  if(chunk->index==NULL)
+  {
+    printallocerr("index");
+    free(chunk);
+    return NULL;
+  }
+  if(freadlong(chunk->index,n,swap,file)!=n)
+  {
+    freechunkheader(chunk);
+    return NULL;
+  }
+  /* chunks must follow the index and must not exceed end of file */
+  pos=ftell(file);
+  if(chunk->index[0]<pos || chunk->index[n-1]>getfilesize(filename))
+  {
+    freechunkheader(chunk);
+    return NULL;
+  }
+  for(i=0;i<n-1;i++)
+    if(chunk->index[i+1]<=chunk->index[i])
+    {
+      freechunkheader(chunk);
+      return NULL;
+    }
+  return chunk;
+} /* of 'freadchunkheader' */
@@ -0,0 +1,27 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               f  r  e  e  c  h  u  n  k  h  e  a  d  e  r  .  c                \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function deallocates chunk header                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+void freechunkheader(Chunkheader *chunk /**< chunk header */
+                    )
+{
+  if(chunk!=NULL)
+  {
+    free(chunk->index);
+    free(chunk);
+  }
+} /* of 'freechunkheader' */
@@ -0,0 +1,39 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**             f  r  e  e  g  a  t  h  e  r  p  l  a  n  .  c                     \n**/
+/**                                                                                \n**/
+/**     Function deallocates gather plan                                           \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+void freegatherplan(Gatherplan *plan /**< gather plan */
+                   )
+{
+#if MPI_VERSION>=4
+  int i;
+#endif
+  if(plan!=NULL)
+  {
+#if MPI_VERSION>=4
+    for(i=0;i<NGATHERTYPE;i++)
+      MPI_Request_free(plan->request+i);
+    free(plan->send);
+#endif
+    free(plan->counts);
+    free(plan->offsets);
+    free(plan->vec);
+    free(plan);
+  }
+} /* of 'freegatherplan' */
+
+#endif
@@ -0,0 +1,132 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     f  w  r  i  t  e  c  h  u  n  k  .  c                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function filters, compresses and writes one chunk of LPJ files             \n**/
+/**     in chunked format (version 4). Data of the chunk have to be in             \n**/
+/**     native byte order ordered by year, cell and band. Compression              \n**/
+/**     requires zlib and -DUSE_ZLIB flag.                                         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+static void deltaencode(void *data,        /**< data of chunk */
+                        size_t nrec,       /**< number of records */
+                        int nbands,        /**< number of bands per record */
+                        Type type          /**< datatype of data */
+                       )
+{
+  size_t i;
+  int b;
+  /* differences of consecutive bands are stored, wrap-around is intended */
+  switch(type)
+  {
+    case LPJ_BYTE:
+      for(i=0;i<nrec;i++)
+        for(b=nbands-1;b>0;b--)
+          ((Byte *)data)[i*nbands+b]-=((Byte *)data)[i*nbands+b-1];
+      break;
+    case LPJ_SHORT:
+      for(i=0;i<nrec;i++)
+        for(b=nbands-1;b>0;b--)
+          ((unsigned short *)data)[i*nbands+b]-=((unsigned short *)data)[i*nbands+b-1];
+      break;
+    case LPJ_INT:
+      for(i=0;i<nrec;i++)
+        for(b=nbands-1;b>0;b--)
+          ((unsigned int *)data)[i*nbands+b]-=((unsigned int *)data)[i*nbands+b-1];
+      break;
+    default:
+      break;
+  }
+} /* of 'deltaencode' */
+
+long long fwritechunk(FILE *file,               /**< pointer to binary file */
+                      const Chunkheader *chunk, /**< chunk header */
+                      const void *data,         /**< data of chunk */
+                      int nyear,                /**< number of years in chunk */
+                      int ncell                 /**< number of cells in chunk */
+                     )                          /** \return number of bytes written or -1 on error */
+{
+  char *buffer,*filtered;
+  size_t i,n,size;
+  int k,len;
+#ifdef USE_ZLIB
+  uLongf zsize;
+  Bytef *zbuffer;
+#endif
+  len=typesizes[chunk->header.datatype];
+  n=(size_t)nyear*ncell*chunk->header.nbands;
+  size=n*len;
+  buffer=malloc(size);
+  if(buffer==NULL)
+  {
+    printallocerr("buffer");
+    return -1;
+  }
+  if(chunk->filter==CHUNK_SHUFFLE)
+  {
+    filtered=malloc(size);
+    if(filtered==NULL)
+    {
+      printallocerr("filtered");
+      free(buffer);
+      return -1;
+    }
+    memcpy(filtered,data,size);
+    deltaencode(filtered,n/chunk->header.nbands,chunk->header.nbands,chunk->header.datatype);
+    /* bytes of same significance are stored together */
+    for(i=0;i<n;i++)
+      for(k=0;k<len;k++)
+        buffer[k*n+i]=filtered[i*len+k];
+    free(filtered);
+  }
+  else
+    memcpy(buffer,data,size);
+  if(chunk->compress==CHUNK_DEFLATE)
+  {
+#ifdef USE_ZLIB
+    zsize=compressBound(size);
+    zbuffer=malloc(zsize);
+    if(zbuffer==NULL)
+    {
+      printallocerr("zbuffer");
+      free(buffer);
+      return -1;
+    }
+    if(compress2(zbuffer,&zsize,(Bytef *)buffer,size,Z_DEFAULT_COMPRESSION)!=Z_OK ||
+       fwrite(zbuffer,1,zsize,file)!=zsize)
+    {
+      free(zbuffer);
+      free(buffer);
+      return -1;
+    }
+    free(zbuffer);
+    free(buffer);
+    return zsize;
+#else
+    fputs("ERROR264: Compression of chunks not supported, compile with -DUSE_ZLIB.\n",stderr);
+    free(buffer);
+    return -1;
+#endif
+  }
+  if(fwrite(buffer,1,size,file)!=size)
+  {
+    free(buffer);
+    return -1;
+  }
+  free(buffer);
+  return size;
+} /* of 'fwritechunk' */
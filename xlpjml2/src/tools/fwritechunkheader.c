@@ -0,0 +1,34 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**            f  w  r  i  t  e  c  h  u  n  k  h  e  a  d  e  r  .  c             \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes chunk parameters and chunk index of LPJ files              \n**/
+/**     in chunked format (version 4).                                             \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool fwritechunkheader(FILE *file,              /**< pointer to binary file */
+                       const Chunkheader *chunk /**< chunk header */
+                      )                         /** \return TRUE on error */
+{
+  int par[4];
+  size_t n;
+  par[0]=chunk->nyear;
+  par[1]=chunk->ncell;
+  par[2]=chunk->compress;
+  par[3]=chunk->filter;
+  if(fwrite(par,sizeof(int),4,file)!=4)
+    return TRUE;
+  n=(size_t)chunk->nchunk_year*chunk->nchunk_cell+1;
+  return fwrite(chunk->index,sizeof(long long),n,file)!=n;
+} /* of 'fwritechunkheader' */
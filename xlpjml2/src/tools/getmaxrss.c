@@ -0,0 +1,38 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                        g  e  t  m  a  x  r  s  s  .  c                         \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function returns maximum resident set size of process                      \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+#include "types.h"
+
+long long getmaxrss(void) /** \return maximum resident set size (bytes) or 0 */
+{
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF,&usage))
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss; /* in bytes on macOS */
+#else
+  return (long long)usage.ru_maxrss*1024;
+#endif
+#endif
+} /* of 'getmaxrss' */
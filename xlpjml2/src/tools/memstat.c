@@ -0,0 +1,206 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                           m  e  m  s  t  a  t  .  c                            \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions for accounting of allocated memory by subsystem.                 \n**/
+/**     If compiled with -DWITH_MEMSTAT, newvec(), new(), realloc() and            \n**/
+/**     free() call lpjmalloc(), lpjrealloc() and lpjfree(). Sizes and             \n**/
+/**     tags of allocated blocks are stored in a hash table. Blocks                \n**/
+/**     not allocated by newvec() or new(), e.g. by strdup(), are                  \n**/
+/**     not accounted                                                              \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#if defined(WITH_MEMSTAT) && !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+char *memtagnames[NMEMTAG]={"other","grid","stands","output","climate",
+                            "climate store","input","pnet","reservoir"};
+
+#ifdef WITH_MEMSTAT
+
+#undef free
+#undef realloc
+
+#define DELETED ((void *)1) /* marker for deleted entries in hash table */
+#define MINTABLESIZE 1024
+
+typedef struct
+{
+  void *ptr;   /* allocated block, NULL if slot is empty */
+  size_t size; /* size of block (bytes) */
+  Memtag tag;  /* subsystem */
+} Memblock;
+
+static Memblock *table=NULL;  /* hash table with open addressing */
+static size_t tablesize=0;    /* size of hash table, power of 2 */
+static size_t nused=0;        /* number of slots used or deleted */
+static size_t nlive=0;        /* number of slots used */
+static Memstat counters; /* accounted memory */
+#ifndef _WIN32
+static pthread_mutex_t mutex=PTHREAD_MUTEX_INITIALIZER;
+#define lock() pthread_mutex_lock(&mutex)
+#define unlock() pthread_mutex_unlock(&mutex)
+#else
+#define lock()
+#define unlock()
+#endif
+
+static size_t hash(const void *ptr)
+{
+  unsigned long long h;
+  h=(unsigned long long)(size_t)ptr;
+  h^=h>>33;
+  h*=0xff51afd7ed558ccdULL;
+  h^=h>>33;
+  return (size_t)h & (tablesize-1);
+} /* of 'hash' */
+
+static Memblock *findblock(const void *ptr)
+{
+  size_t i;
+  if(tablesize==0)
+    return NULL;
+  for(i=hash(ptr);table[i].ptr!=NULL;i=(i+1) & (tablesize-1))
+    if(table[i].ptr==ptr)
+      return table+i;
+  return NULL;
+} /* of 'findblock' */
+
+static Bool resize(void)
+{
+  Memblock *old;
+  size_t i,j,oldsize;
+  old=table;
+  oldsize=tablesize;
+  tablesize=MINTABLESIZE;
+  while(tablesize<4*nlive)
+    tablesize*=2;
+  table=calloc(tablesize,sizeof(Memblock));
+  if(table==NULL)
+  {
+    table=old;
+    tablesize=oldsize;
+    return TRUE;
+  }
+  for(i=0;i<oldsize;i++)
+    if(old[i].ptr!=NULL && old[i].ptr!=DELETED)
+    {
+      for(j=hash(old[i].ptr);table[j].ptr!=NULL;j=(j+1) & (tablesize-1));
+      table[j]=old[i];
+    }
+  nused=nlive;
+  free(old);
+  return FALSE;
+} /* of 'resize' */
+
+static void addblock(void *ptr,size_t size,Memtag tag)
+{
+  size_t i;
+  if(2*(nused+1)>tablesize && resize())
+    return; /* block is not accounted */
+  for(i=hash(ptr);table[i].ptr!=NULL && table[i].ptr!=DELETED;i=(i+1) & (tablesize-1));
+  if(table[i].ptr==NULL)
+    nused++;
+  nlive++;
+  table[i].ptr=ptr;
+  table[i].size=size;
+  table[i].tag=tag;
+  counters.count[tag]++;
+  counters.live[tag]+=size;
+  if(counters.live[tag]>counters.peak[tag])
+    counters.peak[tag]=counters.live[tag];
+  counters.live_total+=size;
+  if(counters.live_total>counters.peak_total)
+    counters.peak_total=counters.live_total;
+} /* of 'addblock' */
+
+static void delblock(Memblock *block)
+{
+  counters.live[block->tag]-=block->size;
+  counters.live_total-=block->size;
+  block->ptr=DELETED;
+  nlive--;
+} /* of 'delblock' */
+
+void *lpjmalloc(size_t size, /**< size of block (bytes) */
+                Memtag tag   /**< subsystem */
+               )             /** \return pointer to block or NULL */
+{
+  void *ptr;
+  ptr=malloc(size);
+  if(ptr!=NULL)
+  {
+    lock();
+    addblock(ptr,size,tag);
+    unlock();
+  }
+  return ptr;
+} /* of 'lpjmalloc' */
+
+void *lpjrealloc(void *ptr,   /**< block to resize or NULL */
+                 size_t size, /**< new size of block (bytes) */
+                 Memtag tag   /**< subsystem of new block */
+                )             /** \return pointer to block or NULL */
+{
+  Memblock *block;
+  void *newptr;
+  lock(); /* block must not be allocated by another thread before update */
+  block=(ptr==NULL) ? NULL : findblock(ptr);
+  newptr=realloc(ptr,size);
+  if(newptr!=NULL || size==0)
+  {
+    if(block!=NULL)
+    {
+      tag=block->tag;
+      delblock(block);
+    }
+    if(newptr!=NULL)
+      addblock(newptr,size,tag);
+  }
+  unlock();
+  return newptr;
+} /* of 'lpjrealloc' */
+
+void lpjfree(void *ptr /**< block to free or NULL */
+            )
+{
+  Memblock *block;
+  if(ptr==NULL)
+    return;
+  lock();
+  block=findblock(ptr);
+  if(block!=NULL)
+    delblock(block);
+  unlock();
+  free(ptr);
+} /* of 'lpjfree' */
+
+#endif
+
+Bool getmemstat(Memstat *memstat /**< memory statistics */
+               )                 /** \return TRUE if memory is accounted */
+{
+#ifdef WITH_MEMSTAT
+  lock();
+  *memstat=counters;
+  unlock();
+  return TRUE;
+#else
+  memset(memstat,0,sizeof(Memstat));
+  return FALSE;
+#endif
+} /* of 'getmemstat' */
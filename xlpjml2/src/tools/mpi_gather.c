@@ -0,0 +1,49 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                  m  p  i  _  g  a  t  h  e  r  .  c                            \n**/
+/**                                                                                \n**/
+/**     Function gathers data of all tasks on the root task using                  \n**/
+/**     precomputed gather plan                                                    \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+void *mpi_gather(Gatherplan *plan,  /**< gather plan */
+                 const void *data,  /**< data of this task */
+                 MPI_Datatype type  /**< MPI datatype of data */
+                )                   /** \return gathered data on root task or NULL */
+{
+#if MPI_VERSION>=4
+  int i,size;
+  if(type==MPI_FLOAT)
+    i=0;
+  else if(type==MPI_SHORT)
+    i=1;
+  else if(type==MPI_INT)
+    i=2;
+  else
+    i=NGATHERTYPE;
+  if(i<NGATHERTYPE)
+  {
+    MPI_Type_size(type,&size);
+    memcpy(plan->send,data,(size_t)size*plan->counts[plan->rank]);
+    MPI_Start(plan->request+i);
+    MPI_Wait(plan->request+i,MPI_STATUS_IGNORE);
+    return plan->vec;
+  }
+#endif
+  MPI_Gatherv((void *)data,plan->counts[plan->rank],type,plan->vec,plan->counts,
+              plan->offsets,type,0,plan->comm);
+  return plan->vec;
+} /* of 'mpi_gather' */
+
+#endif
@@ -4,7 +4,7 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
-/**     Function writes output from all tasks using MPI_Gatherv                    \n**/
+/**     Function writes output from all tasks using gather plan                    \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -21,31 +21,19 @@
 int mpi_write(FILE *file,        /**< File pointer to binary file */
               void *data,        /**< data to be written to disk */
               MPI_Datatype type, /**< MPI datatype of data */
-              int size,
-              int counts[],
-              int offsets[],
-              int rank,          /**< MPI rank */
-              MPI_Comm comm      /**< MPI communicator */
+              Gatherplan *plan   /**< gather plan */
              )                   /** \return number of items written to disk */
 {
-  int rc=0;
-  MPI_Aint extent;
-  MPI_Type_extent(type,&extent);
+  int rc=0,size;
   void *vec;
-  if(rank==0)
+  vec=mpi_gather(plan,data,type);
+  if(plan->rank==0)
   {
-    vec=malloc(size*extent); /* allocate receive buffer */
-    check(vec);
-  }
-  MPI_Gatherv(data,counts[rank],type,vec,counts,offsets,type,0,comm);
-  if(rank==0)
-  {
-    rc=fwrite(vec,extent,size,file); /* write data to file */
-    if(rc!=size)
+    MPI_Type_size(type,&size);
+    rc=fwrite(vec,size,plan->size,file); /* write data to file */
+    if(rc!=plan->size)
       fprintf(stderr,"ERROR204: Error writing output: %s.\n",strerror(errno));
-    free(vec);
   }
-  MPI_Barrier(comm);
   return rc;
 } /* of 'mpi_write' */
 #endif
@@ -41,41 +41,19 @@ static int write_short(FILE *file,const short vec[],int n)
 int mpi_write_txt(FILE *file,        /**< File pointer to text file */
                   void *data,        /**< data to be written to disk */
                   MPI_Datatype type, /**< MPI datatype of data */
-                  int size,
-                  int counts[],
-                  int offsets[],
-                  int rank,          /**< MPI rank */
-                  MPI_Comm comm      /**< MPI communicator */
+                  Gatherplan *plan   /**< gather plan */
                  )                   /** \return number of items written to disk */
 {
-  int rc;
-  MPI_Aint extent;
+  int rc=0;
   void *vec;
-  MPI_Type_extent(type,&extent);
-  if(rank==0)
-  {
-    vec=malloc(size*extent); /* allocate receive buffer */
-    if(vec==NULL)
-    {
-      printallocerr("vec");
-      rc=TRUE;
-    }
-    else 
-      rc=FALSE;
-  }
-  MPI_Bcast(&rc,1,MPI_INT,0,comm);
-  if(rc)
-    return 0;
-  MPI_Gatherv(data,counts[rank],type,vec,counts,offsets,type,0,comm);
-  if(rank==0)
+  vec=mpi_gather(plan,data,type);
+  if(plan->rank==0)
   {
     if(type==MPI_FLOAT)
-      rc=write_float(file,vec,size); /* write float data to file */
+      rc=write_float(file,vec,plan->size); /* write float data to file */
     else if(type==MPI_SHORT)
-      rc=write_short(file,vec,size); /* write short data to file */
-    free(vec);
+      rc=write_short(file,vec,plan->size); /* write short data to file */
   }
-  MPI_Barrier(comm);
   return rc;
 } /* of 'mpi_write_txt' */
 #endif
@@ -0,0 +1,39 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                                m  r  u  n  .  c                                \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function returns wall clock time in seconds. Used for timing of            \n**/
+/**     simulation phases                                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#ifdef USE_MPI
+#include <mpi.h>
+#elif defined(_WIN32)
+#include <time.h>
+#else
+#include <sys/time.h>
+#endif
+#include "types.h"
+
+double mrun(void) /** \return wall clock time (sec) */
+{
+#ifdef USE_MPI
+  return MPI_Wtime();
+#elif defined(_WIN32)
+  return (double)clock()/CLOCKS_PER_SEC;
+#else
+  struct timeval tv;
+  gettimeofday(&tv,NULL);
+  return tv.tv_sec+tv.tv_usec*1e-6;
+#endif
+} /* of 'mrun' */
@@ -0,0 +1,70 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              n  e  w  g  a  t  h  e  r  p  l  a  n  .  c                       \n**/
+/**                                                                                \n**/
+/**     Function creates plan for gathering data of all tasks on the               \n**/
+/**     root task. Counts, offsets and receive buffer are allocated once           \n**/
+/**     and reused by all writes. With MPI-4 persistent collectives are            \n**/
+/**     initialized for the supported datatypes.                                   \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define MEMTAG MEM_OUTPUT
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+Gatherplan *newgatherplan(int count,    /**< number of items of this task */
+                          MPI_Comm comm /**< MPI communicator */
+                         )              /** \return allocated gather plan */
+{
+  Gatherplan *plan;
+  int i,ntask;
+#if MPI_VERSION>=4
+  MPI_Datatype type[NGATHERTYPE];
+  type[0]=MPI_FLOAT;
+  type[1]=MPI_SHORT;
+  type[2]=MPI_INT;
+#endif
+  plan=new(Gatherplan);
+  check(plan);
+  plan->comm=comm;
+  MPI_Comm_rank(comm,&plan->rank);
+  MPI_Comm_size(comm,&ntask);
+  plan->counts=newvec(int,ntask);
+  check(plan->counts);
+  plan->offsets=newvec(int,ntask);
+  check(plan->offsets);
+  MPI_Allgather(&count,1,MPI_INT,plan->counts,1,MPI_INT,comm);
+  /* calculate array offsets */
+  plan->offsets[0]=0;
+  for(i=1;i<ntask;i++)
+    plan->offsets[i]=plan->offsets[i-1]+plan->counts[i-1];
+  plan->size=plan->offsets[ntask-1]+plan->counts[ntask-1];
+  if(plan->rank==0)
+  {
+    /* buffer is large enough for float, short and int items */
+    plan->vec=newvec(int,max(plan->size,1));
+    check(plan->vec);
+  }
+  else
+    plan->vec=NULL;
+#if MPI_VERSION>=4
+  /* persistent requests are bound to fixed buffers, data are copied into send buffer */
+  plan->send=newvec(int,max(count,1));
+  check(plan->send);
+  for(i=0;i<NGATHERTYPE;i++)
+    MPI_Gatherv_init(plan->send,count,type[i],plan->vec,plan->counts,plan->offsets,
+                     type[i],0,comm,MPI_INFO_NULL,plan->request+i);
+#endif
+  return plan;
+} /* of 'newgatherplan' */
+
+#endif
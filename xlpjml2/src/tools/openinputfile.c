@@ -4,7 +4,11 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
-/**     Functions opens input file and reads file header                           \n**/
+/**     Functions opens input file and reads file header. Files in chunked         \n**/
+/**     format (version 4) are decompressed into a temporary file or the           \n**/
+/**     chunk header is returned for reading of chunks. Only the cells of          \n**/
+/**     the task are decompressed, firstcell and ncell in the header are set       \n**/
+/**     accordingly.                                                               \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -16,6 +20,47 @@
 
 #include "lpj.h"
 
+static FILE *unpackfile(FILE *file,               /* pointer to chunked file */
+                        const Chunkheader *chunk, /* chunk header */
+                        Header *header,           /* file header, cell range is set to cells of task */
+                        Bool swap,                /* byte order has to be changed */
+                        const Config *config      /* LPJmL configuration */
+                       )                          /* returns temporary file or NULL */
+{
+  FILE *tmp;
+  char *data;
+  int i,nyear;
+  size_t size;
+  tmp=tmpfile();
+  if(tmp==NULL)
+    return NULL;
+  data=malloc((size_t)chunk->nyear*config->ngridcell*header->nbands*typesizes[header->datatype]);
+  if(data==NULL)
+  {
+    printallocerr("data");
+    fclose(tmp);
+    return NULL;
+  }
+  /* only chunks containing the cells of the task are decompressed */
+  for(i=0;i<chunk->nchunk_year;i++)
+  {
+    nyear=min(chunk->nyear,header->nyear-i*chunk->nyear);
+    size=(size_t)nyear*config->ngridcell*header->nbands*typesizes[header->datatype];
+    if(readchunks(file,chunk,swap,data,i,config->startgrid-header->firstcell,config->ngridcell) ||
+       fwrite(data,1,size,tmp)!=size)
+    {
+      free(data);
+      fclose(tmp);
+      return NULL;
+    }
+  }
+  free(data);
+  rewind(tmp);
+  header->firstcell=config->startgrid;
+  header->ncell=config->ngridcell;
+  return tmp;
+} /* of 'unpackfile' */
+
 FILE *openinputfile(Header *header, /**< pointer to file header */
                     Bool *swap, /**< byte order has to be changed (TRUE/FALSE) */
                     const Filename *filename, /**< file name */
@@ -25,7 +70,23 @@ FILE *openinputfile(Header *header, /**< pointer to file header */
                     const Config *config /**< grid configuration */
                    )           /** \return file pointer to open file or NULL */
 {
-  FILE *file;
+  return openinputfile2(header,swap,filename,headername,version,offset,NULL,config);
+} /* of 'openinputfile' */
+
+FILE *openinputfile2(Header *header, /**< pointer to file header */
+                     Bool *swap, /**< byte order has to be changed (TRUE/FALSE) */
+                     const Filename *filename, /**< file name */
+                     String headername, /**< clm file header string */
+                     int *version, /**< clm file version */
+                     size_t *offset, /**< offset in binary file */
+                     Chunkheader **chunk, /**< chunk header of chunked file or NULL. If NULL, chunked file is decompressed */
+                     const Config *config /**< grid configuration */
+                    )           /** \return file pointer to open file or NULL */
+{
+  FILE *file,*tmp;
+  Chunkheader *chunkheader;
+  if(chunk!=NULL)
+    *chunk=NULL;
   if(filename->fmt==META)
   {
     *version=4;
@@ -143,6 +204,33 @@ FILE *openinputfile(Header *header, /**< pointer to file header */
       fclose(file);
       return NULL;
     }
+    if(*version==LPJ_CHUNK_VERSION)
+    {
+      chunkheader=freadchunkheader(file,filename->name,header,*swap);
+      if(chunkheader==NULL)
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR154: Invalid chunk header in '%s'.\n",filename->name);
+        fclose(file);
+        return NULL;
+      }
+      if(chunk!=NULL)
+      {
+        *chunk=chunkheader;
+        return file;
+      }
+      /* data of cells of task are decompressed, file is read like a file without header */
+      tmp=unpackfile(file,chunkheader,header,*swap,config);
+      freechunkheader(chunkheader);
+      fclose(file);
+      if(tmp==NULL)
+      {
+        fprintf(stderr,"ERROR265: Cannot decompress '%s'.\n",filename->name);
+        return NULL;
+      }
+      *swap=FALSE;
+      return tmp;
+    }
   }
   return file;
-} /* of 'openinputfile' */
+} /* of 'openinputfile2' */
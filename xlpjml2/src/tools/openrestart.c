@@ -5,7 +5,8 @@
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
 /**     Function opens restart file and seeks to first grid cell as                \n**/
-/**     specified in LPJ configuration                                             \n**/
+/**     specified in LPJ configuration. Optionally the file offsets of             \n**/
+/**     all cells are returned                                                     \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -17,17 +18,18 @@
 
 #include "lpj.h"
 
-FILE *openrestart(const char *filename, /**< filename of restart file */
-                  Config *config,       /**< LPJ configuration */
-                  int ntotpft,          /**< Total number of PFTs */
-                  Bool *swap            /**< Byte order has to be changed */
-                 )                      /** \return file pointer or NULL */
+FILE *openrestart2(const char *filename, /**< filename of restart file */
+                   Config *config,       /**< LPJ configuration */
+                   int ntotpft,          /**< Total number of PFTs */
+                   Bool *swap,           /**< Byte order has to be changed */
+                   long long **index     /**< file offsets of cells and end of last cell or NULL */
+                  )                      /** \return file pointer or NULL */
 {
   FILE *file;
   Header header;
   Restartheader restartheader;
   int offset,version;
-  long long offsetl;
+  long long offsetl,pos;
   char *type;
   /* Open file */
   file=fopen(filename,"rb");
@@ -149,6 +151,7 @@ FILE *openrestart(const char *filename, /**< filename of restart file */
     }
     fseek(file,offset*sizeof(long long),SEEK_CUR);
   }
+  pos=ftell(file);
   /* read index from file */
   freadlong1(&offsetl,*swap,file);
   /* skip to index */
@@ -165,6 +168,38 @@ FILE *openrestart(const char *filename, /**< filename of restart file */
             type,header.ncell);
     config->ngridcell=header.ncell;
   }
-
+  if(index!=NULL)
+  {
+    /* read offsets of all cells, offset of next cell marks end of last cell */
+    *index=newvec(long long,config->ngridcell+1);
+    if(*index==NULL)
+    {
+      printallocerr("index");
+      fclose(file);
+      return NULL;
+    }
+    fseek(file,pos,SEEK_SET);
+    if(freadlong(*index,config->ngridcell,*swap,file)!=config->ngridcell)
+    {
+      fprintf(stderr,"ERROR156: Cannot read index in %s file '%s'.\n",type,filename);
+      free(*index);
+      fclose(file);
+      return NULL;
+    }
+    if(offset+config->ngridcell<header.ncell)
+      freadlong1(*index+config->ngridcell,*swap,file);
+    else
+      (*index)[config->ngridcell]=getfilesize(filename);
+    fseek(file,offsetl,SEEK_SET);
+  }
   return file;
+} /* of 'openrestart2' */
+
+FILE *openrestart(const char *filename, /**< filename of restart file */
+                  Config *config,       /**< LPJ configuration */
+                  int ntotpft,          /**< Total number of PFTs */
+                  Bool *swap            /**< Byte order has to be changed */
+                 )                      /** \return file pointer or NULL */
+{
+  return openrestart2(filename,config,ntotpft,swap,NULL);
 } /* of 'openrestart' */
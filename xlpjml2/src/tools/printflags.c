@@ -40,4 +40,9 @@ void printflags(const char *progname /**< program name */
 #endif
   printf(", %d bit\n",(int)sizeof(void *)*8);
   printf("Compile flags:    %s\n",xstr(CFLAGS));
+#ifdef USE_MIXED_PRECISION
+  printf("Precision:        mixed, climate, output and routing data stored as float\n");
+#else
+  printf("Precision:        double\n");
+#endif
 } /* of 'printflags' */
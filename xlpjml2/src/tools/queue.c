@@ -20,7 +20,7 @@
 
 struct queue
 {
-  Real *data; /**< data array */
+  Storereal *data; /**< data array */
   int size;   /**< size of queue */
   int first;  /**< index of first element in queue */
 }; /* definition of opaque datatype Queue */
@@ -37,7 +37,7 @@ Queue newqueue(int size /**< size of queue */
   queue=new(struct queue);
   if(queue==NULL)
     return NULL;
-  queue->data=newvec(Real,size);
+  queue->data=newvec(Storereal,size);
   if(queue->data==NULL)
   {
     free(queue);
@@ -55,9 +55,24 @@ Bool fwritequeue(FILE *file, /**< pointer to binary file */
                  const Queue queue /**< pointer to queue written */
                 )                  /** \return TRUE on error */
 {
+#ifdef USE_MIXED_PRECISION
+  int i;
+  Real data;
+#endif
   fwrite(&queue->size,sizeof(int),1,file);
   fwrite(&queue->first,sizeof(int),1,file);
+#ifdef USE_MIXED_PRECISION
+  /* restart files always contain double values */
+  for(i=0;i<queue->size;i++)
+  {
+    data=queue->data[i];
+    if(fwrite(&data,sizeof(Real),1,file)!=1)
+      return TRUE;
+  }
+  return FALSE;
+#else
   return fwrite(queue->data,sizeof(Real),queue->size,file)!=queue->size;
+#endif
 } /* of 'fwritequeue' */
 
 void fprintqueue(FILE *file,       /**< pointer to text file */
@@ -74,6 +89,10 @@ Queue freadqueue(FILE *file, /**< pointer to binary file */
                 )            /** \return pointer to queue read or NULL */
 {
   Queue queue;
+#ifdef USE_MIXED_PRECISION
+  int i;
+  Real data;
+#endif
   queue=new(struct queue);
   if(queue==NULL)
     return NULL;
@@ -92,18 +111,31 @@ Queue freadqueue(FILE *file, /**< pointer to binary file */
     free(queue);
     return NULL;
   }
-  queue->data=newvec(Real,queue->size);
+  queue->data=newvec(Storereal,queue->size);
   if(queue->data==NULL)
   {
     free(queue);
     return NULL;
   }
+#ifdef USE_MIXED_PRECISION
+  for(i=0;i<queue->size;i++)
+  {
+    if(freadreal1(&data,swap,file)!=1)
+    {
+      free(queue->data);
+      free(queue);
+      return NULL;
+    }
+    queue->data[i]=(Storereal)data;
+  }
+#else
   if(freadreal(queue->data,queue->size,swap,file)!=queue->size)
   {
     free(queue->data);
     free(queue);
     return NULL;
   }
+#endif
   return queue; 
 } /* of 'freadqueue' */
  
@@ -0,0 +1,172 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                       r  e  a  d  c  h  u  n  k  s  .  c                       \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads one year block of LPJ files in chunked format               \n**/
+/**     (version 4) for a range of cells. Only chunks overlapping the              \n**/
+/**     cell range are read and decompressed. Data are returned in native          \n**/
+/**     byte order ordered by year, cell and band.                                 \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+static void swapelements(char *data, /**< data to be swapped */
+                         size_t n,   /**< number of elements */
+                         int len     /**< size of element in bytes */
+                        )
+{
+  size_t i;
+  int k;
+  char c;
+  for(i=0;i<n;i++)
+    for(k=0;k<len/2;k++)
+    {
+      c=data[i*len+k];
+      data[i*len+k]=data[i*len+len-1-k];
+      data[i*len+len-1-k]=c;
+    }
+} /* of 'swapelements' */
+
+static void deltadecode(void *data,        /**< data of chunk */
+                        size_t nrec,       /**< number of records */
+                        int nbands,        /**< number of bands per record */
+                        Type type          /**< datatype of data */
+                       )
+{
+  size_t i;
+  int b;
+  switch(type)
+  {
+    case LPJ_BYTE:
+      for(i=0;i<nrec;i++)
+        for(b=1;b<nbands;b++)
+          ((Byte *)data)[i*nbands+b]+=((Byte *)data)[i*nbands+b-1];
+      break;
+    case LPJ_SHORT:
+      for(i=0;i<nrec;i++)
+        for(b=1;b<nbands;b++)
+          ((unsigned short *)data)[i*nbands+b]+=((unsigned short *)data)[i*nbands+b-1];
+      break;
+    case LPJ_INT:
+      for(i=0;i<nrec;i++)
+        for(b=1;b<nbands;b++)
+          ((unsigned int *)data)[i*nbands+b]+=((unsigned int *)data)[i*nbands+b-1];
+      break;
+    default:
+      break;
+  }
+} /* of 'deltadecode' */
+
+Bool readchunks(FILE *file,               /**< pointer to binary file */
+                const Chunkheader *chunk, /**< chunk header */
+                Bool swap,                /**< byte order has to be swapped */
+                void *data,               /**< data read */
+                int yearblock,            /**< index of year block */
+                int firstcell,            /**< index of first cell relative to header */
+                int ncell                 /**< number of cells */
+               )                          /** \return TRUE on error */
+{
+  char *zbuffer,*buffer,*decoded;
+  size_t i,n,size,maxsize;
+  long long csize;
+  int b,c,k,y,cell,len,nyear,nchunk,first,last;
+#ifdef USE_ZLIB
+  uLongf usize;
+#endif
+  if(ncell<1)
+    return FALSE;
+  len=typesizes[chunk->header.datatype];
+  nyear=min(chunk->nyear,chunk->header.nyear-yearblock*chunk->nyear);
+  maxsize=(size_t)chunk->nyear*chunk->ncell*chunk->header.nbands*len;
+  /* find maximum size of compressed chunks */
+  csize=0;
+  for(c=firstcell/chunk->ncell;c<=(firstcell+ncell-1)/chunk->ncell;c++)
+    csize=max(csize,chunk->index[yearblock*chunk->nchunk_cell+c+1]-chunk->index[yearblock*chunk->nchunk_cell+c]);
+  zbuffer=malloc((size_t)csize);
+  buffer=malloc(maxsize);
+  decoded=malloc(maxsize);
+  if(zbuffer==NULL || buffer==NULL || decoded==NULL)
+  {
+    printallocerr("buffer");
+    free(zbuffer);
+    free(buffer);
+    free(decoded);
+    return TRUE;
+  }
+  for(c=firstcell/chunk->ncell;c<=(firstcell+ncell-1)/chunk->ncell;c++)
+  {
+    k=yearblock*chunk->nchunk_cell+c;
+    csize=chunk->index[k+1]-chunk->index[k];
+    nchunk=min(chunk->ncell,chunk->header.ncell-c*chunk->ncell);
+    n=(size_t)nyear*nchunk*chunk->header.nbands;
+    size=n*len;
+    if(fseek(file,chunk->index[k],SEEK_SET) || fread(zbuffer,1,csize,file)!=(size_t)csize)
+    {
+      fprintf(stderr,"ERROR266: Cannot read chunk %d of year %d in '%s'.\n",
+              c,chunk->header.firstyear+yearblock*chunk->nyear,chunk->filename);
+      break;
+    }
+    if(chunk->compress==CHUNK_DEFLATE)
+    {
+#ifdef USE_ZLIB
+      usize=size;
+      if(uncompress((Bytef *)buffer,&usize,(Bytef *)zbuffer,csize)!=Z_OK || usize!=size)
+      {
+        fprintf(stderr,"ERROR265: Cannot decompress chunk %d of year %d in '%s'.\n",
+                c,chunk->header.firstyear+yearblock*chunk->nyear,chunk->filename);
+        break;
+      }
+#else
+      fputs("ERROR264: Decompression of chunks not supported, compile with -DUSE_ZLIB.\n",stderr);
+      break;
+#endif
+    }
+    else if((size_t)csize!=size)
+    {
+      fprintf(stderr,"ERROR265: Invalid size %lld of chunk %d of year %d in '%s', must be %lld.\n",
+              csize,c,chunk->header.firstyear+yearblock*chunk->nyear,chunk->filename,(long long)size);
+      break;
+    }
+    else
+      memcpy(buffer,zbuffer,size);
+    if(chunk->filter==CHUNK_SHUFFLE)
+    {
+      for(i=0;i<n;i++)
+        for(b=0;b<len;b++)
+          decoded[i*len+b]=buffer[b*n+i];
+      if(swap)
+        swapelements(decoded,n,len);
+      deltadecode(decoded,n/chunk->header.nbands,chunk->header.nbands,chunk->header.datatype);
+    }
+    else
+    {
+      memcpy(decoded,buffer,size);
+      if(swap)
+        swapelements(decoded,n,len);
+    }
+    /* copy cells of chunk inside requested range */
+    first=max(firstcell,c*chunk->ncell);
+    last=min(firstcell+ncell,c*chunk->ncell+nchunk);
+    for(y=0;y<nyear;y++)
+      for(cell=first;cell<last;cell++)
+        memcpy((char *)data+(((size_t)y*ncell+cell-firstcell)*chunk->header.nbands)*len,
+               decoded+(((size_t)y*nchunk+cell-c*chunk->ncell)*chunk->header.nbands)*len,
+               (size_t)chunk->header.nbands*len);
+  }
+  free(zbuffer);
+  free(buffer);
+  free(decoded);
+  return c<=(firstcell+ncell-1)/chunk->ncell;
+} /* of 'readchunks' */
@@ -79,8 +79,14 @@
 /**                                                                                \n**/
 /**     Equation (22) can be expressed in the form f(lminc_ind)=0.                 \n**/
 /**                                                                                \n**/
-/**     Numerical methods are used to solve the equation for the                   \n**/
-/**     unknown lminc_ind.                                                         \n**/
+/**     f(lminc_ind) is concave. The leftmost zero is found by Newton              \n**/
+/**     iterations with the analytic derivative started at the end of              \n**/
+/**     the interval next to it. Iterations approach the zero                      \n**/
+/**     monotonically. If they leave the interval, the segment scan                \n**/
+/**     and bisection of leftmostzero() are used instead. Results differ           \n**/
+/**     per cell from the bisection, which stops up to XACC away from              \n**/
+/**     the zero or misses it. Compile with -DCHECK_ALLOCATION to print            \n**/
+/**     the differing solutions.                                                   \n**/
 /**     -----------------------------------------------------------------          \n**/
 /**     Work out minimum leaf production to maintain current sapmass               \n**/
 /**                                                                                \n**/
@@ -110,19 +116,107 @@
 #define CDEBT_MAXLOAN_DEFICIT 0.8 /* maximum loan as a fraction of deficit*/
 #define CDEBT_MAXLOAN_MASS 0.2 /* maximum loan as a fraction of (sapwood-cdebt)*/
 #define NSEG 20 /* number of segments (parameter in numerical methods)*/
+#define XACC 0.001 /* accuracy in leaf increment */
+#define YACC 1.0e-10 /* accuracy in f */
+#define MAXITER 40 /* maximum number of iterations */
+#define NEWTON_XACC 1.0e-6 /* accuracy in leaf increment for Newton iterations */
 
 typedef struct
 {
-  Real k1,lm,k3,b,ind_leaf,ind_heart,allom3;
+  Real k1,lm,k3,b,ind_leaf,ind_heart,exponent;
 } Data;
 
 static Real f(Real leaf_inc,Data *data) 
 {
  return data->k1*(data->b-leaf_inc*data->lm+data->ind_heart)-
          pow((data->b-leaf_inc*data->lm)/(data->ind_leaf+leaf_inc)*data->k3,
-             1.0+2/data->allom3);
+             data->exponent);
 } /* of 'f' */
 
+static Real fdf(Real *df,Real leaf_inc,const Data *data)
+{
+  /* returns f and its derivative df with one call of pow() */
+  Real u,p;
+  u=(data->b-leaf_inc*data->lm)/(data->ind_leaf+leaf_inc)*data->k3;
+  p=pow(u,data->exponent-1);
+  *df=-data->k1*data->lm+data->exponent*p*data->k3*
+      (data->lm*data->ind_leaf+data->b)/
+      ((data->ind_leaf+leaf_inc)*(data->ind_leaf+leaf_inc));
+  return data->k1*(data->b-leaf_inc*data->lm+data->ind_heart)-p*u;
+} /* of 'fdf' */
+
+static Bool newton_alloc(Real *x,Real x1,Real x2,Data *data)
+{
+  /* returns TRUE if Newton iterations converged to leftmost zero in [x1,x2] */
+  Real y,dy,dx;
+  int i,dir;
+  y=fdf(&dy,x1,data);
+  if(y<0 && dy>0)
+  {
+    /* f increases through leftmost zero, start at left end */
+    *x=x1;
+    dir=1;
+  }
+  else if(y>0)
+  {
+    /* f decreases through leftmost zero, start at right end */
+    *x=x2;
+    y=fdf(&dy,*x,data);
+    dir=-1;
+  }
+  else
+    return FALSE;
+  /* zero in interval requires f<0 at start point */
+  if(y>=0)
+    return FALSE;
+  for(i=0;i<MAXITER;i++)
+  {
+    if(fabs(y)<YACC)
+      return TRUE;
+    if(dy==0)
+      return FALSE;
+    dx=-y/dy;
+    if(dx*dir<0)
+      return FALSE; /* no zero in interval */
+    *x+=dx;
+    if(*x<x1 || *x>x2)
+      return FALSE;
+    if(fabs(dx)<NEWTON_XACC)
+      return TRUE;
+    y=fdf(&dy,*x,data);
+  }
+  return FALSE;
+} /* of 'newton_alloc' */
+
+static Real leftmostzero_alloc(Real x1,Real x2,Data *data)
+{
+  Real x,swap;
+  if(x2<x1)
+  {
+    swap=x1;
+    x1=x2;
+    x2=swap;
+  }
+  if(newton_alloc(&x,x1,x2,data))
+    return x;
+  return leftmostzero((Bisectfcn)f,x1,x2,data,XACC,YACC,MAXITER);
+} /* of 'leftmostzero_alloc' */
+
+#ifdef CHECK_ALLOCATION
+void checkallocation_tree(void)
+{
+  /* f(0)>0 and f decreases through zero in [0,8], Newton iterations start at right end */
+  Data data={1,1,1,10,20,-5,2};
+  Real x,x0;
+  x0=leftmostzero((Bisectfcn)f,0,8,&data,XACC,YACC,MAXITER);
+  if(!newton_alloc(&x,0,8,&data))
+    fprintf(stderr,"WARNING030: Newton iteration failed for decreasing f, bisection %g.\n",x0);
+  else if(fabs(x-x0)>XACC)
+    fprintf(stderr,"WARNING030: Leaf increment %g for decreasing f differs from bisection %g.\n",
+            x,x0);
+} /* of 'checkallocation_tree' */
+#endif
+
 Bool allocation_tree(Litter *litter, /**< litter pool */
                      Pft *pft,       /**< pointer to PFT */
                      Real *fpc_inc   /**< fpc increment */
@@ -187,24 +281,33 @@ Bool allocation_tree(Litter *litter, /**< litter pool */
       data.b= tree->ind.sapwood+bm_inc_ind-tree->ind.leaf/lmtorm+
               tree->ind.root;
       data.lm=1+1/lmtorm;
-      data.k1=pow(treepar->allom2,2.0/treepar->allom3)*4.0*M_1_PI/wooddens;
+      data.k1=treepar->allom_k1;
       data.k3=k_latosa/wooddens/pft->par->sla;
       data.ind_leaf=tree->ind.leaf;
       data.ind_heart=tree->ind.heartwood;
-      data.allom3=treepar->allom3;
+      data.exponent=treepar->allom_exp;
       x2=(bm_inc_ind-(tree->ind.leaf/lmtorm-tree->ind.root))/data.lm;
       x1= (tree->ind.leaf<1.0e-10)  ? x2/NSEG : 0;
 
-/*  Bisection loop
- *  Search iterates on value of xmid until xmid lies within
- *  xacc of the root, i.e. until |xmid-x|<xacc where f(x)=0
+/*  Newton iteration
+ *  Search iterates on value of x until x lies within
+ *  xacc of the leftmost root, i.e. until |x-x0|<xacc where f(x0)=0
  */
  
       if((x1==0 && x2==0) || data.b-x1*data.lm<0.0 || data.ind_leaf+x1<=0.0 
          || data.b-x2*data.lm<0.0 || data.ind_leaf+x2<=0.0 )
         tinc_ind.leaf=0;
       else
-        tinc_ind.leaf=leftmostzero((Bisectfcn)f,x1,x2,&data,0.001,1.0e-10,40);
+      {
+        tinc_ind.leaf=leftmostzero_alloc(x1,x2,&data);
+#ifdef CHECK_ALLOCATION
+        /* compare solution with segment scan and bisection */
+        x1=leftmostzero((Bisectfcn)f,x1,x2,&data,XACC,YACC,MAXITER);
+        if(fabs(tinc_ind.leaf-x1)>XACC)
+          fprintf(stderr,"WARNING030: Leaf increment %g of '%s' differs from bisection %g, f=%g, %g.\n",
+                  tinc_ind.leaf,pft->par->name,x1,f(tinc_ind.leaf,&data),f(x1,&data));
+#endif
+      }
       if (tinc_ind.leaf<0.0)
         tinc_ind.root=0.0;
       else
@@ -130,6 +130,12 @@ Bool fscanpft_tree(LPJfile *file, /**< pointer to LPJ file */
   fscanreal2(verb,file,&tree->allom2,pft->name,"allom2");
   fscanreal2(verb,file,&tree->allom3,pft->name,"allom3");
   fscanreal2(verb,file,&tree->allom4,pft->name,"allom4");
+  /* invariants of allocation equation */
+  tree->allom_k1=pow(tree->allom2,2.0/tree->allom3)*4.0*M_1_PI/wooddens;
+  tree->allom_exp=1.0+2/tree->allom3;
+#ifdef CHECK_ALLOCATION
+  checkallocation_tree();
+#endif
   fscanreal2(verb,file,&tree->height_max,pft->name,"height_max");
   fscanreal2(verb,file,&tree->scorchheight_f_param,pft->name,"scorchheight_f_param");
   fscanreal2(verb,file,&tree->crownlength,pft->name,"crownlength");
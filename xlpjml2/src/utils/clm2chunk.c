@@ -0,0 +1,221 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                        c  l  m  2  c  h  u  n  k  .  c                         \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Utility converts CLM files into chunked format (version 4).                \n**/
+/**     Data are stored in chunks of year blocks and cell ranges that are          \n**/
+/**     filtered and compressed independently. Option -unpack converts             \n**/
+/**     chunked files back into CLM version 3.                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define USAGE "Usage: %s [-years n] [-cells n] [-nocompress] [-nofilter]\n"\
+              "       clmfile chunkfile\n"\
+              "       %s -unpack chunkfile clmfile\n"
+
+static Bool readvalues(FILE *file,void *data,size_t n,Type type,Bool swap)
+{
+  switch(type)
+  {
+    case LPJ_BYTE:
+      return fread(data,1,n,file)!=n;
+    case LPJ_SHORT:
+      return freadshort(data,n,swap,file)!=n;
+    case LPJ_INT:
+      return freadint(data,n,swap,file)!=n;
+    case LPJ_FLOAT:
+      return freadfloat(data,n,swap,file)!=n;
+    default:
+      return freaddouble(data,n,swap,file)!=n;
+  }
+} /* of 'readvalues' */
+
+static int pack(FILE *in,FILE *out,const Header *header,const char *headername,
+                long long offset,Bool swap,Chunkheader *chunk)
+{
+  char *data;
+  long long size;
+  int i,c,y,nyear,ncell,len;
+  len=typesizes[header->datatype];
+  chunk->header=*header;
+  chunk->nchunk_year=(header->nyear+chunk->nyear-1)/chunk->nyear;
+  chunk->nchunk_cell=(header->ncell+chunk->ncell-1)/chunk->ncell;
+  chunk->index=newvec(long long,chunk->nchunk_year*chunk->nchunk_cell+1);
+  check(chunk->index);
+  data=malloc((size_t)chunk->nyear*chunk->ncell*header->nbands*len);
+  check(data);
+  for(i=0;i<=chunk->nchunk_year*chunk->nchunk_cell;i++)
+    chunk->index[i]=0;
+  /* header and index are written twice, index is known after compression */
+  if(fwriteheader(out,header,headername,LPJ_CHUNK_VERSION) ||
+     fwritechunkheader(out,chunk))
+  {
+    fputs("ERROR204: Cannot write header.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  chunk->index[0]=ftell(out);
+  for(i=0;i<chunk->nchunk_year;i++)
+  {
+    nyear=min(chunk->nyear,header->nyear-i*chunk->nyear);
+    for(c=0;c<chunk->nchunk_cell;c++)
+    {
+      ncell=min(chunk->ncell,header->ncell-c*chunk->ncell);
+      for(y=0;y<nyear;y++)
+        if(fseek(in,offset+(((long long)(i*chunk->nyear+y)*header->ncell+c*chunk->ncell)*header->nbands)*len,SEEK_SET) ||
+           readvalues(in,data+(size_t)y*ncell*header->nbands*len,(size_t)ncell*header->nbands,header->datatype,swap))
+        {
+          fprintf(stderr,"ERROR302: Cannot read data of year %d.\n",
+                  header->firstyear+i*chunk->nyear+y);
+          return EXIT_FAILURE;
+        }
+      size=fwritechunk(out,chunk,data,nyear,ncell);
+      if(size<0)
+      {
+        fputs("ERROR204: Cannot write chunk.\n",stderr);
+        return EXIT_FAILURE;
+      }
+      chunk->index[i*chunk->nchunk_cell+c+1]=chunk->index[i*chunk->nchunk_cell+c]+size;
+    }
+  }
+  free(data);
+  rewind(out);
+  if(fwriteheader(out,header,headername,LPJ_CHUNK_VERSION) ||
+     fwritechunkheader(out,chunk))
+  {
+    fputs("ERROR204: Cannot write header.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  size=(long long)header->nyear*header->ncell*header->nbands*len;
+  printf("%lld bytes compressed to %lld bytes, ratio %.2f\n",size,
+         chunk->index[chunk->nchunk_year*chunk->nchunk_cell],
+         (double)size/chunk->index[chunk->nchunk_year*chunk->nchunk_cell]);
+  return EXIT_SUCCESS;
+} /* of 'pack' */
+
+static int unpack(FILE *in,const char *filename,FILE *out,const Header *header,
+                  const char *headername,Bool swap)
+{
+  Chunkheader *chunk;
+  char *data;
+  size_t size;
+  int i,nyear;
+  chunk=freadchunkheader(in,filename,header,swap);
+  if(chunk==NULL)
+  {
+    fputs("ERROR154: Invalid chunk header.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  data=malloc((size_t)chunk->nyear*header->ncell*header->nbands*typesizes[header->datatype]);
+  check(data);
+  if(fwriteheader(out,header,headername,LPJ_CLIMATE_VERSION))
+  {
+    fputs("ERROR204: Cannot write header.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  for(i=0;i<chunk->nchunk_year;i++)
+  {
+    nyear=min(chunk->nyear,header->nyear-i*chunk->nyear);
+    size=(size_t)nyear*header->ncell*header->nbands*typesizes[header->datatype];
+    if(readchunks(in,chunk,swap,data,i,0,header->ncell))
+    {
+      fprintf(stderr,"ERROR302: Cannot read chunks of year %d.\n",
+              header->firstyear+i*chunk->nyear);
+      return EXIT_FAILURE;
+    }
+    if(fwrite(data,1,size,out)!=size)
+    {
+      fputs("ERROR204: Cannot write data.\n",stderr);
+      return EXIT_FAILURE;
+    }
+  }
+  free(data);
+  freechunkheader(chunk);
+  return EXIT_SUCCESS;
+} /* of 'unpack' */
+
+int main(int argc,char **argv)
+{
+  FILE *in,*out;
+  Header header;
+  String headername;
+  Chunkheader chunk;
+  Bool swap,isunpack;
+  int iarg,version,rc;
+  chunk.nyear=10;
+  chunk.ncell=1000;
+  chunk.compress=CHUNK_DEFLATE;
+  chunk.filter=CHUNK_SHUFFLE;
+  isunpack=FALSE;
+  for(iarg=1;iarg<argc;iarg++)
+    if(argv[iarg][0]=='-')
+    {
+      if(!strcmp(argv[iarg],"-years") && iarg<argc-1)
+        chunk.nyear=atoi(argv[++iarg]);
+      else if(!strcmp(argv[iarg],"-cells") && iarg<argc-1)
+        chunk.ncell=atoi(argv[++iarg]);
+      else if(!strcmp(argv[iarg],"-nocompress"))
+        chunk.compress=CHUNK_NOCOMPRESS;
+      else if(!strcmp(argv[iarg],"-nofilter"))
+        chunk.filter=CHUNK_NOFILTER;
+      else if(!strcmp(argv[iarg],"-unpack"))
+        isunpack=TRUE;
+      else
+      {
+        fprintf(stderr,"Invalid option '%s'.\n",argv[iarg]);
+        fprintf(stderr,USAGE,argv[0],argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      break;
+  if(argc<iarg+2 || chunk.nyear<1 || chunk.ncell<1)
+  {
+    fprintf(stderr,USAGE,argv[0],argv[0]);
+    return EXIT_FAILURE;
+  }
+  in=fopen(argv[iarg],"rb");
+  if(in==NULL)
+  {
+    printfopenerr(argv[iarg]);
+    return EXIT_FAILURE;
+  }
+  version=READ_VERSION;
+  if(freadanyheader(in,&header,&swap,headername,&version))
+  {
+    fprintf(stderr,"ERROR154: Invalid header in '%s'.\n",argv[iarg]);
+    return EXIT_FAILURE;
+  }
+  if(isunpack!=(version==LPJ_CHUNK_VERSION))
+  {
+    fprintf(stderr,"ERROR154: Invalid version %d in '%s'.\n",version,argv[iarg]);
+    return EXIT_FAILURE;
+  }
+  if(header.order!=CELLYEAR)
+  {
+    fprintf(stderr,"ERROR127: Order of '%s' must be CELLYEAR.\n",argv[iarg]);
+    return EXIT_FAILURE;
+  }
+  out=fopen(argv[iarg+1],"wb");
+  if(out==NULL)
+  {
+    printfopenerr(argv[iarg+1]);
+    return EXIT_FAILURE;
+  }
+  if(isunpack)
+    rc=unpack(in,argv[iarg],out,&header,headername,swap);
+  else
+    rc=pack(in,out,&header,headername,headersize(headername,version),swap,&chunk);
+  fclose(in);
+  fclose(out);
+  return rc;
+} /* of 'main' */
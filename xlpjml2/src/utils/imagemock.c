@@ -0,0 +1,180 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                     i  m  a  g  e  m  o  c  k  .  c                            \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Mock of the IMAGE model for testing the IMAGE coupler of LPJmL             \n**/
+/**     without the real model. Recorded data are replayed year by year,           \n**/
+/**     data sent back by LPJmL are read and optionally written to file.           \n**/
+/**                                                                                \n**/
+/**     Replay file contains for each coupled year the message sent by IMAGE       \n**/
+/**     in native byte order: CO2 concentration (double) followed by nin           \n**/
+/**     4 byte items for each of the ncell cells. nin is 4*12 for monthly          \n**/
+/**     climate, 23 items are added with land use. LPJmL sends nout items          \n**/
+/**     per cell, nout is 14 or 21 if compiled with -DSENDSEP.                     \n**/
+/**                                                                                \n**/
+/**     Start before lpjml with simulation type LPJML_IMAGE                        \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+#ifndef IMAGE
+#include "image.h" /* default ports of IMAGE coupler */
+#endif
+#ifndef _WIN32
+#include <unistd.h>
+#include <signal.h>
+#endif
+
+#define USAGE "Usage: %s [-host name] [-inport n] [-outport n] [-wait time]\n"\
+              "       [-delay msec] [-ahead] [-o filename] ncell nin nout replayfile\n"
+
+static Bool sendyear(Socket *socket,FILE *replay,float *data,int size,int delay)
+{
+  double co2;
+  if(fread(&co2,sizeof(co2),1,replay)!=1 ||
+     fread(data,sizeof(float),size,replay)!=size)
+    return FALSE; /* no more data in replay file */
+  /* simulate computation time of IMAGE */
+#ifdef _WIN32
+  Sleep(delay);
+#else
+  usleep(delay*1000);
+#endif
+  return !writedouble_socket(socket,&co2,1) &&
+         !writefloat_socket(socket,data,size);
+} /* of 'sendyear' */
+
+int main(int argc,char **argv)
+{
+  Socket *in,*out;
+  FILE *replay,*record;
+  const char *host,*filename;
+  float *data,*result;
+  int i,inport,outport,wait,delay,ncell,nin,nout,nsent,nrecv;
+  Bool ahead;
+  double tstart,twait;
+  host=DEFAULT_IMAGE_HOST;
+  inport=DEFAULT_IMAGE_INPORT;
+  outport=DEFAULT_IMAGE_OUTPORT;
+  wait=WAIT_IMAGE;
+  delay=0;
+  ahead=FALSE;
+  filename=NULL;
+  for(i=1;i<argc;i++)
+    if(argv[i][0]=='-')
+    {
+      if(!strcmp(argv[i],"-host") && i<argc-1)
+        host=argv[++i];
+      else if(!strcmp(argv[i],"-inport") && i<argc-1)
+        inport=atoi(argv[++i]);
+      else if(!strcmp(argv[i],"-outport") && i<argc-1)
+        outport=atoi(argv[++i]);
+      else if(!strcmp(argv[i],"-wait") && i<argc-1)
+        wait=atoi(argv[++i]);
+      else if(!strcmp(argv[i],"-delay") && i<argc-1)
+        delay=atoi(argv[++i]);
+      else if(!strcmp(argv[i],"-ahead"))
+        ahead=TRUE;
+      else if(!strcmp(argv[i],"-o") && i<argc-1)
+        filename=argv[++i];
+      else
+      {
+        fprintf(stderr,USAGE,argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      break;
+  if(argc-i<4)
+  {
+    fprintf(stderr,USAGE,argv[0]);
+    return EXIT_FAILURE;
+  }
+  ncell=atoi(argv[i]);
+  nin=atoi(argv[i+1]);
+  nout=atoi(argv[i+2]);
+  if(ncell<1 || nin<1 || nout<1)
+  {
+    fputs("ERROR301: Number of cells and items must be greater than zero.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  replay=fopen(argv[i+3],"rb");
+  if(replay==NULL)
+  {
+    printfopenerr(argv[i+3]);
+    return EXIT_FAILURE;
+  }
+  if(filename!=NULL)
+  {
+    record=fopen(filename,"wb");
+    if(record==NULL)
+    {
+      printfcreateerr(filename);
+      return EXIT_FAILURE;
+    }
+  }
+  else
+    record=NULL;
+  data=newvec(float,nin*ncell);
+  check(data);
+  result=newvec(float,nout*ncell);
+  check(result);
+#ifndef _WIN32
+  /* LPJmL may close connection with data of further years unread */
+  signal(SIGPIPE,SIG_IGN);
+#endif
+  /* LPJmL opens ingoing port first and connects to outgoing port */
+  in=connecttdt_socket(host,inport);
+  if(in==NULL)
+    return EXIT_FAILURE;
+  out=opentdt_socket(outport,wait);
+  if(out==NULL)
+    return EXIT_FAILURE;
+  if(out->swap)
+  {
+    fputs("ERROR301: Different byte order of LPJmL not supported.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  printf("Connected to LPJmL, replaying '%s'.\n",argv[i+3]);
+  nsent=nrecv=0;
+  twait=0;
+  if(sendyear(in,replay,data,nin*ncell,delay))
+    nsent++;
+  while(nrecv<nsent)
+  {
+    /* with -ahead data of next year are sent before results are received */
+    if(ahead && sendyear(in,replay,data,nin*ncell,delay))
+      nsent++;
+    tstart=mrun();
+    if(readfloat_socket(out,result,nout*ncell))
+    {
+      fprintf(stderr,"ERROR301: Cannot receive results of year %d from LPJmL.\n",
+              nrecv+1);
+      break;
+    }
+    twait+=mrun()-tstart;
+    nrecv++;
+    if(record!=NULL)
+      fwrite(result,sizeof(float),nout*ncell,record);
+    if(!ahead && sendyear(in,replay,data,nin*ncell,delay))
+      nsent++;
+  }
+  printf("%d years sent, %d years received, %.2f sec waited for LPJmL.\n",
+         nsent,nrecv,twait);
+  if(record!=NULL)
+    fclose(record);
+  fclose(replay);
+  free(data);
+  free(result);
+  close_socket(in);
+  close_socket(out);
+  return (nrecv<nsent) ? EXIT_FAILURE : EXIT_SUCCESS;
+} /* of 'main' */
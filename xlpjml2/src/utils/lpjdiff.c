@@ -0,0 +1,450 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                           l  p  j  d  i  f  f  .  c                            \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Utility compares two output files, sets of output files or restart         \n**/
+/**     files and reports the number of differing values, the maximum              \n**/
+/**     absolute and the maximum relative difference. Used to verify               \n**/
+/**     runs of the mixed-precision build against the double build                 \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define USAGE "Usage: %s [-type {byte|short|int|float|double}] [-eps eps]\n"\
+              "       file1 file2\n"\
+              "       %s [-type {byte|short|int|float|double}] [-eps eps]\n"\
+              "       path1 path2 name ...\n"
+
+typedef struct
+{
+  long long n;      /**< number of values compared */
+  long long ndiff;  /**< number of values exceeding tolerance */
+  long long imax;   /**< index of maximum absolute difference */
+  double max;       /**< maximum absolute difference */
+  double maxrel;    /**< maximum relative difference */
+  double sum2;      /**< sum of squared differences */
+} Diffstat;
+
+static char *readfile(const char *filename,long long *size)
+{
+  FILE *file;
+  char *data;
+  *size=getfilesize(filename);
+  if(*size<0)
+  {
+    printfopenerr(filename);
+    return NULL;
+  }
+  file=fopen(filename,"rb");
+  if(file==NULL)
+  {
+    printfopenerr(filename);
+    return NULL;
+  }
+  data=malloc(max(*size,1));
+  if(data==NULL)
+  {
+    printallocerr("data");
+    fclose(file);
+    return NULL;
+  }
+  if(fread(data,1,*size,file)!=(size_t)*size)
+  {
+    fprintf(stderr,"ERROR302: Cannot read '%s'.\n",filename);
+    free(data);
+    data=NULL;
+  }
+  fclose(file);
+  return data;
+} /* of 'readfile' */
+
+static double getvalue(const char *data,Type type,Bool swap,long long i)
+{
+  switch(type)
+  {
+    case LPJ_BYTE:
+      return ((const Byte *)data)[i];
+    case LPJ_SHORT:
+      return (swap) ? swapshort(((const short *)data)[i]) : ((const short *)data)[i];
+    case LPJ_INT:
+      return (swap) ? swapint(((const int *)data)[i]) : ((const int *)data)[i];
+    case LPJ_FLOAT:
+      return (swap) ? swapfloat(((const int *)data)[i]) : ((const float *)data)[i];
+    default:
+      return (swap) ? swapdouble(((const Num *)data)[i]) : ((const double *)data)[i];
+  }
+} /* of 'getvalue' */
+
+static long long getheader(const char *filename,Header *header,Bool *swap,
+                           String headername)
+{
+  FILE *file;
+  int version;
+  long long offset;
+  file=fopen(filename,"rb");
+  if(file==NULL)
+    return 0;
+  version=READ_VERSION;
+  /* files without header are compared from the beginning */
+  if(freadanyheader(file,header,swap,headername,&version))
+    offset=0;
+  else
+    offset=headersize(headername,version);
+  fclose(file);
+  return offset;
+} /* of 'getheader' */
+
+static void diffvalues(Diffstat *stat,double a,double b,double eps)
+{
+  double diff,rel;
+  if(isnan(a) || isnan(b))
+  {
+    /* missing values have to be missing in both files */
+    if(!isnan(a) || !isnan(b))
+      stat->ndiff++;
+    stat->n++;
+    return;
+  }
+  diff=fabs(a-b);
+  rel=(diff>0) ? diff/max(fabs(a),fabs(b)) : 0;
+  if(diff>stat->max || stat->n==0)
+  {
+    stat->max=diff;
+    stat->imax=stat->n;
+  }
+  if(rel>stat->maxrel)
+    stat->maxrel=rel;
+  if(rel>eps)
+    stat->ndiff++;
+  stat->sum2+=diff*diff;
+  stat->n++;
+} /* of 'diffvalues' */
+
+static const char *restartvars[]={"discharge","queue","reservoir",
+                                  "estab_storage","waterdeficit"};
+
+#define NRESTARTVAR (sizeof(restartvars)/sizeof(char *))
+#define NRESDATA (5+NIRRIGDAYS+NMONTH+3*NMONTH*HIST_YEARS)
+
+typedef struct
+{
+  const char *data; /**< restart file data */
+  long long pos;    /**< actual position in data */
+  long long end;    /**< end of cell record */
+  Bool swap;        /**< byte order has to be changed */
+} Record;
+
+static Bool getbyte(Record *record,int *value)
+{
+  if(record->pos+1>record->end)
+    return TRUE;
+  *value=((const Byte *)record->data)[record->pos++];
+  return FALSE;
+} /* of 'getbyte' */
+
+static Bool getint(Record *record,int *value)
+{
+  if(record->pos+(long long)sizeof(int)>record->end)
+    return TRUE;
+  memcpy(value,record->data+record->pos,sizeof(int));
+  if(record->swap)
+    *value=swapint(*value);
+  record->pos+=sizeof(int);
+  return FALSE;
+} /* of 'getint' */
+
+static double getdouble(const char *data,Bool swap)
+{
+  Num num;
+  double value;
+  memcpy(&num,data,sizeof(Num));
+  if(swap)
+    return swapdouble(num);
+  memcpy(&value,&num,sizeof(Num));
+  return value;
+} /* of 'getdouble' */
+
+static Bool diffreals(Diffstat *stat,Record *r1,Record *r2,int n,double eps)
+{
+  /* restart files always contain double values */
+  if(r1->pos+n*(long long)sizeof(Num)>r1->end ||
+     r2->pos+n*(long long)sizeof(Num)>r2->end)
+    return TRUE;
+  for(;n>0;n--)
+  {
+    diffvalues(stat,getdouble(r1->data+r1->pos,r1->swap),
+               getdouble(r2->data+r2->pos,r2->swap),eps);
+    r1->pos+=sizeof(Num);
+    r2->pos+=sizeof(Num);
+  }
+  return FALSE;
+} /* of 'diffreals' */
+
+static Bool diffqueue(Diffstat *stat,Record *r1,Record *r2,double eps)
+{
+  int size1,size2,first1,first2,i;
+  if(getint(r1,&size1) || getint(r2,&size2) || size1!=size2 || size1<1 ||
+     getint(r1,&first1) || getint(r2,&first2) ||
+     first1<0 || first1>=size1 || first2<0 || first2>=size2 ||
+     r1->pos+size1*(long long)sizeof(Num)>r1->end ||
+     r2->pos+size2*(long long)sizeof(Num)>r2->end)
+    return TRUE;
+  /* queues are compared from first element on */
+  for(i=0;i<size1;i++)
+  {
+    diffvalues(stat,getdouble(r1->data+r1->pos+((first1+i) % size1)*sizeof(Num),r1->swap),
+               getdouble(r2->data+r2->pos+((first2+i) % size2)*sizeof(Num),r2->swap),eps);
+  }
+  r1->pos+=size1*sizeof(Num);
+  r2->pos+=size2*sizeof(Num);
+  return FALSE;
+} /* of 'diffqueue' */
+
+static Bool diffcell(Diffstat stat[],Record *r1,Record *r2,
+                     const Restartheader *restart,double eps)
+{
+  int skip1,skip2,dam1,dam2;
+  if(getbyte(r1,&skip1) || getbyte(r2,&skip2) || skip1!=skip2)
+    return TRUE;
+  if(restart->river_routing)
+  {
+#ifdef COUPLING_WITH_FMS
+    if(diffreals(stat,r1,r2,5,eps))
+#else
+    if(diffreals(stat,r1,r2,4,eps))
+#endif
+      return TRUE;
+    if(diffqueue(stat+1,r1,r2,eps))
+      return TRUE;
+    if(getbyte(r1,&dam1) || getbyte(r2,&dam2) || dam1!=dam2)
+      return TRUE;
+    if(dam1 && diffreals(stat+2,r1,r2,NRESDATA,eps))
+      return TRUE;
+  }
+  if(!skip1)
+  {
+    if(diffreals(stat+3,r1,r2,4,eps))
+      return TRUE;
+    if(diffreals(stat+4,r1,r2,1,eps))
+      return TRUE;
+  }
+  return FALSE;
+} /* of 'diffcell' */
+
+static long long getndiff(const Diffstat stat[])
+{
+  size_t i;
+  long long ndiff=0;
+  for(i=0;i<NRESTARTVAR;i++)
+    ndiff+=stat[i].ndiff;
+  return ndiff;
+} /* of 'getndiff' */
+
+static Bool getindex(long long index[],const char *data,long long size,
+                     long long first,int ncell,Bool swap)
+{
+  int i;
+  memcpy(index,data+first,sizeof(long long)*ncell);
+  for(i=0;i<ncell;i++)
+  {
+    if(swap)
+      index[i]=swaplong(index[i]);
+    /* offsets must lie within data and increase monotonically */
+    if(index[i]<first+ncell*(long long)sizeof(long long) || index[i]>size ||
+       (i>0 && index[i]<index[i-1]))
+      return TRUE;
+  }
+  return FALSE;
+} /* of 'getindex' */
+
+static int diffrestart(const char *name,const char *data1,long long size1,
+                       const char *data2,long long size2,long long offset,
+                       const Header *header,Bool swap,double eps)
+{
+  long long i,ndiff,nlayout,nstand,first,*index1,*index2;
+  size_t j;
+  Restartheader restart;
+  Diffstat stat[NRESTARTVAR];
+  Record r1,r2;
+  if(header->ncell<0 || offset+(long long)sizeof(Restartheader)+header->ncell*(long long)sizeof(long long)>min(size1,size2) ||
+     memcmp(data1+offset,data2+offset,sizeof(Restartheader)))
+  {
+    printf("%s: different restart settings\n",name);
+    return 1;
+  }
+  memcpy(&restart,data1+offset,sizeof(Restartheader));
+  if(swap)
+    restart.river_routing=swapint(restart.river_routing);
+  offset+=sizeof(Restartheader);
+  index1=newvec(long long,max(header->ncell,1));
+  index2=newvec(long long,max(header->ncell,1));
+  if(index1==NULL || index2==NULL)
+  {
+    printallocerr("index");
+    free(index1);
+    free(index2);
+    return 2;
+  }
+  if(getindex(index1,data1,size1,offset,header->ncell,swap) ||
+     getindex(index2,data2,size2,offset,header->ncell,swap))
+  {
+    fprintf(stderr,"ERROR302: Invalid cell index in restart file '%s'.\n",name);
+    free(index1);
+    free(index2);
+    return 2;
+  }
+  for(j=0;j<NRESTARTVAR;j++)
+  {
+    stat[j].n=stat[j].ndiff=stat[j].imax=0;
+    stat[j].max=stat[j].maxrel=stat[j].sum2=0;
+  }
+  ndiff=nlayout=nstand=0;
+  first=-1;
+  r1.data=data1;
+  r2.data=data2;
+  r1.swap=r2.swap=swap;
+  /* compare restart data cell by cell, decoding the cell variables that
+     do not depend on the PFT parameters */
+  for(i=0;i<header->ncell;i++)
+  {
+    r1.pos=index1[i];
+    r2.pos=index2[i];
+    r1.end=(i<header->ncell-1) ? index1[i+1] : size1;
+    r2.end=(i<header->ncell-1) ? index2[i+1] : size2;
+    ndiff=getndiff(stat);
+    if(diffcell(stat,&r1,&r2,&restart,eps) || r1.end-r1.pos!=r2.end-r2.pos)
+      nlayout++;
+    else if(memcmp(data1+r1.pos,data2+r2.pos,r1.end-r1.pos))
+      nstand++; /* stand, PFT and climate buffer data differ */
+    else if(getndiff(stat)==ndiff)
+      continue;
+    if(first==-1)
+      first=i;
+  }
+  ndiff=nlayout+nstand+getndiff(stat);
+  if(ndiff==0)
+    printf("%s: identical\n",name);
+  else
+  {
+    printf("%s: first differing cell %lld, %lld of %d cells with different layout\n",
+           name,first+header->firstcell,nlayout,header->ncell);
+    for(j=0;j<NRESTARTVAR;j++)
+      if(stat[j].n)
+        printf("  %s: %lld of %lld values differ, max=%g, maxrel=%g, rmsd=%g\n",
+               restartvars[j],stat[j].ndiff,stat[j].n,stat[j].max,stat[j].maxrel,
+               sqrt(stat[j].sum2/stat[j].n));
+    printf("  stand and PFT data: %lld of %d cells differ\n",nstand,header->ncell);
+  }
+  free(index1);
+  free(index2);
+  return ndiff>0;
+} /* of 'diffrestart' */
+
+static int difffile(const char *name,const char *filename1,
+                    const char *filename2,Type type,double eps)
+{
+  char *data1,*data2;
+  long long i,n,size1,size2,offset;
+  Header header;
+  String headername;
+  Bool swap;
+  Diffstat stat;
+  int rc;
+  data1=readfile(filename1,&size1);
+  if(data1==NULL)
+    return 2;
+  data2=readfile(filename2,&size2);
+  if(data2==NULL)
+  {
+    free(data1);
+    return 2;
+  }
+  swap=FALSE;
+  offset=getheader(filename1,&header,&swap,headername);
+  if(offset>0 && !strcmp(headername,RESTART_HEADER))
+  {
+    rc=diffrestart(name,data1,size1,data2,size2,offset,&header,swap,eps);
+    free(data1);
+    free(data2);
+    return rc;
+  }
+  if(offset>0)
+    type=header.datatype;
+  if(size1!=size2)
+  {
+    printf("%s: different file sizes %lld and %lld\n",name,size1,size2);
+    free(data1);
+    free(data2);
+    return 1;
+  }
+  n=(size1-offset)/typesizes[type];
+  stat.n=stat.ndiff=stat.imax=0;
+  stat.max=stat.maxrel=stat.sum2=0;
+  for(i=0;i<n;i++)
+    diffvalues(&stat,getvalue(data1+offset,type,swap,i),
+               getvalue(data2+offset,type,swap,i),eps);
+  printf("%s: %lld of %lld values differ, max=%g at %lld, maxrel=%g, rmsd=%g\n",
+         name,stat.ndiff,stat.n,stat.max,stat.imax,stat.maxrel,
+         (stat.n) ? sqrt(stat.sum2/stat.n) : 0);
+  free(data1);
+  free(data2);
+  return stat.ndiff>0;
+} /* of 'difffile' */
+
+int main(int argc,char **argv)
+{
+  Type type;
+  double eps;
+  int i,n,rc,iarg;
+  String filename1,filename2;
+  type=LPJ_FLOAT;
+  eps=0;
+  for(iarg=1;iarg<argc;iarg++)
+    if(argv[iarg][0]=='-')
+    {
+      if(!strcmp(argv[iarg],"-type") && iarg<argc-1)
+      {
+        type=findstr(argv[++iarg],(const char *const *)typenames,5);
+        if(type==NOT_FOUND)
+        {
+          fprintf(stderr,"Invalid datatype '%s'.\n",argv[iarg]);
+          return EXIT_FAILURE;
+        }
+      }
+      else if(!strcmp(argv[iarg],"-eps") && iarg<argc-1)
+        eps=atof(argv[++iarg]);
+      else
+      {
+        fprintf(stderr,USAGE,argv[0],argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      break;
+  if(argc-iarg<2)
+  {
+    fprintf(stderr,USAGE,argv[0],argv[0]);
+    return EXIT_FAILURE;
+  }
+  if(argc-iarg==2)
+    return difffile(argv[iarg+1],argv[iarg],argv[iarg+1],type,eps);
+  rc=0;
+  /* compare all files of output set */
+  for(i=iarg+2;i<argc;i++)
+  {
+    snprintf(filename1,STRING_LEN,"%s/%s",argv[iarg],argv[i]);
+    snprintf(filename2,STRING_LEN,"%s/%s",argv[iarg+1],argv[i]);
+    n=difffile(argv[i],filename1,filename2,type,eps);
+    rc=max(rc,n);
+  }
+  return rc;
+} /* of 'main' */
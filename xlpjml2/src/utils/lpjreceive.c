@@ -0,0 +1,211 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                       l  p  j  r  e  c  e  i  v  e  .  c                       \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Reference receiver for framed socket output protocol version 2             \n**/
+/**     of LPJmL. Program listens on port, receives frames and appends             \n**/
+/**     data of each output variable to raw file 'outpath/var<index>.bin'.         \n**/
+/**     Global fluxes are written to 'outpath/flux.bin'.                           \n**/
+/**                                                                                \n**/
+/**     Start before lpjml -output socket=localhost:port -socketv2                 \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define USAGE "Usage: %s [-port n] [-wait time] [-outpath dir]\n"
+
+static Bool unrle(int *dst,    /* decoded words */
+                  int size,     /* maximum number of decoded words */
+                  const int *src,
+                  int len       /* number of encoded words */
+                 )              /* returns TRUE if data are not valid */
+{
+  int i,n,k;
+  i=k=0;
+  while(i<len)
+  {
+    n=src[i++];
+    if(n<0)
+    {
+      /* run of identical words */
+      if(i>=len || n<-size+k)
+        return TRUE;
+      for(;n<0;n++)
+        dst[k++]=src[i];
+      i++;
+    }
+    else
+    {
+      if(n>len-i || n>size-k)
+        return TRUE;
+      memcpy(dst+k,src+i,sizeof(int)*n);
+      k+=n;
+      i+=n;
+    }
+  }
+  return k!=size;
+} /* of 'unrle' */
+
+static FILE *openvar(FILE ***files,int *nfile,int index,const char *outpath)
+{
+  String filename;
+  int i;
+  if(index>=*nfile)
+  {
+    *files=realloc(*files,sizeof(FILE *)*(index+1));
+    check(*files);
+    for(i=*nfile;i<=index;i++)
+      (*files)[i]=NULL;
+    *nfile=index+1;
+  }
+  if((*files)[index]==NULL)
+  {
+    snprintf(filename,STRING_LEN,"%s/var%d.bin",outpath,index);
+    (*files)[index]=fopen(filename,"wb");
+    if((*files)[index]==NULL)
+      printfcreateerr(filename);
+  }
+  return (*files)[index];
+} /* of 'openvar' */
+
+int main(int argc,char **argv)
+{
+  Socket *socket;
+  Frameheader header;
+  Recordheader *record;
+  FILE **files,*flux,*file;
+  String filename;
+  char magic[3];
+  char *payload,*data,*ptr;
+  const char *outpath;
+  int i,port,wait,total,nfile,nframe,reclen;
+  long long nrecv,nbytes;
+  port=DEFAULT_PORT;
+  wait=0;
+  outpath=".";
+  for(i=1;i<argc;i++)
+    if(!strcmp(argv[i],"-port") && i<argc-1)
+      port=atoi(argv[++i]);
+    else if(!strcmp(argv[i],"-wait") && i<argc-1)
+      wait=atoi(argv[++i]);
+    else if(!strcmp(argv[i],"-outpath") && i<argc-1)
+      outpath=argv[++i];
+    else
+    {
+      fprintf(stderr,USAGE,argv[0]);
+      return EXIT_FAILURE;
+    }
+  socket=open_socket(port,wait);
+  if(socket==NULL)
+    return EXIT_FAILURE;
+  if(socket->swap)
+  {
+    fputs("ERROR301: Different byte order of sender not supported.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  if(read_socket(socket,magic,3) || strncmp(magic,SOCKET_MAGIC2,3) ||
+     readint_socket(socket,&total,1))
+  {
+    fputs("ERROR301: Invalid header, sender does not use protocol version 2.\n",stderr);
+    return EXIT_FAILURE;
+  }
+  printf("Receiving data for %d cells.\n",total);
+  snprintf(filename,STRING_LEN,"%s/flux.bin",outpath);
+  flux=fopen(filename,"wb");
+  if(flux==NULL)
+  {
+    printfcreateerr(filename);
+    return EXIT_FAILURE;
+  }
+  files=NULL;
+  nfile=nframe=0;
+  nrecv=nbytes=0;
+  payload=data=NULL;
+  for(;;)
+  {
+    if(read_socket(socket,&header,sizeof(header)) || header.magic!=FRAME_MAGIC)
+    {
+      fputs("ERROR301: Invalid frame received.\n",stderr);
+      return EXIT_FAILURE;
+    }
+    if(header.flags & FRAME_END)
+      break;
+    if(header.nrec<0 || header.size<0 || header.len<0 || header.size%sizeof(int) ||
+       header.len%sizeof(int) || header.len>header.size ||
+       (!(header.flags & FRAME_RLE) && header.len!=header.size))
+    {
+      fprintf(stderr,"ERROR301: Invalid size %d/%d of frame for year %d.\n",
+              header.size,header.len,header.year);
+      return EXIT_FAILURE;
+    }
+    payload=realloc(payload,header.len);
+    data=realloc(data,header.size);
+    if(header.len>0)
+    {
+      check(payload);
+      check(data);
+    }
+    if(read_socket(socket,payload,header.len))
+    {
+      fputs("ERROR301: Cannot read frame.\n",stderr);
+      return EXIT_FAILURE;
+    }
+    if(header.flags & FRAME_RLE)
+    {
+      if(unrle((int *)data,header.size/sizeof(int),(int *)payload,header.len/sizeof(int)))
+      {
+        fprintf(stderr,"ERROR301: Invalid compressed frame for year %d.\n",header.year);
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      memcpy(data,payload,header.len);
+    nframe++;
+    nrecv+=sizeof(header)+header.len;
+    nbytes+=sizeof(header)+header.size;
+    ptr=data;
+    for(i=0;i<header.nrec;i++)
+    {
+      record=(Recordheader *)ptr;
+      if(ptr+sizeof(Recordheader)>data+header.size || record->type<LPJ_BYTE ||
+         record->type>LPJ_DOUBLE || record->index<0 || record->index>=NOUT ||
+         record->n<0 || record->n>(header.size-(int)sizeof(Recordheader))/(int)typesizes[record->type])
+      {
+        fprintf(stderr,"ERROR301: Invalid record %d in frame for year %d.\n",
+                i,header.year);
+        return EXIT_FAILURE;
+      }
+      reclen=sizeof(Recordheader)+(record->n*typesizes[record->type]+3)/4*4;
+      if(ptr+reclen>data+header.size)
+      {
+        fprintf(stderr,"ERROR301: Record %d exceeds frame for year %d.\n",
+                i,header.year);
+        return EXIT_FAILURE;
+      }
+      file=(header.step==SOCKET_FLUX) ? flux : openvar(&files,&nfile,record->index,outpath);
+      if(file!=NULL)
+        fwrite(record+1,typesizes[record->type],record->n,file);
+      ptr+=reclen;
+    }
+  }
+  printf("%d frames received, %lld bytes, %lld bytes uncompressed.\n",
+         nframe,nrecv,nbytes);
+  for(i=0;i<nfile;i++)
+    if(files[i]!=NULL)
+      fclose(files[i]);
+  fclose(flux);
+  free(files);
+  free(payload);
+  free(data);
+  close_socket(socket);
+  return EXIT_SUCCESS;
+} /* of 'main' */